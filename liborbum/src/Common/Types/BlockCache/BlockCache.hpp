@@ -0,0 +1,67 @@
+#pragma once
+
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "Common/Types/Memory/ArrayByteMemory.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// Emulator block cache, used to avoid re-fetching and re-decoding instructions.
+/// Blocks are keyed by the physical address of their first instruction, and hold
+/// a list of pre-decoded entries (the entry type is up to the user).
+/// A block never spans more than one page of its backing memory, so it can be
+/// validated by comparing a single page write generation (see ArrayByteMemory).
+/// Only plain memory can be cached - blocks backed by registers are never created.
+template <typename EntryTy, size_t MaxBlocks>
+class BlockCache
+{
+public:
+    /// A decoded block. The page generation must be read before the memory
+    /// is decoded, so concurrent writes are never missed.
+    struct Block
+    {
+        uptr physical_address;
+        ArrayByteMemory* memory;
+        size_t memory_offset;
+        uword page_generation;
+        std::vector<EntryTy> entries;
+
+        /// Returns if the backing memory page has not been written to since the block was built.
+        bool is_valid() const
+        {
+            return memory->page_generation(memory_offset) == page_generation;
+        }
+    };
+
+    /// Returns the block starting at the given physical address, or nullptr if none exists.
+    /// The block returned may be stale - check with Block::is_valid().
+    Block* find(const uptr physical_address)
+    {
+        auto it = blocks.find(physical_address);
+        if (it == blocks.end())
+            return nullptr;
+        return &it->second;
+    }
+
+    /// Inserts (or replaces) the block, returning a pointer to the cached copy.
+    /// The cache is flushed beforehand if it is full, which invalidates all previously returned blocks.
+    Block* insert(Block&& block)
+    {
+        if (blocks.size() >= MaxBlocks)
+            flush();
+
+        Block& cached_block = blocks[block.physical_address];
+        cached_block = std::move(block);
+        return &cached_block;
+    }
+
+    /// Removes all blocks.
+    void flush()
+    {
+        blocks.clear();
+    }
+
+private:
+    std::unordered_map<uptr, Block> blocks;
+};
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <tuple>
+#include <typeinfo>
 #include <vector>
 
 #include <boost/format.hpp>
@@ -10,6 +13,9 @@
 #include "Common/Types/Bitfield.hpp"
 #include "Common/Types/Bus/BusContext.hpp"
 #include "Common/Types/Bus/ByteBusMappable.hpp"
+#include "Common/Types/Bus/FastmemArena.hpp"
+#include "Common/Types/Memory/ArrayByteMemory.hpp"
+#include "Common/Types/PerfCounters.hpp"
 #include "Common/Types/Primitive.hpp"
 #include "Utilities/Utilities.hpp"
 
@@ -21,6 +27,8 @@
 /// It is byte-addressable, and can map the full range of the address type used.
 /// The mapping method is actually just a 2 level (directory and pages) page table!
 /// The page size is variable per directory, allowing for minimal memory usage.
+/// Optionally, plain memory can be placed into a flat host address range (fastmem),
+/// in which case accesses to it skip the page table and become a direct host access.
 template <typename AddressTy>
 class ByteBus
 {
@@ -29,6 +37,12 @@ public:
     {
         AddressTy base_address;
         ByteBusMappable* object;
+
+        /// Direct host access for plain memory (ArrayByteMemory) pages, skipping the virtual dispatch.
+        /// The host pointer corresponds to the base address, and the writable memory is only set if
+        /// the memory is writable (written pages are marked through it). Both are nullptr for all other objects.
+        ubyte* host_memory;
+        ArrayByteMemory* host_writable;
     };
 
     struct Directory
@@ -42,8 +56,8 @@ public:
         directory_mask(Bitfield(size_bits<AddressTy>() - directory_mask_length, directory_mask_length)) // Directory mask always occupies most upper bits.
     {
         // Initialise directories, number of directories is fixed.
-        // Initially we assume a page size of 1 byte (ie: 0 page index bits),
-        // which will later get optimised once everything is mapped. The
+        // The page table of each directory is only allocated when first mapped into,
+        // using a page size equal to the alignment of that mapping (see map()). The
         // initial optimal page size is equal to the number of bits left in
         // the 32-bit address (ie: 1 mapping per directory).
         table.resize(static_cast<size_t>(1) << directory_mask.length);
@@ -59,6 +73,8 @@ public:
 
     /// Map an object onto the bus, starting at the given address.
     /// The map size is dependant on the object. See ByteBusMappable::bus_size().
+    /// Plain memory objects are accessed through their storage directly, the bus follows it if it is
+    /// moved (see ArrayByteMemory::relocate()), so the bus must not be moved or destroyed before them.
     void map(const AddressTy address, ByteBusMappable* object)
     {
         // Who's trying to map a zero-sized object anyway...
@@ -80,14 +96,20 @@ public:
         {
             auto& directory = table[directory_index];
 
-            // Check if alignment doesnt fit the current page size.
-            // The current directory would need to be resized to accomodate
-            // it, but not supported for now.
-            if (alignment < directory.page_mask.start)
-                throw std::runtime_error("Alignment was smaller than current page size, resizing unsupported.");
-
-            // Resize directory if needed.
-            directory.page_table.resize(static_cast<size_t>(1) << directory.page_mask.length);
+            // Allocate the page table on first use, with pages as coarse as the alignment allows.
+            // Allocating with 1 byte pages and optimising afterwards costs ~2MB per directory mapped
+            // into, which dominated the core startup time. Split the existing pages if the
+            // alignment doesnt fit the current page size.
+            const int page_bits = std::min(alignment, size_bits<AddressTy>() - directory_mask.length);
+            if (directory.page_table.empty())
+            {
+                directory.page_mask = Bitfield(page_bits, size_bits<AddressTy>() - directory_mask.length - page_bits);
+                directory.page_table.resize(static_cast<size_t>(1) << directory.page_mask.length);
+            }
+            else if (page_bits < directory.page_mask.start)
+            {
+                split_pages(directory_index, page_bits);
+            }
 
             // Set the optimal page size.
             directory.optimal_alignment = std::min(directory.optimal_alignment, alignment);
@@ -105,6 +127,7 @@ public:
 
                 page.base_address = address;
                 page.object = object;
+                bind_host_memory(page);
                 page_index++;
 
                 map_size += page_size;
@@ -117,6 +140,19 @@ public:
         }
 
     finished:; // Done.
+
+        // Refresh the direct host pointers whenever the storage moves (once per memory, for mirrors).
+        if (typeid(*object) == typeid(ArrayByteMemory))
+        {
+            auto memory = static_cast<ArrayByteMemory*>(object);
+            if (std::find(host_memories.begin(), host_memories.end(), memory) == host_memories.end())
+            {
+                host_memories.push_back(memory);
+                memory->add_relocation_listener([this, memory]() {
+                    rebind_host_memory(memory);
+                });
+            }
+        }
     }
 
     /// Given the address properties, performs a lookup in the page
@@ -152,21 +188,48 @@ public:
     /// Read or write to a mapped object.
     ubyte read_ubyte(const BusContext context, const AddressTy address) const
     {
+        if (const ubyte* host = get_fastmem_read(address))
+            return *reinterpret_cast<const ubyte*>(host);
+
         auto& page = get_page(address);
+        count_page_access(page.host_memory);
         usize offset = address - page.base_address;
+        if (page.host_memory)
+            return *reinterpret_cast<const ubyte*>(page.host_memory + offset);
+
         return page.object->byte_bus_read_ubyte(context, offset);
     }
 
     void write_ubyte(const BusContext context, const AddressTy address, const ubyte value) const
     {
+        if (ArrayByteMemory* memory = get_fastmem_write(address))
+        {
+            ubyte* host = fastmem_base + address;
+            *reinterpret_cast<ubyte*>(host) = value;
+            memory->mark_written(host - memory->get_memory());
+            return;
+        }
+
         auto& page = get_page(address);
+        count_page_access(page.host_writable);
         usize offset = address - page.base_address;
+        if (page.host_writable)
+        {
+            *reinterpret_cast<ubyte*>(page.host_memory + offset) = value;
+            page.host_writable->mark_written(offset);
+            return;
+        }
+
         page.object->byte_bus_write_ubyte(context, offset, value);
     }
 
     uhword read_uhword(const BusContext context, const AddressTy address) const
     {
+        if (const ubyte* host = get_fastmem_read(address))
+            return *reinterpret_cast<const uhword*>(host);
+
         auto& page = get_page(address);
+        count_page_access(page.host_memory);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -174,12 +237,24 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+            return *reinterpret_cast<const uhword*>(page.host_memory + offset);
+
         return page.object->byte_bus_read_uhword(context, offset);
     }
 
     void write_uhword(const BusContext context, const AddressTy address, const uhword value) const
     {
+        if (ArrayByteMemory* memory = get_fastmem_write(address))
+        {
+            ubyte* host = fastmem_base + address;
+            *reinterpret_cast<uhword*>(host) = value;
+            memory->mark_written(host - memory->get_memory());
+            return;
+        }
+
         auto& page = get_page(address);
+        count_page_access(page.host_writable);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -187,12 +262,23 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_writable)
+        {
+            *reinterpret_cast<uhword*>(page.host_memory + offset) = value;
+            page.host_writable->mark_written(offset);
+            return;
+        }
+
         page.object->byte_bus_write_uhword(context, offset, value);
     }
 
     uword read_uword(const BusContext context, const AddressTy address) const
     {
+        if (const ubyte* host = get_fastmem_read(address))
+            return *reinterpret_cast<const uword*>(host);
+
         auto& page = get_page(address);
+        count_page_access(page.host_memory);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -200,12 +286,24 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+            return *reinterpret_cast<const uword*>(page.host_memory + offset);
+
         return page.object->byte_bus_read_uword(context, offset);
     }
 
     void write_uword(const BusContext context, const AddressTy address, const uword value) const
     {
+        if (ArrayByteMemory* memory = get_fastmem_write(address))
+        {
+            ubyte* host = fastmem_base + address;
+            *reinterpret_cast<uword*>(host) = value;
+            memory->mark_written(host - memory->get_memory());
+            return;
+        }
+
         auto& page = get_page(address);
+        count_page_access(page.host_writable);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -213,12 +311,23 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_writable)
+        {
+            *reinterpret_cast<uword*>(page.host_memory + offset) = value;
+            page.host_writable->mark_written(offset);
+            return;
+        }
+
         page.object->byte_bus_write_uword(context, offset, value);
     }
 
     udword read_udword(const BusContext context, const AddressTy address) const
     {
+        if (const ubyte* host = get_fastmem_read(address))
+            return *reinterpret_cast<const udword*>(host);
+
         auto& page = get_page(address);
+        count_page_access(page.host_memory);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -226,12 +335,24 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+            return *reinterpret_cast<const udword*>(page.host_memory + offset);
+
         return page.object->byte_bus_read_udword(context, offset);
     }
 
     void write_udword(const BusContext context, const AddressTy address, const udword value) const
     {
+        if (ArrayByteMemory* memory = get_fastmem_write(address))
+        {
+            ubyte* host = fastmem_base + address;
+            *reinterpret_cast<udword*>(host) = value;
+            memory->mark_written(host - memory->get_memory());
+            return;
+        }
+
         auto& page = get_page(address);
+        count_page_access(page.host_writable);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -239,12 +360,23 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_writable)
+        {
+            *reinterpret_cast<udword*>(page.host_memory + offset) = value;
+            page.host_writable->mark_written(offset);
+            return;
+        }
+
         page.object->byte_bus_write_udword(context, offset, value);
     }
 
     uqword read_uqword(const BusContext context, const AddressTy address) const
     {
+        if (const ubyte* host = get_fastmem_read(address))
+            return *reinterpret_cast<const uqword*>(host);
+
         auto& page = get_page(address);
+        count_page_access(page.host_memory);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -252,12 +384,24 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_memory)
+            return *reinterpret_cast<const uqword*>(page.host_memory + offset);
+
         return page.object->byte_bus_read_uqword(context, offset);
     }
 
     void write_uqword(const BusContext context, const AddressTy address, const uqword value) const
     {
+        if (ArrayByteMemory* memory = get_fastmem_write(address))
+        {
+            ubyte* host = fastmem_base + address;
+            *reinterpret_cast<uqword*>(host) = value;
+            memory->mark_written(host - memory->get_memory());
+            return;
+        }
+
         const auto& page = get_page(address);
+        count_page_access(page.host_writable);
         usize offset = address - page.base_address;
 
 #if DEBUG_BYTEBUS_RUNTIME_LOOKUP_CHECKS
@@ -265,9 +409,39 @@ public:
             throw std::runtime_error("Tried to access ByteBus with an unaligned offset.");
 #endif
 
+        if (page.host_writable)
+        {
+            *reinterpret_cast<uqword*>(page.host_memory + offset) = value;
+            page.host_writable->mark_written(offset);
+            return;
+        }
+
         page.object->byte_bus_write_uqword(context, offset, value);
     }
 
+    /// Returns a host pointer to the contiguous range [address, address + length), or nullptr if
+    /// the range is not fully backed by a single plain memory object (writable if requested).
+    /// Used for bulk transfers - after writing, call notify_host_range_written().
+    ubyte* get_host_range(const AddressTy address, const size_t length, const bool writable) const
+    {
+        const auto& page = get_page(address);
+        const usize offset = address - page.base_address;
+
+        if (!page.host_memory || (writable && !page.host_writable))
+            return nullptr;
+        if (offset + length > page.object->byte_bus_map_size())
+            return nullptr;
+
+        return page.host_memory + offset;
+    }
+
+    /// Marks the pages covering a range written through get_host_range() as written.
+    void notify_host_range_written(const AddressTy address, const size_t length) const
+    {
+        const auto& page = get_page(address);
+        page.host_writable->mark_range_written(address - page.base_address, length);
+    }
+
     /// Culls the page table to reduce memory footprint.
     /// Achieves this by resizing all page tables to use the optimal alignment.
     void optimise()
@@ -291,7 +465,73 @@ public:
         }
     }
 
+    /// Enables the fastmem mode for the plain memory objects given, which must already be mapped.
+    /// A host address range covering the whole bus is reserved, and the storage of each memory
+    /// is relocated to the host address equal to its (first) mapped address. Reads to these pages
+    /// and writes to the writable ones are then performed directly, everything else (MMIO, read-only
+    /// writes, mirrors) still goes through the page table.
+    /// Returns false if the host address space could not be reserved, in which case nothing is changed.
+    bool enable_fastmem(const std::vector<ArrayByteMemory*>& memories)
+    {
+        if (fastmem_arena)
+            throw std::runtime_error("Fastmem was already enabled.");
+
+        // The whole address range needs to fit within the host address space.
+        if (sizeof(AddressTy) >= sizeof(size_t))
+            return false;
+
+        const size_t arena_size = static_cast<size_t>(1) << size_bits<AddressTy>();
+        try
+        {
+            fastmem_arena = std::make_unique<FastmemArena>(arena_size);
+        }
+        catch (const std::runtime_error&)
+        {
+            return false;
+        }
+
+        const size_t number_pages = arena_size >> ArrayByteMemory::PAGE_SHIFT;
+        fastmem_readable.assign(number_pages, 0);
+        fastmem_writable.assign(number_pages, nullptr);
+
+        for (auto memory : memories)
+        {
+            // Pages have to line up with the memory's write generation pages.
+            const AddressTy address = get_mapped_address(memory);
+            const size_t size = memory->byte_bus_map_size();
+            if ((address % ArrayByteMemory::PAGE_SIZE) || (size % ArrayByteMemory::PAGE_SIZE))
+                throw std::runtime_error("Fastmem memory was not page aligned.");
+
+            memory->relocate(fastmem_arena->commit(address, size));
+
+            for (size_t offset = 0; offset < size; offset += ArrayByteMemory::PAGE_SIZE)
+            {
+                const size_t page_index = (address + offset) >> ArrayByteMemory::PAGE_SHIFT;
+                fastmem_readable[page_index] = 1;
+                if (!memory->is_read_only())
+                    fastmem_writable[page_index] = memory;
+            }
+        }
+
+        fastmem_base = fastmem_arena->get_base();
+        return true;
+    }
+
 private:
+    /// Refreshes the host access pointers of all pages mapping the memory (after its storage has moved).
+    /// Called by the memory on relocation (see map()), which covers the other buses mapping it too.
+    void rebind_host_memory(const ArrayByteMemory* memory)
+    {
+        for (auto& directory : table)
+        {
+            for (auto& page : directory.page_table)
+            {
+                if (page.object == memory)
+                    bind_host_memory(page);
+            }
+        }
+    }
+
     /// Returns the VDN (virtual directory number) for the address
     /// given using this Bus' context.
     size_t get_vdn(const AddressTy address) const
@@ -299,6 +539,92 @@ private:
         return directory_mask.extract_from(address);
     }
 
+    /// Resizes the page table of the directory to the finer page size given.
+    /// Each new page only keeps the old page's mapping if it is within the mapped object,
+    /// so the table is the same as if it was mapped at the finer page size to begin with.
+    void split_pages(const size_t directory_index, const int page_bits)
+    {
+        auto& directory = table[directory_index];
+        const Bitfield split_page_mask = Bitfield(page_bits, size_bits<AddressTy>() - directory_mask.length - page_bits);
+        auto split_page_table = std::vector<Page>(static_cast<size_t>(1) << split_page_mask.length);
+
+        const int shift = directory.page_mask.start - page_bits;
+        const size_t directory_address = directory_index << directory_mask.start;
+        for (size_t index = 0; index < split_page_table.size(); index++)
+        {
+            const Page& page = directory.page_table[index >> shift];
+            const size_t address = directory_address + (index << page_bits);
+            if (page.object && (address - page.base_address) < page.object->byte_bus_map_size())
+                split_page_table[index] = page;
+        }
+
+        directory.page_table.swap(split_page_table);
+        directory.page_mask = split_page_mask;
+    }
+
+    /// Sets the direct host access pointers for the page if it maps plain memory.
+    /// Subclasses of ArrayByteMemory are registers with side effects, and always use the virtual path.
+    static void bind_host_memory(Page& page)
+    {
+        page.host_memory = nullptr;
+        page.host_writable = nullptr;
+
+        if (typeid(*page.object) != typeid(ArrayByteMemory))
+            return;
+
+        auto memory = static_cast<ArrayByteMemory*>(page.object);
+        page.host_memory = memory->get_memory();
+        if (!memory->is_read_only())
+            page.host_writable = memory;
+    }
+
+    /// Returns the lowest address the object is mapped at.
+    AddressTy get_mapped_address(const ByteBusMappable* object) const
+    {
+        for (const auto& directory : table)
+        {
+            for (const auto& page : directory.page_table)
+            {
+                if (page.object == object)
+                    return page.base_address;
+            }
+        }
+
+        throw std::runtime_error("Object was not mapped in the bus.");
+    }
+
+    /// Returns the host address to read from directly, or nullptr if the page table must be used.
+    const ubyte* get_fastmem_read(const AddressTy address) const
+    {
+        if (fastmem_base && fastmem_readable[address >> ArrayByteMemory::PAGE_SHIFT])
+        {
+            PerfCounters::count_bus_access(PerfBusRegion::Type::Fastmem);
+            return fastmem_base + address;
+        }
+        return nullptr;
+    }
+
+    /// Returns the memory to mark as written after writing to the host address directly,
+    /// or nullptr if the page table must be used.
+    ArrayByteMemory* get_fastmem_write(const AddressTy address) const
+    {
+        if (fastmem_base)
+        {
+            if (ArrayByteMemory* memory = fastmem_writable[address >> ArrayByteMemory::PAGE_SHIFT])
+            {
+                PerfCounters::count_bus_access(PerfBusRegion::Type::Fastmem);
+                return memory;
+            }
+        }
+        return nullptr;
+    }
+
+    /// Counts an access through the page table, which went to plain memory if the host pointer given is set.
+    static void count_page_access(const void* host)
+    {
+        PerfCounters::count_bus_access(host ? PerfBusRegion::Type::Memory : PerfBusRegion::Type::Io);
+    }
+
     /// Constant directory mask (set at construction). This can't change
     /// once set.
     const Bitfield directory_mask;
@@ -310,4 +636,14 @@ private:
     /// Call cull_memory() after all mappings have been made to increase
     /// this page size to the optimal value.
     std::vector<Directory> table;
+
+    /// Plain memories mapped, which notify the bus when their storage moves (see map()).
+    std::vector<ArrayByteMemory*> host_memories;
+
+    /// Fastmem state (see enable_fastmem()), with a readable flag (a byte, not a packed bit, as it is checked on every access) and writable memory per 4KB page.
+    /// The base pointer is only set once fastmem is enabled.
+    std::unique_ptr<FastmemArena> fastmem_arena;
+    ubyte* fastmem_base = nullptr;
+    std::vector<ubyte> fastmem_readable;
+    std::vector<ArrayByteMemory*> fastmem_writable;
 };
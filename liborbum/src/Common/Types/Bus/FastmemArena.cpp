@@ -0,0 +1,53 @@
+#include <stdexcept>
+
+#include <Macros.hpp>
+
+#if defined(ENV_WINDOWS)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Common/Types/Bus/FastmemArena.hpp"
+
+FastmemArena::FastmemArena(const size_t size) :
+    size(size)
+{
+#if defined(ENV_WINDOWS)
+    base = static_cast<ubyte*>(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+    if (!base)
+        throw std::runtime_error("Could not reserve fastmem address space.");
+#else
+    void* mapping = mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Could not reserve fastmem address space.");
+    base = static_cast<ubyte*>(mapping);
+#endif
+}
+
+FastmemArena::~FastmemArena()
+{
+#if defined(ENV_WINDOWS)
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, size);
+#endif
+}
+
+ubyte* FastmemArena::commit(const size_t offset, const size_t length)
+{
+    if (offset + length > size)
+        throw std::runtime_error("Fastmem commit was outside of the reserved range.");
+
+#if defined(ENV_WINDOWS)
+    if (!VirtualAlloc(base + offset, length, MEM_COMMIT, PAGE_READWRITE))
+        throw std::runtime_error("Could not commit fastmem memory.");
+#else
+    if (mprotect(base + offset, length, PROT_READ | PROT_WRITE) != 0)
+        throw std::runtime_error("Could not commit fastmem memory.");
+#endif
+
+    return base + offset;
+}
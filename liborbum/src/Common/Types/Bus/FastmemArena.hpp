@@ -0,0 +1,30 @@
+#pragma once
+
+#include "Common/Types/Primitive.hpp"
+
+/// A reserved range of host virtual address space, used by the ByteBus fastmem mode.
+/// The whole range is reserved up front with no access allowed, and sub-ranges are
+/// committed (made read/write) as plain memory is placed into it. This allows a
+/// guest physical address to be converted into a host address with a single add.
+class FastmemArena
+{
+public:
+    FastmemArena(const size_t size);
+    ~FastmemArena();
+
+    FastmemArena(const FastmemArena&) = delete;
+    FastmemArena& operator=(const FastmemArena&) = delete;
+
+    /// Makes the range [offset, offset + length) accessible, and returns a pointer to it.
+    /// The offset and length should be host page aligned.
+    ubyte* commit(const size_t offset, const size_t length);
+
+    ubyte* get_base() const
+    {
+        return base;
+    }
+
+private:
+    ubyte* base;
+    size_t size;
+};
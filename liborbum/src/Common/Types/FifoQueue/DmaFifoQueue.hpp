@@ -1,68 +1,161 @@
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <cstring>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <cereal/cereal.hpp>
 
-#include <Queues.hpp>
-
 #include "Common/Types/FifoQueue/FifoQueue.hpp"
 
-/// SPSC-backed DMA FIFO queue.
+/// SPSC ring buffer DMA FIFO queue.
+/// The producer and consumer sides never wait on each other (the ring indices are lock-free).
+/// Each side can have more than one caller though, ie: the EE Core writes to the VIF/GIF/IPU
+/// FIFO's through the bus as well as the EE DMAC, so the callers on the same side are serialised
+/// by a spin lock, which is uncontended (a single atomic exchange) in the usual DMAC <-> consumer case.
+/// The buffer is qword aligned (and the size a multiple of a qword), so hword and qword
+/// spans are transfered with a memcpy and a single index update, rather than per byte.
 template <size_t Size = 1024>
 class DmaFifoQueue : public FifoQueue
 {
+    static_assert((Size & (Size - 1)) == 0 && Size >= NUMBER_BYTES_IN_QWORD, "DmaFifoQueue size must be a power of 2 and at least a qword.");
+
 public:
-    using QueueTy = SpscQueue<ubyte, Size>;
+    DmaFifoQueue() :
+        read_index(0),
+        write_index(0)
+    {
+    }
 
     /// Initialise FIFO queue (set to empty).
+    /// Not thread safe.
     void initialize() override
     {
-        fifo_queue.reset();
+        read_index = 0;
+        write_index = 0;
     }
 
     /// Reads byte(s) from the FIFO queue (pop).
     ubyte read_ubyte() override
     {
         ubyte data;
-        if (!fifo_queue.try_pop(data))
-            throw std::runtime_error("Could not pop from DMA fifo queue.");
+        read(&data, 1);
         return data;
     }
 
     /// Writes push bytes(s) to the end of the FIFO queue.
     void write_ubyte(const ubyte data) override
     {
-        if (!fifo_queue.try_push(data))
+        write(&data, 1);
+    }
+
+    /// Reads (pops) all of the bytes given at once.
+    void read(ubyte* buffer, const size_t length) override
+    {
+        std::lock_guard<SideLock> lock(read_lock);
+        const size_t read_position = read_index.load(std::memory_order_relaxed);
+        if (write_index.load(std::memory_order_acquire) - read_position < length)
+            throw std::runtime_error("Could not pop from DMA fifo queue.");
+
+        const size_t offset = read_position & MASK;
+        const size_t first_length = std::min(length, Size - offset);
+        std::memcpy(buffer, memory + offset, first_length);
+        std::memcpy(buffer + first_length, memory, length - first_length);
+
+        read_index.store(read_position + length, std::memory_order_release);
+    }
+
+    /// Writes (pushes) all of the bytes given at once.
+    void write(const ubyte* buffer, const size_t length) override
+    {
+        std::lock_guard<SideLock> lock(write_lock);
+        const size_t write_position = write_index.load(std::memory_order_relaxed);
+        if (Size - (write_position - read_index.load(std::memory_order_acquire)) < length)
             throw std::runtime_error("Could not push to DMA fifo queue.");
+
+        const size_t offset = write_position & MASK;
+        const size_t first_length = std::min(length, Size - offset);
+        std::memcpy(memory + offset, buffer, first_length);
+        std::memcpy(memory, buffer + first_length, length - first_length);
+
+        write_index.store(write_position + length, std::memory_order_release);
     }
 
-    /// Returns if there are at least the specified number of bytes
-    /// remaining in the queue available for reading.
-    /// Use only from a consumer thread (Boost requirement).
-    bool has_read_available(const size_t n_bytes) const override
+    /// Returns the number of bytes available for reading.
+    /// A lower bound, exact while no other consumer is running.
+    size_t read_available() const override
     {
-        return fifo_queue.has_read_available(n_bytes);
+        return write_index.load(std::memory_order_acquire) - read_index.load(std::memory_order_acquire);
     }
 
-    /// Returns if there are at least the specified number of bytes
-    /// available in the queue available for writing.
-    /// Use only from a producer thread (Boost requirement).
-    bool has_write_available(const size_t n_bytes) const override
+    /// Returns the number of bytes available for writing.
+    /// A lower bound, exact while no other producer is running.
+    size_t write_available() const override
     {
-        return fifo_queue.has_write_available(n_bytes);
+        return Size - read_available();
     }
 
-    template<class Archive>
-    void serialize(Archive & archive)
+    template <class Archive>
+    void save(Archive& archive) const
     {
-        archive(
-            CEREAL_NVP(fifo_queue)
-        );
+        size_t length = read_available();
+        std::vector<ubyte> data(length);
+
+        const size_t read_position = read_index.load(std::memory_order_acquire);
+        for (size_t i = 0; i < length; i++)
+            data[i] = memory[(read_position + i) & MASK];
+
+        archive(CEREAL_NVP(length));
+        archive(cereal::binary_data(data.data(), data.size()));
+    }
+
+    template <class Archive>
+    void load(Archive& archive)
+    {
+        size_t length;
+        archive(CEREAL_NVP(length));
+
+        std::vector<ubyte> data(length);
+        archive(cereal::binary_data(data.data(), data.size()));
+
+        initialize();
+        DmaFifoQueue::write(data.data(), data.size());
     }
 
 private:
+    static constexpr size_t MASK = Size - 1;
+
+    /// Serialises the callers on one side of the ring (see the class comment).
+    /// The critical sections are a memcpy, so spinning is cheaper than a mutex.
+    class SideLock
+    {
+    public:
+        void lock()
+        {
+            while (locked.exchange(true, std::memory_order_acquire))
+                std::this_thread::yield();
+        }
+
+        void unlock()
+        {
+            locked.store(false, std::memory_order_release);
+        }
+
+    private:
+        std::atomic<bool> locked{false};
+    };
+
+    /// Free running read/write positions (wrapped on access), owned by the consumer/producer side respectively.
+    alignas(64) std::atomic<size_t> read_index;
+    SideLock read_lock;
+    alignas(64) std::atomic<size_t> write_index;
+    SideLock write_lock;
+
     /// The backend for the FIFO queue.
-    QueueTy fifo_queue;
+    alignas(64) ubyte memory[Size];
 };
@@ -21,26 +21,60 @@ public:
     virtual void write_ubyte(const ubyte data) = 0;
 
     /// Reads bytes to the buffer given.
-    /// This is a wrapper around the read_ubyte function, and should not be treated as a separate interface (not made virtual).
-    void read(ubyte* buffer, const size_t length)
+    /// By default this calls read_ubyte for each byte, implementations should override it for bulk transfers.
+    virtual void read(ubyte* buffer, const size_t length)
     {
         for (size_t i = 0; i < length; i++)
             buffer[i] = read_ubyte();
     }
 
     /// Writes bytes from the buffer given.
-    /// This is a wrapper around the write_ubyte function, and should not be treated as a separate interface (not made virtual).
-    void write(const ubyte* buffer, const size_t length)
+    /// By default this calls write_ubyte for each byte, implementations should override it for bulk transfers.
+    virtual void write(const ubyte* buffer, const size_t length)
     {
         for (size_t i = 0; i < length; i++)
             write_ubyte(buffer[i]);
     }
 
+    /// Reads/writes a span of hwords or qwords.
+    /// Wrappers around the read/write functions above.
+    void read_uhwords(uhword* data, const size_t count)
+    {
+        read(reinterpret_cast<ubyte*>(data), count * NUMBER_BYTES_IN_HWORD);
+    }
+
+    void write_uhwords(const uhword* data, const size_t count)
+    {
+        write(reinterpret_cast<const ubyte*>(data), count * NUMBER_BYTES_IN_HWORD);
+    }
+
+    void read_uqwords(uqword* data, const size_t count)
+    {
+        read(reinterpret_cast<ubyte*>(data), count * NUMBER_BYTES_IN_QWORD);
+    }
+
+    void write_uqwords(const uqword* data, const size_t count)
+    {
+        write(reinterpret_cast<const ubyte*>(data), count * NUMBER_BYTES_IN_QWORD);
+    }
+
+    /// Returns the number of bytes available for reading.
+    virtual size_t read_available() const = 0;
+
+    /// Returns the number of bytes available for writing.
+    virtual size_t write_available() const = 0;
+
     /// Checks if the queue has at least n_bytes available for reading.
-    virtual bool has_read_available(const size_t n_bytes) const = 0;
+    bool has_read_available(const size_t n_bytes) const
+    {
+        return read_available() >= n_bytes;
+    }
 
     /// Checks if the queue has at least n_bytes available for writing.
-    virtual bool has_write_available(const size_t n_bytes) const = 0;
+    bool has_write_available(const size_t n_bytes) const
+    {
+        return write_available() >= n_bytes;
+    }
 
     /// Check if queue is full/empty (wrappers around above functions).
     bool is_empty() const
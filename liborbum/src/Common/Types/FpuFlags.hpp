@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Common/Types/Primitive.hpp"
+
 /// Used when converting an IEEE754 spec float to a PS2 spec float, to signify if:
 /// - Z flag set: the parsed value was zero (applies to +/- 0).
 /// - S flag set: the parsed value was negative.
@@ -11,4 +13,14 @@ struct FpuFlags
     bool SF;
     bool UF;
     bool OF;
-};
\ No newline at end of file
+};
+
+/// The FpuFlags of 4 vector fields (x, y, z, w) at once.
+/// Each flag is a 4-bit mask in the VU dest/MAC field order: bit 3 = x, bit 2 = y, bit 1 = z, bit 0 = w.
+struct FpuVectorFlags
+{
+    uword ZF;
+    uword SF;
+    uword UF;
+    uword OF;
+};
@@ -1,37 +1,176 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <vector>
 
+#include <cereal/cereal.hpp>
+
+#include "Common/Constants.hpp"
 #include "Common/Types/Memory/ByteMemory.hpp"
+#include "Common/Types/Memory/HostMemory.hpp"
 
 /// Array backed byte-addressed memory.
 /// Can be optionally initialised with a byte value, copied across the whole array.
+/// A write generation counter is kept for each 4KB page, which is incremented
+/// whenever the page is written to. Consumers caching derived state (such as
+/// decoded instructions) can compare against it to detect stale data.
+/// A dirty flag is also kept for each page, set on writes and only cleared on request,
+/// used to find the pages changed since a point in time (ie: incremental snapshots).
+/// Both are always on, as the cost is a couple of stores per write.
+/// The storage is owned by default, but can be relocated into external memory
+/// (see ByteBus::enable_fastmem()). Large memories are allocated from the host OS
+/// (see HostMemory), so untouched pages cost nothing and files can be mapped in directly.
 class ArrayByteMemory : public ByteMemory
 {
 public:
+    static constexpr size_t PAGE_SIZE = Constants::SIZE_4KB;
+    static constexpr size_t PAGE_SHIFT = 12;
+
+    /// Memories at least this large use host allocated storage.
+    static constexpr size_t HOST_MEMORY_MIN_SIZE = Constants::SIZE_64KB;
+
     ArrayByteMemory(const size_t size, const ubyte initial_value = 0, const bool read_only = false) :
         size(size),
-        memory(size, initial_value),
+        memory(nullptr),
+        host_mapped(size >= HOST_MEMORY_MIN_SIZE),
+        page_generations((size + PAGE_SIZE - 1) / PAGE_SIZE, 0),
+        dirty_pages((size + PAGE_SIZE - 1) / PAGE_SIZE, 1),
         initial_value(initial_value),
-        read_only(read_only)
+        read_only(read_only),
+        serialize_contents(true)
     {
+        if (host_mapped)
+        {
+            host_memory = std::make_unique<HostMemory>(size);
+            memory = host_memory->get_base();
+            if (initial_value)
+                std::fill(memory, memory + size, initial_value);
+        }
+        else
+        {
+            owned_memory.assign(size, initial_value);
+            memory = owned_memory.data();
+        }
     }
 
     /// Initialise memory.
     void initialize() override
     {
-        std::vector<ubyte>(size, initial_value).swap(memory);
+        if (!(host_mapped && !initial_value && HostMemory::zero(memory, size)))
+            std::fill(memory, memory + size, initial_value);
+        invalidate_all_pages();
+    }
+
+    /// Returns the write generation of the page containing the offset.
+    uword page_generation(const size_t offset) const
+    {
+        return page_generations[offset >> PAGE_SHIFT];
+    }
+
+    /// Marks the page containing the offset as written (increments the write generation and sets the dirty flag).
+    /// Used by the ByteBus direct access paths, which write to the storage directly.
+    void mark_written(const size_t offset)
+    {
+        const size_t page = offset >> PAGE_SHIFT;
+        page_generations[page]++;
+        dirty_pages[page] = 1;
+    }
+
+    /// Marks all pages covering the range as written.
+    /// Needs to be called after writing to the storage through get_memory().
+    void mark_range_written(const size_t offset, const size_t length)
+    {
+        if (!length)
+            return;
+
+        for (size_t page = offset >> PAGE_SHIFT; page <= ((offset + length - 1) >> PAGE_SHIFT); page++)
+        {
+            page_generations[page]++;
+            dirty_pages[page] = 1;
+        }
+    }
+
+    /// Returns the number of pages, including a trailing partial page.
+    size_t number_pages() const
+    {
+        return dirty_pages.size();
+    }
+
+    /// Returns if the page (index) has been written to since the dirty flags were last cleared.
+    /// All pages start off dirty.
+    /// There is only one set of flags, so only one consumer can use them at a time (the core snapshots).
+    bool is_page_dirty(const size_t page) const
+    {
+        return dirty_pages[page] != 0;
+    }
+
+    /// Clears the dirty flags of all pages.
+    void clear_dirty_pages()
+    {
+        std::fill(dirty_pages.begin(), dirty_pages.end(), 0);
+    }
+
+    /// Moves the storage into the external memory given, which must be at least size bytes long,
+    /// zero filled, allocated from the host OS (ie: by FastmemArena) and outlive this object.
+    /// The contents are copied across, skipping zero pages so they stay untouched.
+    void relocate(ubyte* external_memory)
+    {
+        static const ubyte zero_page[PAGE_SIZE] = {};
+        for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+        {
+            const size_t length = std::min(PAGE_SIZE, size - offset);
+            if (std::memcmp(memory + offset, zero_page, length) != 0)
+                std::memcpy(external_memory + offset, memory + offset, length);
+        }
+
+        memory = external_memory;
+        host_mapped = true;
+        std::vector<ubyte>().swap(owned_memory);
+        host_memory.reset();
+
+        for (auto& listener : relocation_listeners)
+            listener();
+    }
+
+    /// Adds a function called after the storage has moved (see relocate()).
+    /// Used by the buses holding direct pointers into the storage (see ByteBus::map()).
+    void add_relocation_listener(const std::function<void()>& listener)
+    {
+        relocation_listeners.push_back(listener);
+    }
+
+    bool is_read_only() const
+    {
+        return read_only;
+    }
+
+    /// Sets if the memory contents are included when serializing (on by default).
+    /// Turned off by the core snapshots, which keep track of the contents themselves (see ByteMemorySnapshots).
+    void set_serialize_contents(const bool enable)
+    {
+        serialize_contents = enable;
     }
 
     /// Read in a raw file to the memory (byte copy).
+    /// If the file covers the whole (host allocated) memory, it is mapped in copy-on-write instead (see HostMemory::map_file()).
     /// For Core use only! Do not use within the controller logic.
     void read_from_file(const std::string& path, const size_t file_length)
     {
+        if (host_mapped && file_length == size && HostMemory::map_file(memory, size, path))
+        {
+            invalidate_all_pages();
+            return;
+        }
+
         std::ifstream file(path, std::ios_base::binary);
         if (!file)
             throw std::runtime_error("Unable to read file");
         file.read(reinterpret_cast<char*>(&memory[0]), file_length);
+        invalidate_all_pages();
     }
 
     /// Dumps the memory contents to a file.
@@ -63,7 +202,10 @@ public:
 #endif
 
         if (!read_only)
+        {
             *reinterpret_cast<ubyte*>(&memory[offset]) = value;
+            mark_written(offset);
+        }
     }
 
     uhword read_uhword(const size_t offset) override
@@ -84,7 +226,10 @@ public:
 #endif
 
         if (!read_only)
+        {
             *reinterpret_cast<uhword*>(&memory[offset]) = value;
+            mark_written(offset);
+        }
     }
 
     uword read_uword(const size_t offset) override
@@ -105,7 +250,10 @@ public:
 #endif
 
         if (!read_only)
+        {
             *reinterpret_cast<uword*>(&memory[offset]) = value;
+            mark_written(offset);
+        }
     }
 
     udword read_udword(const size_t offset) override
@@ -126,7 +274,10 @@ public:
 #endif
 
         if (!read_only)
+        {
             *reinterpret_cast<udword*>(&memory[offset]) = value;
+            mark_written(offset);
+        }
     }
 
     uqword read_uqword(const size_t offset) override
@@ -147,7 +298,10 @@ public:
 #endif
 
         if (!read_only)
+        {
             *reinterpret_cast<uqword*>(&memory[offset]) = value;
+            mark_written(offset);
+        }
     }
 
     /// ByteBusMappable overrides.
@@ -158,7 +312,8 @@ public:
 
     /// Get a reference to the memory storage.
     /// Used for the emulator: sometimes we need to peek and poke directly.
-    std::vector<ubyte>& get_memory()
+    /// Writes made through this pointer are not tracked, see mark_range_written().
+    ubyte* get_memory()
     {
         return memory;
     }
@@ -167,8 +322,33 @@ private:
     /// Total size of the byte memory.
     size_t size;
 
-    /// Array backend for the byte memory.
-    std::vector<ubyte> memory;
+    /// Array or host allocated backend for the byte memory, and the pointer to the storage in use
+    /// (either one of the owned backends, or external memory after relocate()).
+    std::vector<ubyte> owned_memory;
+    std::unique_ptr<HostMemory> host_memory;
+    ubyte* memory;
+
+    /// Host mapped flag, set if the storage is host allocated and can be remapped (see HostMemory).
+    bool host_mapped;
+
+    /// Functions called after the storage has moved, see add_relocation_listener().
+    std::vector<std::function<void()>> relocation_listeners;
+
+    /// Write generation counters, one per page.
+    std::vector<uword> page_generations;
+
+    /// Dirty flags, one per page.
+    /// A byte is used instead of a bit, so writers on different threads (ie: the EE Core and DMAC)
+    /// never read-modify-write a shared word and lose each other's updates.
+    std::vector<ubyte> dirty_pages;
+
+    /// Marks every page as written (used when the whole memory is replaced).
+    void invalidate_all_pages()
+    {
+        for (auto& generation : page_generations)
+            generation++;
+        std::fill(dirty_pages.begin(), dirty_pages.end(), 1);
+    }
 
     /// Initial value.
     ubyte initial_value;
@@ -177,16 +357,24 @@ private:
     /// Writes are silently discarded if turned on.
     bool read_only;
 
+    /// Serialize contents flag, see set_serialize_contents().
+    bool serialize_contents;
+
 public:
     template<class Archive>
     void save(Archive & archive) const
     {
-        archive.saveBinaryValue(memory.data(), memory.size(), "memory");
+        if (serialize_contents)
+            archive(cereal::binary_data(memory, size));
     }
 
     template<class Archive>
     void load(Archive & archive)
-    {     
-        archive.loadBinaryValue(memory.data(), memory.size(), "memory");
+    {
+        if (serialize_contents)
+        {
+            archive(cereal::binary_data(memory, size));
+            invalidate_all_pages();
+        }
     }
 };
@@ -2,6 +2,7 @@
 
 #include <fstream>
 
+#include <cereal/cereal.hpp>
 #include <cereal/types/vector.hpp>
 
 #include "Common/Types/Memory/HwordMemory.hpp"
@@ -15,7 +16,8 @@ public:
         size(size),
         memory(size, initial_value),
         initial_value(initial_value),
-        read_only(read_only)
+        read_only(read_only),
+        serialize_contents(true)
     {
     }
 
@@ -130,6 +132,13 @@ public:
             *reinterpret_cast<uqword*>(&memory[offset]) = value;
     }
 
+    /// Sets if the memory contents are included when serializing (on by default).
+    /// Turned off by the core snapshots, which keep track of the contents themselves (see ByteMemorySnapshots).
+    void set_serialize_contents(const bool enable)
+    {
+        serialize_contents = enable;
+    }
+
     /// Get a reference to the memory storage.
     /// Used for the emulator: sometimes we need to peek and poke directly.
     std::vector<uhword>& get_memory()
@@ -151,16 +160,21 @@ private:
     /// Writes are silently discarded if turned on.
     bool read_only;
 
+    /// Serialize contents flag, see set_serialize_contents().
+    bool serialize_contents;
+
 public:
     template<class Archive>
     void save(Archive & archive) const
     {
-        archive.saveBinaryValue(reinterpret_cast<const char*>(memory.data()), memory.size() * sizeof(uhword), "memory");
+        if (serialize_contents)
+            archive(cereal::binary_data(memory.data(), memory.size() * sizeof(uhword)));
     }
 
     template<class Archive>
     void load(Archive & archive)
-    {     
-        archive.loadBinaryValue(reinterpret_cast<const char*>(memory.data()), memory.size() * sizeof(uhword), "memory");
+    {
+        if (serialize_contents)
+            archive(cereal::binary_data(memory.data(), memory.size() * sizeof(uhword)));
     }
 };
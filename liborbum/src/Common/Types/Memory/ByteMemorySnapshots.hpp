@@ -0,0 +1,242 @@
+#pragma once
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <vector>
+
+#include "Common/Types/Memory/ArrayByteMemory.hpp"
+#include "Common/Types/Memory/ArrayHwordMemory.hpp"
+
+/// Incremental (dirty page) snapshots of the contents of a set of memories.
+/// The first snapshot holds a full copy of each memory, and each one after that only holds
+/// the 4KB pages that changed since the previous one. For byte memories, only the dirty pages
+/// are checked (see ArrayByteMemory::is_page_dirty()), and the dirty flags are then cleared.
+/// Hword memories have no write tracking, so all of their pages are checked.
+/// Checked pages are compared against a shadow copy of the memory, so rewrites of the same data are dropped.
+/// Read-only memories are only copied into the base snapshot, as their contents only change when
+/// the whole state is replaced (which also discards the snapshots).
+/// Once the snapshot limit is reached, the oldest delta is folded into the base snapshot.
+/// The memories must outlive this object.
+class ByteMemorySnapshots
+{
+public:
+    static constexpr size_t PAGE_SIZE = ArrayByteMemory::PAGE_SIZE;
+
+    ByteMemorySnapshots(const size_t max_snapshots) :
+        max_snapshots(std::max<size_t>(max_snapshots, 1))
+    {
+    }
+
+    /// Adds a memory to the set. Only valid before any snapshots are taken.
+    void add(ArrayByteMemory* memory)
+    {
+        add({memory, nullptr});
+    }
+
+    void add(ArrayHwordMemory* memory)
+    {
+        add({nullptr, memory});
+    }
+
+    /// Returns the number of snapshots held.
+    size_t count() const
+    {
+        return base.empty() ? 0 : deltas.size() + 1;
+    }
+
+    /// Takes a snapshot of the memory contents, returning its index.
+    size_t take()
+    {
+        if (base.empty())
+        {
+            for (auto& memory : memories)
+            {
+                base.emplace_back(memory.data(), memory.data() + memory.size());
+                shadow.push_back(base.back());
+                if (memory.byte_memory)
+                    memory.byte_memory->clear_dirty_pages();
+            }
+
+            return 0;
+        }
+
+        // Store the changed pages, and bring the shadow copy up to date.
+        std::vector<Page> delta;
+        for (size_t i = 0; i < memories.size(); i++)
+        {
+            if (memories[i].is_read_only())
+                continue;
+
+            const ubyte* data = memories[i].data();
+            ubyte* shadow_data = shadow[i].data();
+            const size_t size = memories[i].size();
+            ArrayByteMemory* byte_memory = memories[i].byte_memory;
+
+            for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+            {
+                if (byte_memory && !byte_memory->is_page_dirty(offset / PAGE_SIZE))
+                    continue;
+
+                const size_t length = std::min(PAGE_SIZE, size - offset);
+                if (std::memcmp(data + offset, shadow_data + offset, length) != 0)
+                {
+                    std::memcpy(shadow_data + offset, data + offset, length);
+                    delta.push_back({i, offset, std::vector<ubyte>(data + offset, data + offset + length)});
+                }
+            }
+
+            if (byte_memory)
+                byte_memory->clear_dirty_pages();
+        }
+        deltas.push_back(std::move(delta));
+
+        // Fold the oldest delta into the base if over the limit.
+        if (count() > max_snapshots)
+        {
+            apply(deltas.front(), base);
+            deltas.pop_front();
+        }
+
+        return count() - 1;
+    }
+
+    /// Restores the memory contents to those of the snapshot at the index given,
+    /// discarding all later snapshots. Restored pages are marked as written.
+    void restore(const size_t index)
+    {
+        if (index >= count())
+            throw std::runtime_error("Tried to restore a snapshot that does not exist.");
+
+        // Rebuild the shadow copy at the snapshot, and write back the pages which differ.
+        shadow = base;
+        for (size_t i = 0; i < index; i++)
+            apply(deltas[i], shadow);
+
+        for (size_t i = 0; i < memories.size(); i++)
+        {
+            if (memories[i].is_read_only())
+                continue;
+
+            ubyte* data = memories[i].data();
+            const ubyte* shadow_data = shadow[i].data();
+            const size_t size = memories[i].size();
+
+            for (size_t offset = 0; offset < size; offset += PAGE_SIZE)
+            {
+                const size_t length = std::min(PAGE_SIZE, size - offset);
+                if (std::memcmp(data + offset, shadow_data + offset, length) != 0)
+                {
+                    std::memcpy(data + offset, shadow_data + offset, length);
+                    if (memories[i].byte_memory)
+                        memories[i].byte_memory->mark_written(offset);
+                }
+            }
+        }
+
+        deltas.resize(index);
+    }
+
+    /// Discards all snapshots.
+    void clear()
+    {
+        base.clear();
+        shadow.clear();
+        deltas.clear();
+    }
+
+    /// Sets if the memory contents are included when the memories are serialized.
+    /// See ExcludeContents.
+    void set_serialize_contents(const bool enable)
+    {
+        for (auto& memory : memories)
+        {
+            if (memory.byte_memory)
+                memory.byte_memory->set_serialize_contents(enable);
+            else
+                memory.hword_memory->set_serialize_contents(enable);
+        }
+    }
+
+    /// Excludes the memory contents from serialization while in scope,
+    /// used when serializing the rest of the state alongside a snapshot.
+    class ExcludeContents
+    {
+    public:
+        ExcludeContents(ByteMemorySnapshots& snapshots) :
+            snapshots(snapshots)
+        {
+            snapshots.set_serialize_contents(false);
+        }
+
+        ~ExcludeContents()
+        {
+            snapshots.set_serialize_contents(true);
+        }
+
+    private:
+        ByteMemorySnapshots& snapshots;
+    };
+
+private:
+    /// A memory in the set, either byte or hword addressed.
+    /// The storage is looked up on each access, as it may be moved (see ArrayByteMemory::relocate()).
+    struct Memory
+    {
+        ArrayByteMemory* byte_memory;
+        ArrayHwordMemory* hword_memory;
+
+        ubyte* data() const
+        {
+            if (byte_memory)
+                return byte_memory->get_memory();
+            return reinterpret_cast<ubyte*>(hword_memory->get_memory().data());
+        }
+
+        bool is_read_only() const
+        {
+            return byte_memory && byte_memory->is_read_only();
+        }
+
+        size_t size() const
+        {
+            if (byte_memory)
+                return byte_memory->byte_bus_map_size();
+            return hword_memory->get_memory().size() * sizeof(uhword);
+        }
+    };
+
+    /// A changed page in a delta snapshot.
+    struct Page
+    {
+        size_t memory_index;
+        size_t offset;
+        std::vector<ubyte> data;
+    };
+
+    void add(const Memory& memory)
+    {
+        if (!base.empty())
+            throw std::runtime_error("Tried to add a memory to ByteMemorySnapshots after taking a snapshot.");
+        memories.push_back(memory);
+    }
+
+    /// Copies the pages of the delta into the full copies given.
+    static void apply(const std::vector<Page>& delta, std::vector<std::vector<ubyte>>& copies)
+    {
+        for (auto& page : delta)
+            std::copy(page.data.begin(), page.data.end(), copies[page.memory_index].begin() + page.offset);
+    }
+
+    size_t max_snapshots;
+
+    std::vector<Memory> memories;
+
+    /// Full copies of the memories, at the oldest snapshot (base) and the latest snapshot or restore (shadow).
+    std::vector<std::vector<ubyte>> base;
+    std::vector<std::vector<ubyte>> shadow;
+
+    /// Changed pages for each snapshot after the base.
+    std::deque<std::vector<Page>> deltas;
+};
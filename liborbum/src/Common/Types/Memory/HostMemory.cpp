@@ -0,0 +1,95 @@
+#include <cstdint>
+#include <stdexcept>
+
+#include <Macros.hpp>
+
+#if defined(ENV_WINDOWS)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "Common/Types/Memory/HostMemory.hpp"
+
+#if !defined(ENV_WINDOWS)
+/// Returns if the range is on host page boundaries.
+static bool is_page_aligned(const ubyte* address, const size_t length)
+{
+    const size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    return (reinterpret_cast<std::uintptr_t>(address) % page_size == 0) && (length % page_size == 0);
+}
+#endif
+
+HostMemory::HostMemory(const size_t size) :
+    size(size)
+{
+#if defined(ENV_WINDOWS)
+    base = static_cast<ubyte*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+    if (!base)
+        throw std::runtime_error("Could not allocate host memory.");
+#else
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Could not allocate host memory.");
+    base = static_cast<ubyte*>(mapping);
+#endif
+}
+
+HostMemory::~HostMemory()
+{
+#if defined(ENV_WINDOWS)
+    VirtualFree(base, 0, MEM_RELEASE);
+#else
+    munmap(base, size);
+#endif
+}
+
+bool HostMemory::map_file(ubyte* address, const size_t length, const std::string& path)
+{
+#if defined(ENV_WINDOWS)
+    return false;
+#else
+    if (!is_page_aligned(address, length))
+        return false;
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < length)
+    {
+        close(fd);
+        return false;
+    }
+
+    // A failed fixed mapping may have already unmapped the range, so it can't fall back.
+    void* mapping = mmap(address, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Could not map file into host memory.");
+
+    return true;
+#endif
+}
+
+bool HostMemory::zero(ubyte* address, const size_t length)
+{
+#if defined(ENV_WINDOWS)
+    return false;
+#else
+    if (!is_page_aligned(address, length))
+        return false;
+
+    void* mapping = mmap(address, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Could not zero host memory.");
+
+    return true;
+#endif
+}
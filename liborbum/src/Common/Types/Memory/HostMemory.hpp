@@ -0,0 +1,40 @@
+#pragma once
+
+#include <string>
+
+#include "Common/Types/Primitive.hpp"
+
+/// Page aligned memory allocated directly from the host OS, used as the storage of large memories.
+/// The pages are zero filled and only backed by physical memory once touched, so allocation costs
+/// the same regardless of size. Ranges of it can be replaced by a mapping of a file (ie: ROM images),
+/// which shares the host page cache between cores instead of copying the file.
+/// The static functions also work on memory reserved by FastmemArena.
+class HostMemory
+{
+public:
+    HostMemory(const size_t size);
+    ~HostMemory();
+
+    HostMemory(const HostMemory&) = delete;
+    HostMemory& operator=(const HostMemory&) = delete;
+
+    ubyte* get_base() const
+    {
+        return base;
+    }
+
+    /// Replaces the range with a private (copy-on-write) read/write mapping of the start of the file.
+    /// Returns false if this is not possible, in which case the range is unchanged and the file needs to be
+    /// read instead: the range is not host page aligned, the file is shorter than the range, or the host is Windows
+    /// (which can't map a file over already allocated memory).
+    /// Unwritten pages may reflect later changes to the file, so it should not be modified while mapped.
+    static bool map_file(ubyte* address, const size_t length, const std::string& path);
+
+    /// Replaces the range with fresh zero filled pages, releasing the old ones.
+    /// Returns false if this is not possible (same conditions as map_file()), in which case the range is unchanged.
+    static bool zero(ubyte* address, const size_t length);
+
+private:
+    ubyte* base;
+    size_t size;
+};
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// MIPS kernel mode virtual address segments, classified by the top 3 bits of the
+/// virtual address (512MB granularity). See the EE Core Users Manual page 121.
+/// kseg0 and kseg1 are unmapped, and translate to a physical address with a single
+/// subtract of the segment base. All other segments need to go through the MMU.
+/// Usable at compile time, ie: by a recompiler resolving constant addresses.
+struct MipsSegments
+{
+    struct Segment
+    {
+        /// Segment base address, or 0 if the segment is mapped.
+        uptr unmapped_base;
+
+        constexpr bool is_unmapped() const
+        {
+            return unmapped_base != 0;
+        }
+    };
+
+    /// Kernel mode segments, indexed by the top 3 bits of the virtual address.
+    static constexpr Segment KERNEL_SEGMENTS[8] =
+        {
+            {0},                                                   // kuseg.
+            {0},                                                   // kuseg.
+            {0},                                                   // kuseg.
+            {0},                                                   // kuseg.
+            {Constants::MIPS::MMU::VADDRESS_KERNEL_LOWER_BOUND_2}, // kseg0.
+            {Constants::MIPS::MMU::VADDRESS_KERNEL_LOWER_BOUND_3}, // kseg1.
+            {0},                                                   // ksseg.
+            {0}                                                    // kseg3.
+        };
+
+    /// Returns the kernel mode segment for the virtual address.
+    static constexpr const Segment& kernel_segment(const uptr virtual_address)
+    {
+        return KERNEL_SEGMENTS[virtual_address >> 29];
+    }
+};
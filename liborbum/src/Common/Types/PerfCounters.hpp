@@ -0,0 +1,105 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/// The TLS model of the current counters pointer. The initial exec model makes the access a
+/// plain segment relative load (instead of a __tls_get_addr() call in a shared library).
+#if defined(__GNUC__)
+#define PERF_TLS_MODEL __attribute__((tls_model("initial-exec")))
+#else
+#define PERF_TLS_MODEL
+#endif
+
+/// Describes the bus region type an access went to (see ByteBus).
+struct PerfBusRegion
+{
+    enum class Type
+    {
+        Fastmem, // Plain memory, through the fastmem host range.
+        Memory,  // Plain memory, through the page table.
+        Io,      // Registers, FIFO's and everything else with side effects.
+
+        COUNT
+    };
+
+    static constexpr const char* TYPE_STRINGS[] =
+        {
+            "Fastmem",
+            "Memory",
+            "Io",
+    };
+};
+
+/// Always-on profiling counters of a controller, see CoreApi::get_stats().
+/// Each controller owns one, aligned to a (64 byte) cache line so the threads running
+/// different controllers never write to the same line. Only written by the thread currently
+/// running the controller, and read by the core between runs.
+struct alignas(64) PerfCounters
+{
+    /// Events handled, and the host cycles spent in them (see read_cycles()).
+    size_t events;
+    std::uint64_t host_cycles;
+
+    /// Ticks run, and the ones where there was nothing to do.
+    /// Controllers that are idle (see CController::is_idle()) are not sent time events, so count neither.
+    size_t ticks;
+    size_t idle_ticks;
+
+    /// Instructions run (CPU controllers only).
+    size_t instructions;
+
+    /// Bytes moved between memory and the FIFO's (DMA controllers only).
+    size_t dma_bytes;
+
+    /// Bus accesses made while running the controller, per region type.
+    size_t bus_accesses[static_cast<size_t>(PerfBusRegion::Type::COUNT)];
+
+    /// The counters of the controller running on this thread, or nullptr outside of the controllers.
+    /// Used to attribute the accesses to shared objects (ie: the buses) to the controller making them.
+    PERF_TLS_MODEL static inline thread_local PerfCounters* current = nullptr;
+
+    /// Returns the host timestamp counter, or the steady clock in ns on hosts without one.
+    /// Cheap enough to be read around every event.
+    static std::uint64_t read_cycles()
+    {
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+    }
+
+    /// Counts a bus access against the controller running on this thread.
+    static void count_bus_access(const PerfBusRegion::Type region)
+    {
+        if (PerfCounters* counters = current)
+            counters->bus_accesses[static_cast<size_t>(region)]++;
+    }
+};
+
+/// Sets the current counters for this thread within a scope, restoring the previous ones after.
+class PerfScope
+{
+public:
+    PerfScope(PerfCounters* counters) :
+        previous(PerfCounters::current)
+    {
+        PerfCounters::current = counters;
+    }
+
+    ~PerfScope()
+    {
+        PerfCounters::current = previous;
+    }
+
+private:
+    PerfCounters* previous;
+};
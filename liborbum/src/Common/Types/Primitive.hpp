@@ -56,25 +56,25 @@ struct uqword
         ubyte ub[16];
     };
 
-    uqword() :
+    constexpr uqword() :
         lo(0),
         hi(0)
     {
     }
 
-    uqword(const udword ud) :
+    constexpr uqword(const udword ud) :
         lo(ud),
         hi(ud)
     {
     }
 
-    uqword(const udword lo, const udword hi) :
+    constexpr uqword(const udword lo, const udword hi) :
         lo(lo),
         hi(hi)
     {
     }
 
-    uqword(const uword uw0, const uword uw1, const uword uw2, const uword uw3) :
+    constexpr uqword(const uword uw0, const uword uw1, const uword uw2, const uword uw3) :
         uw{uw0, uw1, uw2, uw3}
     {
     }
@@ -0,0 +1,52 @@
+#include <cstring>
+#include <stdexcept>
+
+#include <Macros.hpp>
+
+#if defined(ENV_WINDOWS)
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Common/Types/Recompiler/ExecutableMemory.hpp"
+
+ExecutableMemory::ExecutableMemory(const size_t size) :
+    size(size),
+    used(0)
+{
+#if defined(ENV_WINDOWS)
+    memory = static_cast<ubyte*>(VirtualAlloc(nullptr, size, MEM_COMMIT | MEM_RESERVE, PAGE_EXECUTE_READWRITE));
+    if (!memory)
+        throw std::runtime_error("Could not allocate executable memory.");
+#else
+    void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE | PROT_EXEC, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mapping == MAP_FAILED)
+        throw std::runtime_error("Could not allocate executable memory.");
+    memory = static_cast<ubyte*>(mapping);
+#endif
+}
+
+ExecutableMemory::~ExecutableMemory()
+{
+#if defined(ENV_WINDOWS)
+    VirtualFree(memory, 0, MEM_RELEASE);
+#else
+    munmap(memory, size);
+#endif
+}
+
+const ubyte* ExecutableMemory::allocate(const std::vector<ubyte>& code)
+{
+    // Keep allocations 16-byte aligned.
+    const size_t aligned_size = (code.size() + 15) & ~static_cast<size_t>(15);
+    if (used + aligned_size > size)
+        return nullptr;
+
+    ubyte* address = memory + used;
+    std::memcpy(address, code.data(), code.size());
+    used += aligned_size;
+    return address;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <vector>
+
+#include "Common/Types/Primitive.hpp"
+
+/// A fixed size region of host executable memory, used to hold recompiled code.
+/// Allocation is a simple bump allocator - individual allocations cannot be freed,
+/// instead the whole region is reset at once (ie: when it becomes full).
+class ExecutableMemory
+{
+public:
+    ExecutableMemory(const size_t size);
+    ~ExecutableMemory();
+
+    ExecutableMemory(const ExecutableMemory&) = delete;
+    ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+    /// Copies the code into the region and returns a pointer to it.
+    /// Returns nullptr if there is not enough space left (see reset()).
+    const ubyte* allocate(const std::vector<ubyte>& code);
+
+    /// Releases all allocations made. Previously returned pointers are no longer valid.
+    void reset()
+    {
+        used = 0;
+    }
+
+private:
+    ubyte* memory;
+    size_t size;
+    size_t used;
+};
@@ -0,0 +1,441 @@
+#pragma once
+
+#include <cstring>
+#include <vector>
+
+#include "Common/Types/Primitive.hpp"
+
+/// Minimal x86-64 machine code emitter, used by the recompilers.
+/// Only the instruction forms needed by the recompilers are provided, and
+/// memory operands are always of the form [base + disp32].
+/// Code is emitted into a growable buffer, which is position independent
+/// (jumps are relative within the buffer), so it can be copied into
+/// executable memory afterwards.
+class X64Emitter
+{
+public:
+    enum Reg : ubyte
+    {
+        RAX = 0,
+        RCX,
+        RDX,
+        RBX,
+        RSP,
+        RBP,
+        RSI,
+        RDI,
+        R8,
+        R9,
+        R10,
+        R11,
+        R12,
+        R13,
+        R14,
+        R15
+    };
+
+    /// SSE registers. Only XMM0 -> XMM5 are caller-saved on all hosts (XMM6 and up are callee-saved on Windows).
+    enum XmmReg : ubyte
+    {
+        XMM0 = 0,
+        XMM1,
+        XMM2
+    };
+
+    /// ALU operations, encoded as their "op r/m, reg" opcode and /digit extension.
+    enum class AluOp : ubyte
+    {
+        Add = 0,
+        Or = 1,
+        And = 4,
+        Sub = 5,
+        Xor = 6,
+        Cmp = 7
+    };
+
+    /// Shift operations, encoded as their /digit extension.
+    enum class ShiftOp : ubyte
+    {
+        Shl = 4,
+        Shr = 5,
+        Sar = 7
+    };
+
+    /// Condition codes (used for jcc, setcc and cmovcc).
+    enum class Cond : ubyte
+    {
+        B = 0x2,
+        AE = 0x3,
+        E = 0x4,
+        NE = 0x5,
+        BE = 0x6,
+        A = 0x7,
+        L = 0xC,
+        GE = 0xD
+    };
+
+    /// SSE/SSE2 register to register operations, encoded as their mandatory prefix (0 if none) and 0x0F opcode.
+    enum class SseOp : uhword
+    {
+        Movdqa = 0x666F,
+        Paddb = 0x66FC,
+        Paddw = 0x66FD,
+        Paddd = 0x66FE,
+        Paddsb = 0x66EC,
+        Paddsw = 0x66ED,
+        Paddusb = 0x66DC,
+        Paddusw = 0x66DD,
+        Psubb = 0x66F8,
+        Psubw = 0x66F9,
+        Psubd = 0x66FA,
+        Psubsb = 0x66E8,
+        Psubsw = 0x66E9,
+        Psubusb = 0x66D8,
+        Psubusw = 0x66D9,
+        Pmaxsw = 0x66EE,
+        Pminsw = 0x66EA,
+        Pcmpeqb = 0x6674,
+        Pcmpeqw = 0x6675,
+        Pcmpeqd = 0x6676,
+        Pcmpgtb = 0x6664,
+        Pcmpgtw = 0x6665,
+        Pcmpgtd = 0x6666,
+        Pand = 0x66DB,
+        Pandn = 0x66DF,
+        Por = 0x66EB,
+        Pxor = 0x66EF,
+        Punpcklbw = 0x6660,
+        Punpcklwd = 0x6661,
+        Punpckldq = 0x6662,
+        Punpcklqdq = 0x666C,
+        Punpckhbw = 0x6668,
+        Punpckhwd = 0x6669,
+        Punpckhdq = 0x666A,
+        Punpckhqdq = 0x666D,
+        Addss = 0xF358,
+        Subss = 0xF35C,
+        Mulss = 0xF359,
+        Comiss = 0x002F
+    };
+
+    /// Returns the emitted code.
+    const std::vector<ubyte>& get_code() const
+    {
+        return code;
+    }
+
+    size_t size() const
+    {
+        return code.size();
+    }
+
+    /// Register to register moves.
+    void mov_r64_r64(const Reg dst, const Reg src)
+    {
+        emit_rr(true, 0x89, src, dst);
+    }
+
+    void mov_r32_r32(const Reg dst, const Reg src)
+    {
+        emit_rr(false, 0x89, src, dst);
+    }
+
+    /// Memory loads/stores, of the form [base + disp32].
+    void mov_r64_m64(const Reg dst, const Reg base, const sword disp)
+    {
+        emit_rm(true, 0x8B, dst, base, disp);
+    }
+
+    void mov_m64_r64(const Reg base, const sword disp, const Reg src)
+    {
+        emit_rm(true, 0x89, src, base, disp);
+    }
+
+    void mov_r32_m32(const Reg dst, const Reg base, const sword disp)
+    {
+        emit_rm(false, 0x8B, dst, base, disp);
+    }
+
+    void mov_m32_r32(const Reg base, const sword disp, const Reg src)
+    {
+        emit_rm(false, 0x89, src, base, disp);
+    }
+
+    /// Immediate loads.
+    void mov_r32_imm32(const Reg dst, const uword imm)
+    {
+        emit_rex(false, 0, dst);
+        emit_byte(0xB8 + (dst & 7));
+        emit_uword(imm);
+    }
+
+    void mov_r64_imm32(const Reg dst, const sword imm)
+    {
+        // Sign extended.
+        emit_rr(true, 0xC7, static_cast<Reg>(0), dst);
+        emit_uword(static_cast<uword>(imm));
+    }
+
+    void mov_r64_imm64(const Reg dst, const udword imm)
+    {
+        emit_rex(true, 0, dst);
+        emit_byte(0xB8 + (dst & 7));
+        emit_uword(static_cast<uword>(imm));
+        emit_uword(static_cast<uword>(imm >> 32));
+    }
+
+    /// Sign extends the lower 32-bits of src into dst.
+    void movsxd_r64_r32(const Reg dst, const Reg src)
+    {
+        emit_rr(true, 0x63, dst, src);
+    }
+
+    /// Zero extends the lower 8-bits of src into dst. Only the legacy byte registers (AL, CL, DL, BL) are supported.
+    void movzx_r32_r8(const Reg dst, const Reg src)
+    {
+        emit_rex(false, dst, src);
+        emit_byte(0x0F);
+        emit_byte(0xB6);
+        emit_modrm(3, dst, src);
+    }
+
+    /// ALU operations: dst = dst OP src.
+    void alu_r64_r64(const AluOp op, const Reg dst, const Reg src)
+    {
+        emit_rr(true, alu_opcode(op), src, dst);
+    }
+
+    void alu_r32_r32(const AluOp op, const Reg dst, const Reg src)
+    {
+        emit_rr(false, alu_opcode(op), src, dst);
+    }
+
+    /// ALU operations: dst = dst OP SignExtend(imm).
+    void alu_r64_imm32(const AluOp op, const Reg dst, const sword imm)
+    {
+        emit_rr(true, 0x81, static_cast<Reg>(op), dst);
+        emit_uword(static_cast<uword>(imm));
+    }
+
+    void alu_r32_imm32(const AluOp op, const Reg dst, const sword imm)
+    {
+        emit_rr(false, 0x81, static_cast<Reg>(op), dst);
+        emit_uword(static_cast<uword>(imm));
+    }
+
+    void not_r64(const Reg dst)
+    {
+        emit_rr(true, 0xF7, static_cast<Reg>(2), dst);
+    }
+
+    void neg_r64(const Reg dst)
+    {
+        emit_rr(true, 0xF7, static_cast<Reg>(3), dst);
+    }
+
+    void test_r64_r64(const Reg a, const Reg b)
+    {
+        emit_rr(true, 0x85, b, a);
+    }
+
+    void test_r32_imm32(const Reg a, const uword imm)
+    {
+        emit_rr(false, 0xF7, static_cast<Reg>(0), a);
+        emit_uword(imm);
+    }
+
+    void test_r8_r8(const Reg a, const Reg b)
+    {
+        emit_rex(false, b, a);
+        emit_byte(0x84);
+        emit_modrm(3, b, a);
+    }
+
+    /// Shift operations by an immediate amount, or by CL.
+    void shift_r64_imm(const ShiftOp op, const Reg dst, const ubyte amount)
+    {
+        emit_rr(true, 0xC1, static_cast<Reg>(op), dst);
+        emit_byte(amount);
+    }
+
+    void shift_r32_imm(const ShiftOp op, const Reg dst, const ubyte amount)
+    {
+        emit_rr(false, 0xC1, static_cast<Reg>(op), dst);
+        emit_byte(amount);
+    }
+
+    void shift_r64_cl(const ShiftOp op, const Reg dst)
+    {
+        emit_rr(true, 0xD3, static_cast<Reg>(op), dst);
+    }
+
+    void shift_r32_cl(const ShiftOp op, const Reg dst)
+    {
+        emit_rr(false, 0xD3, static_cast<Reg>(op), dst);
+    }
+
+    /// Sets the lower 8-bits of dst based on the condition. Only the legacy byte registers (AL, CL, DL, BL) are supported.
+    void setcc_r8(const Cond cond, const Reg dst)
+    {
+        emit_rex(false, 0, dst);
+        emit_byte(0x0F);
+        emit_byte(0x90 + static_cast<ubyte>(cond));
+        emit_modrm(3, 0, dst);
+    }
+
+    void cmovcc_r64_r64(const Cond cond, const Reg dst, const Reg src)
+    {
+        emit_rex(true, dst, src);
+        emit_byte(0x0F);
+        emit_byte(0x40 + static_cast<ubyte>(cond));
+        emit_modrm(3, dst, src);
+    }
+
+    /// SSE loads/stores (unaligned), of the form [base + disp32].
+    void movdqu_x_m128(const XmmReg dst, const Reg base, const sword disp)
+    {
+        emit_sse_rm(0xF3, 0x6F, dst, base, disp);
+    }
+
+    void movdqu_m128_x(const Reg base, const sword disp, const XmmReg src)
+    {
+        emit_sse_rm(0xF3, 0x7F, src, base, disp);
+    }
+
+    void movss_x_m32(const XmmReg dst, const Reg base, const sword disp)
+    {
+        emit_sse_rm(0xF3, 0x10, dst, base, disp);
+    }
+
+    /// Moves the lower 32-bits of src into dst.
+    void movd_r32_x(const Reg dst, const XmmReg src)
+    {
+        emit_byte(0x66);
+        emit_rex(false, src, dst);
+        emit_byte(0x0F);
+        emit_byte(0x7E);
+        emit_modrm(3, src, dst);
+    }
+
+    /// SSE operations: dst = dst OP src (or compares dst with src for Comiss).
+    void sse_x_x(const SseOp op, const XmmReg dst, const XmmReg src)
+    {
+        const ubyte prefix = static_cast<ubyte>(static_cast<uhword>(op) >> 8);
+        if (prefix)
+            emit_byte(prefix);
+        emit_rex(false, dst, src);
+        emit_byte(0x0F);
+        emit_byte(static_cast<ubyte>(op));
+        emit_modrm(3, dst, src);
+    }
+
+    /// Stack and control flow.
+    void push(const Reg reg)
+    {
+        emit_rex(false, 0, reg);
+        emit_byte(0x50 + (reg & 7));
+    }
+
+    void pop(const Reg reg)
+    {
+        emit_rex(false, 0, reg);
+        emit_byte(0x58 + (reg & 7));
+    }
+
+    void call_r64(const Reg reg)
+    {
+        emit_rr(false, 0xFF, static_cast<Reg>(2), reg);
+    }
+
+    void ret()
+    {
+        emit_byte(0xC3);
+    }
+
+    /// Emits a conditional/unconditional jump with an unresolved target, and returns a label to pass to bind().
+    size_t jcc_rel32(const Cond cond)
+    {
+        emit_byte(0x0F);
+        emit_byte(0x80 + static_cast<ubyte>(cond));
+        emit_uword(0);
+        return code.size();
+    }
+
+    size_t jmp_rel32()
+    {
+        emit_byte(0xE9);
+        emit_uword(0);
+        return code.size();
+    }
+
+    /// Resolves a jump label to target the current position.
+    void bind(const size_t label)
+    {
+        const uword rel = static_cast<uword>(code.size() - label);
+        std::memcpy(&code[label - sizeof(uword)], &rel, sizeof(uword));
+    }
+
+private:
+    std::vector<ubyte> code;
+
+    static ubyte alu_opcode(const AluOp op)
+    {
+        // "op r/m, reg" forms: add 01, or 09, and 21, sub 29, xor 31, cmp 39.
+        return static_cast<ubyte>((static_cast<ubyte>(op) << 3) | 0x01);
+    }
+
+    void emit_byte(const ubyte value)
+    {
+        code.push_back(value);
+    }
+
+    void emit_uword(const uword value)
+    {
+        for (int i = 0; i < 4; i++)
+            emit_byte(static_cast<ubyte>(value >> (i * 8)));
+    }
+
+    void emit_rex(const bool w, const int reg, const int rm)
+    {
+        const ubyte rex = 0x40 | (w ? 0x8 : 0) | ((reg & 8) ? 0x4 : 0) | ((rm & 8) ? 0x1 : 0);
+        if (rex != 0x40)
+            emit_byte(rex);
+    }
+
+    void emit_modrm(const int mod, const int reg, const int rm)
+    {
+        emit_byte(static_cast<ubyte>((mod << 6) | ((reg & 7) << 3) | (rm & 7)));
+    }
+
+    /// Register direct form (mod = 11).
+    void emit_rr(const bool w, const ubyte opcode, const Reg reg, const Reg rm)
+    {
+        emit_rex(w, reg, rm);
+        emit_byte(opcode);
+        emit_modrm(3, reg, rm);
+    }
+
+    /// Memory form [base + disp32] (mod = 10), with a SIB byte for RSP/R12 bases.
+    void emit_rm(const bool w, const ubyte opcode, const Reg reg, const Reg base, const sword disp)
+    {
+        emit_rex(w, reg, base);
+        emit_byte(opcode);
+        emit_modrm(2, reg, base);
+        if ((base & 7) == RSP)
+            emit_byte(0x24);
+        emit_uword(static_cast<uword>(disp));
+    }
+
+    /// SSE memory form [base + disp32], with the mandatory prefix and 0x0F escape.
+    void emit_sse_rm(const ubyte prefix, const ubyte opcode, const XmmReg reg, const Reg base, const sword disp)
+    {
+        emit_byte(prefix);
+        emit_rex(false, reg, base);
+        emit_byte(0x0F);
+        emit_byte(opcode);
+        emit_modrm(2, reg, base);
+        if ((base & 7) == RSP)
+            emit_byte(0x24);
+        emit_uword(static_cast<uword>(disp));
+    }
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+
+#include <cereal/cereal.hpp>
+
+#include "Common/Types/Bitfield.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/Register/WordRegister.hpp"
+
+/// Atomic Word register.
+/// Lock-free alternative to SizedWordRegister + ScopeLock, for registers written by
+/// multiple controllers at once (ie: IRQ bits set by peripherals and cleared by the CPU).
+/// Every access is a single atomic operation on the backing word - sub-word writes and
+/// field insertions use a CAS loop, so concurrent updates to other bits are never lost.
+class AtomicWordRegister : public WordRegister
+{
+public:
+    AtomicWordRegister(const uword initial_value = 0, const bool read_only = false) :
+        w(initial_value),
+        initial_value(initial_value),
+        read_only(read_only)
+    {
+    }
+
+    /// Initialise register.
+    void initialize() override
+    {
+        w.store(initial_value, std::memory_order_release);
+    }
+
+    /// Read/write functions to access the register.
+    ubyte read_ubyte(const size_t offset) override
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_BYTES_IN_WORD)
+            throw std::runtime_error("Tried to access AtomicWordRegister with an invalid offset.");
+#endif
+
+        return static_cast<ubyte>(read_uword() >> (offset * 8));
+    }
+
+    void write_ubyte(const size_t offset, const ubyte value) override
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_BYTES_IN_WORD)
+            throw std::runtime_error("Tried to access AtomicWordRegister with an invalid offset.");
+#endif
+
+        if (!read_only)
+            insert_field(Bitfield(static_cast<int>(offset) * 8, 8), value);
+    }
+
+    uhword read_uhword(const size_t offset) override
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_HWORDS_IN_WORD)
+            throw std::runtime_error("Tried to access AtomicWordRegister with an invalid offset.");
+#endif
+
+        return static_cast<uhword>(read_uword() >> (offset * 16));
+    }
+
+    void write_uhword(const size_t offset, const uhword value) override
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_HWORDS_IN_WORD)
+            throw std::runtime_error("Tried to access AtomicWordRegister with an invalid offset.");
+#endif
+
+        if (!read_only)
+            insert_field(Bitfield(static_cast<int>(offset) * 16, 16), value);
+    }
+
+    uword read_uword() override
+    {
+        return w.load(std::memory_order_acquire);
+    }
+
+    void write_uword(const uword value) override
+    {
+        if (!read_only)
+            w.store(value, std::memory_order_release);
+    }
+
+    /// Atomic bitfield insertion (CAS loop).
+    void insert_field(const Bitfield field, const uword value) override
+    {
+        if (read_only)
+            return;
+
+        uword old_value = w.load(std::memory_order_relaxed);
+        while (!w.compare_exchange_weak(old_value, field.insert_into<uword>(old_value, value), std::memory_order_acq_rel, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    /// Sets all bits of the field (atomic OR), ie: for raising an IRQ line.
+    void set_field(const Bitfield field)
+    {
+        set_bits(field.shifted_mask<uword>());
+    }
+
+    /// Sets/clears the bits given (atomic OR/AND), returning the previous value.
+    uword set_bits(const uword mask)
+    {
+        if (read_only)
+            return read_uword();
+        return w.fetch_or(mask, std::memory_order_acq_rel);
+    }
+
+    uword clear_bits(const uword mask)
+    {
+        if (read_only)
+            return read_uword();
+        return w.fetch_and(~mask, std::memory_order_acq_rel);
+    }
+
+private:
+    /// Atomic storage for register.
+    std::atomic<uword> w;
+
+    /// Initial value.
+    uword initial_value;
+
+    /// Read-only flag.
+    /// Writes are silently discarded if turned on.
+    bool read_only;
+
+public:
+    template<class Archive>
+    void save(Archive & archive) const
+    {
+        const uword w = this->w.load(std::memory_order_acquire);
+        archive(
+            CEREAL_NVP(w)
+        );
+    }
+
+    template<class Archive>
+    void load(Archive & archive)
+    {
+        uword w;
+        archive(
+            CEREAL_NVP(w)
+        );
+        this->w.store(w, std::memory_order_release);
+    }
+};
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <stdexcept>
+
+#include <cereal/cereal.hpp>
+
+#include "Common/Types/Primitive.hpp"
+
+/// Inline Qword register.
+/// Non-virtual alternative to SizedQwordRegister for hot register files (ie: the R5900 GPR's).
+/// Has the same accessors, but they are constexpr and resolved at compile time, so they
+/// inline into direct loads/stores. An array of these is a plain aligned uqword array,
+/// which the recompilers address directly (see get_storage()).
+/// There is no read-only flag - hardwired registers need to be handled by the owner.
+class alignas(16) InlineQwordRegister
+{
+public:
+    constexpr InlineQwordRegister(const uqword initial_value = uqword()) :
+        q(initial_value)
+    {
+    }
+
+    /// Read/write functions to access the register.
+    constexpr ubyte read_ubyte(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_BYTES_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        return q.ub[offset];
+    }
+
+    constexpr void write_ubyte(const size_t offset, const ubyte value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_BYTES_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        q.ub[offset] = value;
+    }
+
+    constexpr uhword read_uhword(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_HWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        return q.uh[offset];
+    }
+
+    constexpr void write_uhword(const size_t offset, const uhword value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_HWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        q.uh[offset] = value;
+    }
+
+    constexpr uword read_uword(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_WORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        return q.uw[offset];
+    }
+
+    constexpr void write_uword(const size_t offset, const uword value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_WORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        q.uw[offset] = value;
+    }
+
+    constexpr udword read_udword(const size_t offset) const
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_DWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        return q.ud[offset];
+    }
+
+    constexpr void write_udword(const size_t offset, const udword value)
+    {
+#if defined(BUILD_DEBUG)
+        if (offset >= NUMBER_DWORDS_IN_QWORD)
+            throw std::runtime_error("Tried to access InlineQwordRegister with an invalid offset.");
+#endif
+
+        q.ud[offset] = value;
+    }
+
+    constexpr uqword read_uqword() const
+    {
+        return q;
+    }
+
+    constexpr void write_uqword(const uqword value)
+    {
+        q = value;
+    }
+
+    /// Returns a pointer to the underlying storage, used by the recompilers for direct access.
+    constexpr uqword* get_storage()
+    {
+        return &q;
+    }
+
+private:
+    /// Primitive (sized) storage for register.
+    uqword q;
+
+public:
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(
+            CEREAL_NVP(q)
+        );
+    }
+};
+
+static_assert(sizeof(InlineQwordRegister) == sizeof(uqword), "InlineQwordRegister must have the same layout as uqword.");
@@ -120,6 +120,13 @@ public:
             q = value;
     }
 
+    /// Returns a pointer to the underlying storage, used by the recompilers for direct access.
+    /// Writes made through this pointer bypass the read-only flag.
+    uqword* get_storage()
+    {
+        return &q;
+    }
+
 private:
     /// Primitive (sized) storage for register.
     union {
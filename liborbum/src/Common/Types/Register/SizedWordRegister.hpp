@@ -78,6 +78,13 @@ public:
             w = value;
     }
 
+    /// Returns a pointer to the underlying storage, used by the recompilers for direct access.
+    /// Writes made through this pointer bypass the read-only flag and any write_uword() override.
+    uword* get_storage()
+    {
+        return &w;
+    }
+
 private:
     /// Primitive (sized) storage for register.
     union {
@@ -34,12 +34,13 @@ public:
     }
 
     /// Bitfield extraction/insertion.
+    /// Insertion is virtual, as a read-modify-write is not atomic (see AtomicWordRegister).
     uword extract_field(const Bitfield field)
     {
         return field.extract_from(read_uword());
     }
 
-    void insert_field(const Bitfield field, const uword value)
+    virtual void insert_field(const Bitfield field, const uword value)
     {
         write_uword(field.insert_into(read_uword(), value));
     }
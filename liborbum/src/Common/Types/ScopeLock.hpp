@@ -1,7 +1,11 @@
 #pragma once
 
+#include <cstdint>
 #include <mutex>
 
+#include "Common/Types/PerfCounters.hpp"
+#include "Common/Types/TraceRecorder.hpp"
+
 /// Provides a scope lock mechanism for synchronous resources.
 /// Intended to be locked for the entire duration for a read-modify-write cycle
 /// of the owning controller, while also being used by another controller
@@ -10,12 +14,22 @@ class ScopeLock
 {
 public:
     /// Locks the mutex and returns a guard.
+    /// Waits for a contended lock are recorded when tracing (see TraceRecorder).
     std::unique_lock<std::recursive_mutex> scope_lock()
     {
-        return std::unique_lock<std::recursive_mutex>(mutex);
+        std::unique_lock<std::recursive_mutex> lock(mutex, std::try_to_lock);
+        if (!lock.owns_lock())
+        {
+            const std::uint64_t t1 = TraceRecorder::begin();
+            lock.lock();
+            if (t1)
+                TraceRecorder::record("ScopeLock wait", "lock", t1, PerfCounters::read_cycles());
+        }
+
+        return lock;
     }
 
 private:
     /// Recursive mutex.
     std::recursive_mutex mutex;
-};
\ No newline at end of file
+};
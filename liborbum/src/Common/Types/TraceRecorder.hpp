@@ -0,0 +1,209 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Common/Types/PerfCounters.hpp"
+
+/// Records timeline events (Core runs, controller events, lock waits, DMA bursts) for viewing in
+/// chrome://tracing or Perfetto, see write().
+/// Each thread records into its own ring buffer, so recording is lock-free (the buffer is only
+/// registered under a lock on the first event of each thread). Once a ring is full the oldest
+/// events are overwritten, keeping the most recent ones.
+/// Each Core owns its recorder, and events are only recorded on threads running the work of a core
+/// which has one (see TraceRecorderScope), otherwise recording is a single load and branch.
+class TraceRecorder
+{
+public:
+    /// Number of events kept per thread, must be a power of 2.
+    static constexpr size_t EVENTS_PER_THREAD = 1 << 18;
+
+    /// A complete (begin and end) event. Names are static strings, only the pointers are stored.
+    /// The argument is optional (arg_name == nullptr if not used).
+    struct Event
+    {
+        const char* name;
+        const char* category;
+        std::uint64_t begin_cycles;
+        std::uint64_t end_cycles;
+        const char* arg_name;
+        double arg;
+    };
+
+    TraceRecorder() :
+        id(next_id++),
+        start_cycles(PerfCounters::read_cycles())
+    {
+    }
+
+    /// The recorder of the core whose work is running on this thread, or nullptr if it is not tracing.
+    /// Set with TraceRecorderScope, so cores in the same process never record into each other's recorder.
+    PERF_TLS_MODEL static inline thread_local TraceRecorder* current = nullptr;
+
+    /// Returns the begin timestamp for an event, or 0 if not recording (in which case the event is dropped).
+    static std::uint64_t begin()
+    {
+        return current ? PerfCounters::read_cycles() : 0;
+    }
+
+    /// Records an event on the current thread's ring, timestamps are from PerfCounters::read_cycles().
+    static void record(const char* name, const char* category, const std::uint64_t begin_cycles, const std::uint64_t end_cycles,
+                       const char* arg_name = nullptr, const double arg = 0.0)
+    {
+        TraceRecorder* recorder = current;
+        if (!recorder || !begin_cycles)
+            return;
+
+        ThreadBuffer* buffer = (thread_state.recorder_id == recorder->id) ? thread_state.buffer : recorder->register_thread();
+        const size_t index = buffer->written.load(std::memory_order_relaxed);
+        buffer->events[index & (EVENTS_PER_THREAD - 1)] = {name, category, begin_cycles, end_cycles, arg_name, arg};
+        buffer->written.store(index + 1, std::memory_order_release);
+    }
+
+    /// Writes the recorded events as Chrome trace event format JSON, with each thread on its own track.
+    /// Only valid while no events are being recorded (ie: between Core runs).
+    void write(const std::string& path, const double cycles_per_us) const
+    {
+        std::ofstream fout(path);
+        if (!fout)
+            throw std::runtime_error("Unable to write file");
+
+        auto to_us = [this, cycles_per_us](const std::uint64_t cycles) {
+            return (cycles > start_cycles) ? (cycles - start_cycles) / cycles_per_us : 0.0;
+        };
+
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        fout << std::fixed << std::setprecision(3);
+        fout << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+        fout << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"Orbum\"}}";
+        for (size_t tid = 0; tid < buffers.size(); tid++)
+        {
+            const ThreadBuffer& buffer = *buffers[tid];
+            fout << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid
+                 << ",\"args\":{\"name\":\"Thread " << tid << "\"}}";
+
+            const size_t written = buffer.written.load(std::memory_order_acquire);
+            const size_t first = (written > EVENTS_PER_THREAD) ? (written - EVENTS_PER_THREAD) : 0;
+            for (size_t i = first; i < written; i++)
+            {
+                const Event& event = buffer.events[i & (EVENTS_PER_THREAD - 1)];
+                fout << ",\n{\"name\":\"" << event.name << "\",\"cat\":\"" << event.category
+                     << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << tid
+                     << ",\"ts\":" << to_us(event.begin_cycles)
+                     << ",\"dur\":" << (event.end_cycles - event.begin_cycles) / cycles_per_us;
+                if (event.arg_name)
+                    fout << ",\"args\":{\"" << event.arg_name << "\":" << event.arg << "}";
+                fout << "}";
+            }
+        }
+        fout << "\n]}\n";
+
+        if (!fout)
+            throw std::runtime_error("Unable to write file");
+    }
+
+private:
+    /// Ring of events for a thread, written only by that thread.
+    struct ThreadBuffer
+    {
+        ThreadBuffer() :
+            events(EVENTS_PER_THREAD),
+            written(0)
+        {
+        }
+
+        std::thread::id thread_id;
+        std::vector<Event> events;
+        std::atomic<size_t> written;
+    };
+
+    /// The buffer of this thread, valid if registered with the recorder with the id given.
+    /// The recorder id (instead of a pointer) is used so a buffer of a destroyed recorder is never used.
+    struct ThreadState
+    {
+        std::uint64_t recorder_id;
+        ThreadBuffer* buffer;
+    };
+
+    /// Returns the buffer for the current thread, creating it on its first event.
+    /// A thread may record for several recorders in turn (ie: one thread running multiple cores), so keeps its buffer.
+    ThreadBuffer* register_thread()
+    {
+        std::lock_guard<std::mutex> lock(buffers_mutex);
+        const std::thread::id thread_id = std::this_thread::get_id();
+        auto it = std::find_if(buffers.begin(), buffers.end(), [thread_id](const auto& buffer) { return buffer->thread_id == thread_id; });
+        if (it == buffers.end())
+        {
+            buffers.push_back(std::make_unique<ThreadBuffer>());
+            buffers.back()->thread_id = thread_id;
+            it = buffers.end() - 1;
+        }
+
+        thread_state = {id, it->get()};
+        return thread_state.buffer;
+    }
+
+    /// Recorder id, unique for the process (0 is never used).
+    const std::uint64_t id;
+
+    /// Timestamp all events are relative to.
+    const std::uint64_t start_cycles;
+
+    mutable std::mutex buffers_mutex;
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    static inline std::atomic<std::uint64_t> next_id{1};
+    PERF_TLS_MODEL static inline thread_local ThreadState thread_state = {0, nullptr};
+};
+
+/// Sets the current recorder for this thread within a scope, restoring the previous one after.
+class TraceRecorderScope
+{
+public:
+    TraceRecorderScope(TraceRecorder* recorder) :
+        previous(TraceRecorder::current)
+    {
+        TraceRecorder::current = recorder;
+    }
+
+    ~TraceRecorderScope()
+    {
+        TraceRecorder::current = previous;
+    }
+
+private:
+    TraceRecorder* previous;
+};
+
+/// Records an event covering a scope, if a recorder is active when the scope is entered.
+class TraceScope
+{
+public:
+    TraceScope(const char* name, const char* category) :
+        name(name),
+        category(category),
+        begin_cycles(TraceRecorder::begin())
+    {
+    }
+
+    ~TraceScope()
+    {
+        if (begin_cycles)
+            TraceRecorder::record(name, category, begin_cycles, PerfCounters::read_cycles());
+    }
+
+private:
+    const char* name;
+    const char* category;
+    std::uint64_t begin_cycles;
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "Common/Types/Mips/MmuAccess.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// Direct-mapped software TLB, used to speed up virtual address translation.
+/// Holds one entry per 4KB virtual page (the minimum TLB page size) for each translation
+/// context, so a lookup is a single table access. Results are only cached on success,
+/// and are kept separately for read and write accesses (a write can fail due to a
+/// clean page where a read succeeds).
+/// The translation contexts are defined by the user (ie: one per operating context),
+/// so switching between them does not need a flush. Entries are instead invalidated
+/// by virtual address range when the underlying mapping changes.
+template <size_t NumberContexts>
+class SoftwareTlb
+{
+public:
+    using FallbackFn = std::function<std::optional<uptr>(const uptr, const MmuRwAccess)>;
+
+    static constexpr size_t PAGE_SHIFT = 12;
+    static constexpr uptr PAGE_MASK = 0xFFF;
+    static constexpr size_t NUMBER_PAGES = static_cast<size_t>(1) << (32 - PAGE_SHIFT);
+
+    SoftwareTlb() :
+        entries(NumberContexts * NUMBER_PAGES, 0),
+        fallback_fn(nullptr)
+    {
+    }
+
+    /// Performs the virtual address to physical address translation within the context.
+    std::optional<uptr> lookup(const size_t context, const uptr virtual_address, const MmuRwAccess rw_access)
+    {
+        uword& entry = entries[context * NUMBER_PAGES + (virtual_address >> PAGE_SHIFT)];
+        const uword flag = (rw_access == READ) ? FLAG_READ : FLAG_WRITE;
+
+        if (entry & flag)
+            return std::make_optional((entry & ~PAGE_MASK) | (virtual_address & PAGE_MASK));
+
+        return handle_fallback(entry, virtual_address, rw_access);
+    }
+
+    /// Invalidates all entries within the virtual address range [lower, upper], for all contexts.
+    void invalidate(const uptr lower_address, const uptr upper_address)
+    {
+        const size_t lower_page = lower_address >> PAGE_SHIFT;
+        const size_t upper_page = upper_address >> PAGE_SHIFT;
+        for (size_t context = 0; context < NumberContexts; context++)
+        {
+            for (size_t page = lower_page; page <= upper_page; page++)
+                entries[context * NUMBER_PAGES + page] = 0;
+        }
+    }
+
+    /// Invalidates all entries.
+    void flush()
+    {
+        std::fill(entries.begin(), entries.end(), 0);
+    }
+
+    /// Sets the translation fallback function.
+    void set_fallback_lookup(const FallbackFn& fallback_fn)
+    {
+        this->fallback_fn = fallback_fn;
+    }
+
+private:
+    /// Entry format: physical page address in the upper bits, and the access flags in the lower (page offset) bits.
+    /// A successful write translation implies a read will succeed too.
+    static constexpr uword FLAG_READ = 1 << 0;
+    static constexpr uword FLAG_WRITE = 1 << 1;
+
+    /// Performs a fallback lookup and fills in the entry if its found.
+    /// Returns the fallback result.
+    std::optional<uptr> handle_fallback(uword& entry, const uptr virtual_address, const MmuRwAccess rw_access)
+    {
+        if (!fallback_fn)
+            throw std::runtime_error("No fallback address translation function defined");
+
+        std::optional<uptr> result = fallback_fn(virtual_address, rw_access);
+        if (result)
+        {
+            const uword page = *result & ~PAGE_MASK;
+            const uword flags = (rw_access == READ) ? FLAG_READ : (FLAG_READ | FLAG_WRITE);
+            const uword existing_flags = ((entry & ~PAGE_MASK) == page) ? (entry & PAGE_MASK) : 0;
+            entry = page | flags | existing_flags;
+        }
+
+        return result;
+    }
+
+    std::vector<uword> entries;
+    FallbackFn fallback_fn;
+};
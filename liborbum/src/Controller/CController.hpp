@@ -4,7 +4,10 @@
 #include <atomic>
 #endif
 
+#include "Common/Types/PerfCounters.hpp"
+#include "Common/Types/TraceRecorder.hpp"
 #include "Controller/ControllerEvent.hpp"
+#include "Controller/ControllerType.hpp"
 
 class Core;
 
@@ -14,7 +17,8 @@ class CController
 {
 public:
     CController(Core* core) :
-        core(core)
+        core(core),
+        stats()
     {
     }
 
@@ -24,12 +28,43 @@ public:
 
     virtual void handle_event(const ControllerEvent& e) = 0;
 
-    void handle_event_marshall_(const ControllerEvent& e)
+    /// Returns if the controller has no work to do on time events, in which case they are not sent.
+    /// Other events are still sent.
+    virtual bool is_idle() const
     {
-        // Used for inserting pre/post-event hooks (debugging).
+        return false;
+    }
+
+    /// Called after the emulator state has been replaced (ie: a save state is loaded), while no events are running.
+    /// Controllers caching state derived from the resources need to drop it here.
+    virtual void handle_state_loaded()
+    {
+    }
+
+    /// Profiling counters, see PerfCounters.
+    const PerfCounters& get_stats() const
+    {
+        return stats;
+    }
+
+    /// The controller type given is only used to name the trace event (see TraceRecorder).
+    void handle_event_marshall_(const ControllerType::Type t, const ControllerEvent& e)
+    {
+        // Used for inserting pre/post-event hooks (debugging, statistics).
+        PerfScope scope(&stats);
+        const std::uint64_t t1 = PerfCounters::read_cycles();
         handle_event(e);
+        const std::uint64_t t2 = PerfCounters::read_cycles();
+        stats.host_cycles += t2 - t1;
+        stats.events++;
+        if (e.type == ControllerEvent::Type::Time)
+            TraceRecorder::record(ControllerType::TYPE_STRINGS[static_cast<size_t>(t)], "controller", t1, t2, "time_us", e.data.time_us);
+        else
+            TraceRecorder::record(ControllerType::TYPE_STRINGS[static_cast<size_t>(t)], "controller", t1, t2, "blanks", e.data.amount);
     }
 
 protected:
     Core* core;
+
+    PerfCounters stats;
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cereal/cereal.hpp>
+
 /// Describes a controller event (variant).
 /// These events are from an external perspective of the controller.
 struct ControllerEvent
@@ -17,4 +19,14 @@ struct ControllerEvent
         double time_us; // Time event: time passed in microseconds.
         int amount;     // HBlank, VBlank: amount of times it occurred.
     } data;
+
+    template<class Archive>
+    void serialize(Archive & archive)
+    {
+        archive(CEREAL_NVP(type));
+        if (type == Type::Time)
+            archive(CEREAL_NVP(data.time_us));
+        else
+            archive(CEREAL_NVP(data.amount));
+    }
 };
\ No newline at end of file
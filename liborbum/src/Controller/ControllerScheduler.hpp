@@ -0,0 +1,116 @@
+#pragma once
+
+#include <queue>
+#include <vector>
+
+#include <cereal/cereal.hpp>
+#include <cereal/types/vector.hpp>
+
+#include "Controller/ControllerEvent.hpp"
+#include "Controller/ControllerType.hpp"
+
+/// Timestamped priority queue of pending controller events (ie: HBlank).
+/// Used by the core to deliver events at the correct emulated time, and to
+/// end each run at the next scheduled event instead of a fixed time slice.
+/// Not thread safe - only used from the core thread.
+class ControllerScheduler
+{
+public:
+    struct Entry
+    {
+        double time_us; // Absolute emulated time the event is due at.
+        ControllerType::Type t;
+        ControllerEvent e;
+
+        template<class Archive>
+        void serialize(Archive & archive)
+        {
+            archive(
+                CEREAL_NVP(time_us),
+                CEREAL_NVP(t),
+                CEREAL_NVP(e)
+            );
+        }
+    };
+
+    ControllerScheduler() :
+        sequence(0)
+    {
+    }
+
+    /// Adds an event to be delivered at its time.
+    void schedule(const Entry& entry)
+    {
+        queue.push({entry, sequence++});
+    }
+
+    bool is_empty() const
+    {
+        return queue.empty();
+    }
+
+    /// Returns the time of the earliest pending event. Only valid if not empty.
+    double next_time_us() const
+    {
+        return queue.top().entry.time_us;
+    }
+
+    /// Pops the earliest pending event if it is due by the time given.
+    /// Events due at the same time are popped in the order they were scheduled.
+    bool pop_due(const double time_us, Entry& entry)
+    {
+        if (queue.empty() || queue.top().entry.time_us > time_us)
+            return false;
+
+        entry = queue.top().entry;
+        queue.pop();
+        return true;
+    }
+
+private:
+    struct QueuedEntry
+    {
+        Entry entry;
+        size_t sequence;
+    };
+
+    struct Later
+    {
+        bool operator()(const QueuedEntry& lhs, const QueuedEntry& rhs) const
+        {
+            if (lhs.entry.time_us != rhs.entry.time_us)
+                return lhs.entry.time_us > rhs.entry.time_us;
+            return lhs.sequence > rhs.sequence;
+        }
+    };
+
+    std::priority_queue<QueuedEntry, std::vector<QueuedEntry>, Later> queue;
+    size_t sequence;
+
+public:
+    /// Pending events are serialized in delivery order, which is kept when they are rescheduled on load.
+    template<class Archive>
+    void save(Archive & archive) const
+    {
+        std::vector<Entry> entries;
+        auto pending = queue;
+        while (!pending.empty())
+        {
+            entries.push_back(pending.top().entry);
+            pending.pop();
+        }
+
+        archive(CEREAL_NVP(entries));
+    }
+
+    template<class Archive>
+    void load(Archive & archive)
+    {
+        std::vector<Entry> entries;
+        archive(CEREAL_NVP(entries));
+
+        queue = decltype(queue)();
+        for (auto& entry : entries)
+            schedule(entry);
+    }
+};
@@ -2,8 +2,7 @@
 
 #include <boost/format.hpp>
 
-#include <Console.hpp>
-
+#include "Common/Types/Mips/MipsSegments.hpp"
 #include "Controller/Ee/Core/CEeCore.hpp"
 
 #include "Core.hpp"
@@ -17,14 +16,14 @@ std::atomic_bool DEBUG_IN_CONTROLLER_EECORE = false;
 #endif
 
 CEeCore::CEeCore(Core* core) :
-    CController(core)
+    CController(core),
+    interrupt_check_requested(false)
 {
     auto translation_fallback = [this](const uptr virtual_address, const MmuRwAccess rw_access) {
         return translate_address_fallback(virtual_address, rw_access);
     };
 
-    translation_cache_data.set_fallback_lookup(translation_fallback);
-    translation_cache_inst.set_fallback_lookup(translation_fallback);
+    translation_tlb.set_fallback_lookup(translation_fallback);
 }
 
 CEeCore::~CEeCore()
@@ -43,21 +42,17 @@ void CEeCore::handle_event(const ControllerEvent& event)
     if (DEBUG_IN_CONTROLLER_EECORE)
         throw std::runtime_error("EeCore controller is already running!");
     DEBUG_IN_CONTROLLER_EECORE = true;
-    static size_t DEBUG_COUNTER = 0;
-#endif
-
-#if defined(BUILD_DEBUG)
-    static std::chrono::high_resolution_clock::time_point DEBUG_OVERHEAD = std::chrono::high_resolution_clock::now();
-    const std::chrono::high_resolution_clock::time_point DEBUG_T1 = std::chrono::high_resolution_clock::now();
 #endif
 
     switch (event.type)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -67,34 +62,15 @@ void CEeCore::handle_event(const ControllerEvent& event)
     }
 
 #if defined(BUILD_DEBUG)
-    const std::chrono::high_resolution_clock::time_point DEBUG_T2 = std::chrono::high_resolution_clock::now();
-
-    const std::chrono::duration<double, std::micro> run_duration = DEBUG_T2 - DEBUG_T1;
-    const std::chrono::duration<double, std::micro> overhead_duration = DEBUG_T1 - DEBUG_OVERHEAD;
-    const std::chrono::duration<double, std::micro> total_duration = run_duration + overhead_duration;
-
-    DEBUG_OVERHEAD = std::chrono::high_resolution_clock::now();
-
-    const std::string info = str(boost::format("EE Core benchmark; total: %.3f us, run: %.3f us (%.1f%%), overhead: %.3f us (%.1f%%)")
-                                 % total_duration.count()
-                                 % run_duration.count()
-                                 % ((run_duration / total_duration) * 100.0)
-                                 % overhead_duration.count()
-                                 % ((overhead_duration / total_duration) * 100.0));
-
-    //BOOST_LOG(core->get_logger()) << info;
-
-    if (DEBUG_COUNTER % 100 == 0)
-        print_title(info);
-
-#endif
-
-#if defined(BUILD_DEBUG)
-    DEBUG_COUNTER++;
     DEBUG_IN_CONTROLLER_EECORE = false;
 #endif
 }
 
+void CEeCore::handle_state_loaded()
+{
+    translation_tlb.flush();
+}
+
 int CEeCore::time_to_ticks(const double time_us)
 {
     int ticks = static_cast<int>(time_us / 1.0e6 * Constants::EE::EECore::EECORE_CLK_SPEED * core->get_options().system_bias_eecore);
@@ -425,10 +401,6 @@ void CEeCore::handle_exception(const EeCoreException exception)
     //       Reset and NMI's are handled above, no need to check for them here.
     if (exception != EeCoreException::EX_INTERRUPT)
         pc.offset(-static_cast<sword>(Constants::MIPS::SIZE_MIPS_INSTRUCTION));
-
-    // Flush translation caches (context change).
-    translation_cache_data.flush();
-    translation_cache_inst.flush();
 }
 
 std::optional<uptr> CEeCore::translate_address_data(const uptr virtual_address, const MmuRwAccess rw_access)
@@ -455,7 +427,16 @@ std::optional<uptr> CEeCore::translate_address_data(const uptr virtual_address,
 	}
 #endif
 
-    return translation_cache_data.lookup(virtual_address, rw_access);
+    // Unmapped kernel segments (kseg0/kseg1) are a fixed offset, no need to use the TLB.
+    auto& cop0 = core->get_resources().ee.core.cop0;
+    if (cop0.operating_context() == MipsCoprocessor0::OperatingContext::Kernel)
+    {
+        const auto& segment = MipsSegments::kernel_segment(virtual_address);
+        if (segment.is_unmapped())
+            return std::make_optional(virtual_address - segment.unmapped_base);
+    }
+
+    return translation_tlb.lookup(translation_context(), virtual_address, rw_access);
 }
 
 std::optional<uptr> CEeCore::translate_address_inst(const uptr virtual_address)
@@ -481,7 +462,58 @@ std::optional<uptr> CEeCore::translate_address_inst(const uptr virtual_address)
     }
 #endif
 
-    return translation_cache_inst.lookup(virtual_address, READ);
+    // Unmapped kernel segments (kseg0/kseg1) are a fixed offset, no need to use the TLB.
+    auto& cop0 = core->get_resources().ee.core.cop0;
+    if (cop0.operating_context() == MipsCoprocessor0::OperatingContext::Kernel)
+    {
+        const auto& segment = MipsSegments::kernel_segment(virtual_address);
+        if (segment.is_unmapped())
+            return std::make_optional(virtual_address - segment.unmapped_base);
+    }
+
+    return translation_tlb.lookup(translation_context(), virtual_address, READ);
+}
+
+void CEeCore::handle_translation_tlb_entry_update(const EeCoreTlbEntry& tlb_entry)
+{
+    // Invalidate the even/odd page pair covered by the entry (see EeCoreTlb::is_match()).
+    // The scratchpad entry covers 16KB of continuous space instead.
+    const uptr base_address = (tlb_entry.vpn2 << 13) & tlb_entry.mask.tlb_mask;
+    translation_tlb.invalidate(base_address, base_address + (~tlb_entry.mask.tlb_mask));
+
+    if (tlb_entry.s)
+    {
+        const uptr spr_base_address = (tlb_entry.vpn2 >> 1) << 14;
+        translation_tlb.invalidate(spr_base_address, spr_base_address + Constants::MASK_16KB);
+    }
+}
+
+void CEeCore::handle_translation_asid_update(const uword old_asid)
+{
+    auto& r = core->get_resources();
+    auto& tlb = r.ee.core.tlb;
+
+    if (r.ee.core.cop0.entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID) == old_asid)
+        return;
+
+    for (int i = 0; i < Constants::EE::EECore::MMU::NUMBER_TLB_ENTRIES; i++)
+    {
+        const auto& tlb_entry = tlb.tlb_entry_at(i);
+        if (!tlb_entry.g)
+            handle_translation_tlb_entry_update(tlb_entry);
+    }
+}
+
+size_t CEeCore::translation_context()
+{
+    auto& r = core->get_resources();
+    auto& cop0 = r.ee.core.cop0;
+
+    const auto context = cop0.operating_context();
+    if (context == MipsCoprocessor0::OperatingContext::Kernel && cop0.status.extract_field(EeCoreCop0Register_Status::ERL))
+        return NUMBER_TRANSLATION_CONTEXTS - 1;
+
+    return static_cast<size_t>(context);
 }
 
 std::optional<uptr> CEeCore::translate_address_fallback(const uptr virtual_address, const MmuRwAccess rw_access)
@@ -6,9 +6,10 @@
 
 #include "Common/Types/Mips/MmuAccess.hpp"
 #include "Common/Types/Primitive.hpp"
-#include "Common/Types/TranslationCache/TranslationCache.hpp"
+#include "Common/Types/TranslationCache/SoftwareTlb.hpp"
 #include "Controller/CController.hpp"
 #include "Resources/Ee/Core/EeCoreException.hpp"
+#include "Resources/Ee/Core/EeCoreTlbEntry.hpp"
 
 class Core;
 
@@ -21,6 +22,9 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
+    /// Flushes the address translation caches.
+    void handle_state_loaded() override;
+
 protected:
 #if defined(BUILD_DEBUG)
     /// Debug loop counter.
@@ -30,9 +34,16 @@ protected:
     size_t DEBUG_HANDLED_EXCEPTION_COUNT = 0;
 #endif
 
-    /// Steps through the EE Core state, executing instructions.
+    /// Steps through the EE Core state, executing a batch of instructions.
+    /// Returns the number of cycles used, which may exceed ticks_available by the last instruction run.
     virtual int time_step(const int ticks_available) = 0;
 
+    /// Set by instructions which may unmask a pending interrupt (eg: writing to COP0.Status),
+    /// which ends the current batch of instructions early so interrupts are checked.
+    /// Writes to the INTC registers do the same through their write latches (see EeIntcRegister_Stat).
+    /// Otherwise interrupts are only checked at the start of each batch.
+    bool interrupt_check_requested;
+
     /// Handles a given exception by running the general exception handler (level 1 or 2) based on the exception properties defined.
     void handle_exception(const EeCoreException exception);
 
@@ -62,14 +73,23 @@ protected:
     /// Performs a cached translation lookup from the given virtual address
     /// and access type, and returns the physical address. If the address is not
     /// found within the cache the full lookup process will be invoked.
-    /// If the EE Core's TLB is modified, the whole cache is flushed.
     std::optional<uptr> translate_address_data(const uptr virtual_address, const MmuRwAccess rw_access);
     std::optional<uptr> translate_address_inst(const uptr virtual_address);
 
-    /// Address translation cache, see translate_address().
-    /// Note: caches will be flushed when the operating context changes or EE TLB is modified (visibility).
-    TranslationCache<6, uptr, 0xFFF, TimestampLruCache> translation_cache_data;
-    TranslationCache<6, uptr, 0xFFF, TimestampLruCache> translation_cache_inst;
+    /// Invalidates the cached translations covered by the TLB entry.
+    /// Needs to be called for both the old and new entries when the EE Core's TLB is modified.
+    void handle_translation_tlb_entry_update(const EeCoreTlbEntry& tlb_entry);
+
+    /// Checks if the COP0.EntryHi ASID has changed from the old value given, and invalidates
+    /// the cached translations of all non-global TLB entries if so.
+    /// Needs to be called after COP0.EntryHi is written to.
+    void handle_translation_asid_update(const uword old_asid);
+
+    /// Address translation cache (software TLB), see translate_address().
+    /// Translations are kept separately for each operating context, plus kernel mode with Status.ERL
+    /// set (where kuseg is unmapped), so they remain valid across exceptions and ERET.
+    static constexpr size_t NUMBER_TRANSLATION_CONTEXTS = 4;
+    SoftwareTlb<NUMBER_TRANSLATION_CONTEXTS> translation_tlb;
 
 private:
     /// Converts a time duration into the number of ticks that would have occurred.
@@ -82,4 +102,7 @@ private:
     /// Stage 3 tests the valid and dirty flags, and determines if the VPN is for the even or odd PFN.
     /// Stage 4 calculates the final physical address.
     std::optional<uptr> translate_address_fallback(const uptr virtual_address, const MmuRwAccess rw_access);
+
+    /// Returns the software TLB context for the current operating context.
+    size_t translation_context();
 };
\ No newline at end of file
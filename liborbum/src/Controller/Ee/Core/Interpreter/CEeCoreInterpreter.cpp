@@ -1,3 +1,6 @@
+#include <optional>
+#include <typeinfo>
+
 #include <boost/format.hpp>
 
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
@@ -8,23 +11,35 @@
 
 CEeCoreInterpreter::CEeCoreInterpreter(Core* core) :
     CEeCore(core),
-    c_vu_interpreter(core)
+    c_vu_interpreter(core),
+    current_block(nullptr)
 {
 }
 
 int CEeCoreInterpreter::time_step(const int ticks_available)
 {
     auto& r = core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+    auto& bdelay = r.ee.core.r5900.bdelay;
 
     // Check if any external interrupts are pending and immediately handle exception if there is one.
-    if (ticks_available % 16 == 0)
-        handle_interrupt_check();
+    // This is only done at the start of each batch of instructions (see below).
+    handle_interrupt_check();
+    interrupt_check_requested = false;
+    r.ee.intc.stat.write_latch = false;
+    r.ee.intc.mask.write_latch = false;
 
-    // Set the instruction holder to the instruction at the current PC, and get instruction details.
-    const uptr pc_address = r.ee.core.r5900.pc.read_uword();
-    uptr physical_address = translate_address_inst(pc_address).value();
-    uword raw_inst = r.ee.bus.read_uword(BusContext::Ee, physical_address);
-    EeCoreInstruction inst = EeCoreInstruction(raw_inst);
+    // Run instructions until the cycles are used up or a block boundary is reached.
+    int cycles = 0;
+    int executed = 0;
+    while (cycles < ticks_available)
+    {
+        // Get the decoded instruction at the current PC.
+        const uptr pc_address = pc.read_uword();
+        const bool in_branch_delay_slot = bdelay.is_branch_pending();
+        uptr physical_address = translate_address_inst(pc_address).value();
+        DecodedInstruction decoded = fetch_decoded_instruction(physical_address);
+        EeCoreInstruction& inst = decoded.inst;
 
 #if 0 //defined(BUILD_DEBUG)
 	static size_t DEBUG_LOOP_BREAKPOINT = 0x1000000143DE40;
@@ -52,25 +67,126 @@ int CEeCoreInterpreter::time_step(const int ticks_available)
 	}
 #endif
 
-    // Run the instruction, which is based on the implementation index.
-    const int impl_index = inst.get_info()->impl_index;
-    (this->*EECORE_INSTRUCTION_TABLE[impl_index])(inst);
+        // Run the instruction.
+        (this->*decoded.impl)(inst);
+        r.ee.core.r5900.reset_zero_gpr();
 
-    // Increment PC.
-    r.ee.core.r5900.bdelay.advance_pc(r.ee.core.r5900.pc);
+        // Increment PC.
+        bdelay.advance_pc(pc);
 
-    // Update the COP0.Count register, and check for interrupt.
-    // See EE Core Users Manual page 70.
-    if (ticks_available % 16 == 0)
-        handle_count_update(inst.get_info()->cpi * 16);
+        cycles += inst.get_info()->cpi;
+        executed++;
 
 #if defined(BUILD_DEBUG)
-    // Debug increment loop counter.
-    DEBUG_LOOP_COUNTER++;
+        // Debug increment loop counter.
+        DEBUG_LOOP_COUNTER++;
 #endif
 
+        // End the batch when leaving sequential execution (branch/jump taken, exception raised),
+        // or when an interrupt may now be pending (COP0 or INTC register written).
+        if (in_branch_delay_slot
+            || pc.read_uword() != (pc_address + Constants::MIPS::SIZE_MIPS_INSTRUCTION)
+            || interrupt_check_requested
+            || r.ee.intc.stat.write_latch
+            || r.ee.intc.mask.write_latch)
+            break;
+    }
+
+    // Update the COP0.Count register, and check for interrupt.
+    // See EE Core Users Manual page 70.
+    handle_count_update(cycles);
+    stats.instructions += executed;
+
     // Return the number of cycles completed.
-    return 3; // TODO: fix CPI's. inst.get_info()->cpi;
+    return cycles;
+}
+
+CEeCoreInterpreter::DecodedInstruction CEeCoreInterpreter::fetch_decoded_instruction(const uptr physical_address)
+{
+    // Fast path: continuing through the current block (sequential execution or a short branch within it).
+    DecodedBlockCache::Block* block = current_block;
+    if (block && physical_address >= block->physical_address)
+    {
+        const size_t index = (physical_address - block->physical_address) / Constants::MIPS::SIZE_MIPS_INSTRUCTION;
+        if (index < block->entries.size() && block->is_valid())
+            return block->entries[index];
+    }
+
+    // Slow path: find or (re)build the block starting here.
+    block = block_cache.find(physical_address);
+    if (!block || !block->is_valid())
+        block = build_block(physical_address);
+
+    current_block = block;
+
+    if (!block)
+    {
+        // Not cacheable (not plain memory) - decode directly from the bus.
+        auto& r = core->get_resources();
+        return decode_instruction(r.ee.bus.read_uword(BusContext::Ee, physical_address));
+    }
+
+    return block->entries[0];
+}
+
+CEeCoreInterpreter::DecodedBlockCache::Block* CEeCoreInterpreter::build_block(const uptr physical_address)
+{
+    auto& r = core->get_resources();
+
+    // Only plain memory is cacheable: subclasses of ArrayByteMemory (eg: SIO)
+    // are registers with side effects, and cannot be read ahead or tracked.
+    const auto& page = r.ee.bus.get_page(physical_address);
+    if (typeid(*page.object) != typeid(ArrayByteMemory))
+        return nullptr;
+
+    auto memory = static_cast<ArrayByteMemory*>(page.object);
+    const size_t offset = physical_address - page.base_address;
+    const size_t page_end = (offset & ~(ArrayByteMemory::PAGE_SIZE - 1)) + ArrayByteMemory::PAGE_SIZE;
+
+    DecodedBlockCache::Block block{physical_address, memory, offset, memory->page_generation(offset), {}};
+
+    bool end_after_next = false;
+    for (size_t inst_offset = offset; inst_offset < page_end; inst_offset += Constants::MIPS::SIZE_MIPS_INSTRUCTION)
+    {
+        // Decoding ahead may reach data that is not a valid instruction. Only
+        // propagate the error if it is the first instruction (ie: about to be run),
+        // otherwise end the block early and let it get handled if it is reached.
+        std::optional<DecodedInstruction> decoded;
+        try
+        {
+            decoded.emplace(decode_instruction(memory->read_uword(inst_offset)));
+        }
+        catch (const std::runtime_error&)
+        {
+            if (block.entries.empty())
+                throw;
+            break;
+        }
+
+        block.entries.push_back(*decoded);
+
+        if (end_after_next || block.entries.size() >= MAX_BLOCK_INSTRUCTIONS)
+            break;
+
+        // Branches and jumps end the block after their delay slot.
+        // ERET has no delay slot, so it ends the block immediately.
+        const int cpi = decoded->inst.get_info()->cpi;
+        if (cpi == EeCoreInstruction::CPI_R5900_BRANCH
+            || cpi == EeCoreInstruction::CPI_COP_BRANCH_DELAY
+            || cpi == EeCoreInstruction::CPI_COP_BRANCH_DELAY_LIKELY)
+            end_after_next = true;
+        else if (decoded->impl == &CEeCoreInterpreter::ERET)
+            break;
+    }
+
+    return block_cache.insert(std::move(block));
+}
+
+CEeCoreInterpreter::DecodedInstruction CEeCoreInterpreter::decode_instruction(const uword raw_inst)
+{
+    EeCoreInstruction inst = EeCoreInstruction(raw_inst);
+    const int impl_index = inst.get_info()->impl_index;
+    return DecodedInstruction{inst, EECORE_INSTRUCTION_TABLE[impl_index]};
 }
 
 void CEeCoreInterpreter::INSTRUCTION_UNKNOWN(const EeCoreInstruction inst)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Common/Constants.hpp"
+#include "Common/Types/BlockCache/BlockCache.hpp"
 #include "Controller/Ee/Core/CEeCore.hpp"
 #include "Controller/Ee/Vpu/Vu/Interpreter/CVuInterpreter.hpp"
 #include "Resources/Ee/Core/EeCoreInstruction.hpp"
@@ -23,6 +24,39 @@ public:
     /// TODO: Will change in future when VU's are implemented.
     CVuInterpreter c_vu_interpreter;
 
+    /// A pre-decoded instruction, with the lookup already performed and the implementation resolved.
+    struct DecodedInstruction
+    {
+        EeCoreInstruction inst;
+        void (CEeCoreInterpreter::*impl)(const EeCoreInstruction inst);
+    };
+
+    /// Maximum number of instructions decoded into a single block.
+    static constexpr size_t MAX_BLOCK_INSTRUCTIONS = 128;
+
+    using DecodedBlockCache = BlockCache<DecodedInstruction, 0x10000>;
+
+protected:
+    /// Decoded instruction block cache, keyed by physical PC.
+    /// Blocks are only built from plain memory (main memory, scratchpad, ROMs),
+    /// and are rebuilt when the backing memory page is written to.
+    DecodedBlockCache block_cache;
+
+    /// Block that the last instruction was fetched from, used to continue
+    /// through a block without looking it up again.
+    DecodedBlockCache::Block* current_block;
+
+    /// Returns the decoded instruction at the physical address, using the block cache where possible.
+    DecodedInstruction fetch_decoded_instruction(const uptr physical_address);
+
+    /// Decodes a new block starting at the physical address. Returns nullptr if the address is not cacheable.
+    /// A block ends at a branch/jump (including its delay slot), ERET, a page boundary or the maximum length.
+    DecodedBlockCache::Block* build_block(const uptr physical_address);
+
+    /// Decodes a single instruction without caching.
+    DecodedInstruction decode_instruction(const uword raw_inst);
+
+public:
     /// EECore Instruction functions. The instructions are organised according to the EE Overview Manual starting from page 26 (which also means separate cpp files per category).
     /// Note 1: there is no true pipeline concept in PCSX2 - instructions that are meant for pipeline 1 (marked with "1" at the end of the mnemonic) are treated like normal instructions.
     /// Note 2: Dots in mnemonics & function names are represented by the underscore character.
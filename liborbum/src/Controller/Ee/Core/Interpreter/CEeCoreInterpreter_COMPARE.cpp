@@ -2,6 +2,7 @@
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 #include "Utilities/Utilities.hpp"
+#include "Utilities/VectorInteger.hpp"
 
 void CEeCoreInterpreter::SLT(const EeCoreInstruction inst)
 {
@@ -83,13 +84,8 @@ void CEeCoreInterpreter::PCEQB(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        ubyte val_source1 = reg_source1.read_ubyte(i);
-        ubyte val_source2 = reg_source2.read_ubyte(i);
-        ubyte result = (val_source1 == val_source2) ? 0xFF : 0x00;
-        reg_dest.write_ubyte(i, result);
-    }
+    const uqword value = vector_integer_op(VectorIntegerOp::CEQ, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PCEQH(const EeCoreInstruction inst)
@@ -102,13 +98,8 @@ void CEeCoreInterpreter::PCEQH(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        uhword val_source1 = reg_source1.read_uhword(i);
-        uhword val_source2 = reg_source2.read_uhword(i);
-        uhword result = (val_source1 == val_source2) ? 0xFFFF : 0x0000;
-        reg_dest.write_uhword(i, result);
-    }
+    const uqword value = vector_integer_op(VectorIntegerOp::CEQ, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PCEQW(const EeCoreInstruction inst)
@@ -121,13 +112,8 @@ void CEeCoreInterpreter::PCEQW(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        uword val_source1 = reg_source1.read_uword(i);
-        uword val_source2 = reg_source2.read_uword(i);
-        uword result = (val_source1 == val_source2) ? 0xFFFFFFFF : 0x00000000;
-        reg_dest.write_uword(i, result);
-    }
+    const uqword value = vector_integer_op(VectorIntegerOp::CEQ, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PCGTB(const EeCoreInstruction inst)
@@ -140,13 +126,8 @@ void CEeCoreInterpreter::PCGTB(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        ubyte val_source1 = reg_source1.read_ubyte(i);
-        ubyte val_source2 = reg_source2.read_ubyte(i);
-        ubyte result = (val_source1 > val_source2) ? 0xFF : 0x00;
-        reg_dest.write_ubyte(i, result);
-    }
+    const uqword value = vector_integer_op(VectorIntegerOp::CGT, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PCGTH(const EeCoreInstruction inst)
@@ -159,13 +140,8 @@ void CEeCoreInterpreter::PCGTH(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        uhword val_source1 = reg_source1.read_uhword(i);
-        uhword val_source2 = reg_source2.read_uhword(i);
-        uhword result = (val_source1 > val_source2) ? 0xFFFF : 0x0000;
-        reg_dest.write_uhword(i, result);
-    }
+    const uqword value = vector_integer_op(VectorIntegerOp::CGT, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PCGTW(const EeCoreInstruction inst)
@@ -178,13 +154,8 @@ void CEeCoreInterpreter::PCGTW(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        uword val_source1 = reg_source1.read_uword(i);
-        uword val_source2 = reg_source2.read_uword(i);
-        uword result = (val_source1 > val_source2) ? 0xFFFFFFFF : 0x00000000;
-        reg_dest.write_uword(i, result);
-    }
+    const uqword value = vector_integer_op(VectorIntegerOp::CGT, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::C_EQ_S(const EeCoreInstruction inst)
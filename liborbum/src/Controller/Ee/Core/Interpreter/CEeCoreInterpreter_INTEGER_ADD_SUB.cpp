@@ -2,6 +2,7 @@
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 #include "Utilities/Utilities.hpp"
+#include "Utilities/VectorInteger.hpp"
 
 void CEeCoreInterpreter::ADD(const EeCoreInstruction inst)
 {
@@ -224,13 +225,8 @@ void CEeCoreInterpreter::PADDB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        value[i] = reg_source1.read_ubyte(i) + reg_source2.read_ubyte(i);
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::ADD, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDH(const EeCoreInstruction inst)
@@ -242,13 +238,8 @@ void CEeCoreInterpreter::PADDH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) + reg_source2.read_uhword(i);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::ADD, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDSB(const EeCoreInstruction inst)
@@ -260,21 +251,8 @@ void CEeCoreInterpreter::PADDSB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    shword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<shword>(static_cast<sbyte>(reg_source1.read_ubyte(i)))
-                   + static_cast<shword>(static_cast<sbyte>(reg_source2.read_ubyte(i)));
-
-        if (value[i] > VALUE_SBYTE_MAX)
-            value[i] = VALUE_SBYTE_MAX;
-        else if (value[i] < VALUE_SBYTE_MIN)
-            value[i] = VALUE_SBYTE_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<sbyte>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::ADDS, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDSH(const EeCoreInstruction inst)
@@ -286,21 +264,8 @@ void CEeCoreInterpreter::PADDSH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sword>(static_cast<shword>(reg_source1.read_uhword(i)))
-                   + static_cast<sword>(static_cast<shword>(reg_source2.read_uhword(i)));
-
-        if (value[i] > VALUE_SHWORD_MAX)
-            value[i] = VALUE_SHWORD_MAX;
-        else if (value[i] < VALUE_SHWORD_MIN)
-            value[i] = VALUE_SHWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<shword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::ADDS, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDSW(const EeCoreInstruction inst)
@@ -312,21 +277,8 @@ void CEeCoreInterpreter::PADDSW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sdword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sdword>(static_cast<sword>(reg_source1.read_uword(i)))
-                   + static_cast<sdword>(static_cast<sword>(reg_source2.read_uword(i)));
-
-        if (value[i] > VALUE_SWORD_MAX)
-            value[i] = VALUE_SWORD_MAX;
-        else if (value[i] < VALUE_SWORD_MIN)
-            value[i] = VALUE_SWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<sword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::ADDS, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDUB(const EeCoreInstruction inst)
@@ -338,19 +290,8 @@ void CEeCoreInterpreter::PADDUB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<uhword>(reg_source1.read_ubyte(i))
-                   + static_cast<uhword>(reg_source2.read_ubyte(i));
-
-        if (value[i] > VALUE_UBYTE_MAX)
-            value[i] = VALUE_UBYTE_MAX;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<ubyte>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::ADDU, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDUH(const EeCoreInstruction inst)
@@ -362,19 +303,8 @@ void CEeCoreInterpreter::PADDUH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<uword>(reg_source1.read_uhword(i))
-                   + static_cast<uhword>(reg_source2.read_uhword(i));
-
-        if (value[i] > VALUE_UHWORD_MAX)
-            value[i] = VALUE_UHWORD_MAX;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<uhword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::ADDU, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDUW(const EeCoreInstruction inst)
@@ -386,19 +316,8 @@ void CEeCoreInterpreter::PADDUW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    udword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<udword>(reg_source1.read_uword(i))
-                   + static_cast<udword>(reg_source2.read_uword(i));
-
-        if (value[i] > VALUE_UWORD_MAX)
-            value[i] = VALUE_UWORD_MAX;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<uword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::ADDU, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADDW(const EeCoreInstruction inst)
@@ -411,13 +330,8 @@ void CEeCoreInterpreter::PADDW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uword(i) + reg_source2.read_uword(i);
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::ADD, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PADSBH(const EeCoreInstruction inst)
@@ -429,18 +343,11 @@ void CEeCoreInterpreter::PADSBH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    // Sub
-    for (int i = 0; i < (NUMBER_HWORDS_IN_QWORD / 2); i++)
-        value[i] = reg_source1.read_uhword(i) - reg_source2.read_uhword(i);
-
-    // Add
-    for (int i = (NUMBER_HWORDS_IN_QWORD / 2); i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) + reg_source2.read_uhword(i);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    const uqword source1 = reg_source1.read_uqword();
+    const uqword source2 = reg_source2.read_uqword();
+    const uqword value_sub = vector_integer_op(VectorIntegerOp::SUB, VectorIntegerWidth::HWORD, source1, source2);
+    const uqword value_add = vector_integer_op(VectorIntegerOp::ADD, VectorIntegerWidth::HWORD, source1, source2);
+    reg_dest.write_uqword(uqword(value_sub.lo, value_add.hi));
 }
 
 void CEeCoreInterpreter::PSUBB(const EeCoreInstruction inst)
@@ -452,13 +359,8 @@ void CEeCoreInterpreter::PSUBB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        value[i] = reg_source1.read_ubyte(i) - reg_source2.read_ubyte(i);
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::SUB, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBH(const EeCoreInstruction inst)
@@ -470,13 +372,8 @@ void CEeCoreInterpreter::PSUBH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uhword(i) - reg_source2.read_uhword(i);
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::SUB, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBSB(const EeCoreInstruction inst)
@@ -488,47 +385,21 @@ void CEeCoreInterpreter::PSUBSB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    shword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<shword>(static_cast<sbyte>(reg_source1.read_ubyte(i)))
-                   - static_cast<shword>(static_cast<sbyte>(reg_source2.read_ubyte(i)));
-
-        if (value[i] > VALUE_SBYTE_MAX)
-            value[i] = VALUE_SBYTE_MAX;
-        else if (value[i] < VALUE_SBYTE_MIN)
-            value[i] = VALUE_SBYTE_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<sbyte>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::SUBS, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBSH(const EeCoreInstruction inst)
 {
     auto& r = core->get_resources();
 
-    // Parallel Rd[SH] = Rs[SH] + Rt[SH] Saturated
+    // Parallel Rd[SH] = Rs[SH] - Rt[SH] Saturated
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sword>(static_cast<shword>(reg_source1.read_uhword(i)))
-                   - static_cast<sword>(static_cast<shword>(reg_source2.read_uhword(i)));
-
-        if (value[i] > VALUE_SHWORD_MAX)
-            value[i] = VALUE_SHWORD_MAX;
-        else if (value[i] < VALUE_SHWORD_MIN)
-            value[i] = VALUE_SHWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<shword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::SUBS, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBSW(const EeCoreInstruction inst)
@@ -540,21 +411,8 @@ void CEeCoreInterpreter::PSUBSW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sdword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sdword>(static_cast<sword>(reg_source1.read_uword(i)))
-                   - static_cast<sdword>(static_cast<sword>(reg_source2.read_uword(i)));
-
-        if (value[i] > VALUE_SWORD_MAX)
-            value[i] = VALUE_SWORD_MAX;
-        else if (value[i] < VALUE_SWORD_MIN)
-            value[i] = VALUE_SWORD_MIN;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<sword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::SUBS, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBUB(const EeCoreInstruction inst)
@@ -566,19 +424,8 @@ void CEeCoreInterpreter::PSUBUB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    shword value[NUMBER_BYTES_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-    {
-        value[i] = static_cast<shword>(static_cast<uhword>(reg_source1.read_ubyte(i)))
-                   - static_cast<shword>(static_cast<uhword>(reg_source2.read_ubyte(i)));
-
-        if (value[i] < 0)
-            value[i] = 0;
-    }
-
-    for (int i = 0; i < NUMBER_BYTES_IN_QWORD; i++)
-        reg_dest.write_ubyte(i, static_cast<ubyte>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::SUBU, VectorIntegerWidth::BYTE, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBUH(const EeCoreInstruction inst)
@@ -590,19 +437,8 @@ void CEeCoreInterpreter::PSUBUH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sword value[NUMBER_HWORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sword>(static_cast<uword>(reg_source1.read_uhword(i)))
-                   - static_cast<sword>(static_cast<uhword>(reg_source2.read_uhword(i)));
-
-        if (value[i] < 0)
-            value[i] = 0;
-    }
-
-    for (int i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, static_cast<uhword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::SUBU, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBUW(const EeCoreInstruction inst)
@@ -614,19 +450,8 @@ void CEeCoreInterpreter::PSUBUW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    sdword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-    {
-        value[i] = static_cast<sdword>(static_cast<udword>(reg_source1.read_uword(i)))
-                   - static_cast<sdword>(static_cast<udword>(reg_source2.read_uword(i)));
-
-        if (value[i] < 0)
-            value[i] = 0;
-    }
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, static_cast<uword>(value[i]));
+    const uqword value = vector_integer_op(VectorIntegerOp::SUBU, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PSUBW(const EeCoreInstruction inst)
@@ -638,11 +463,6 @@ void CEeCoreInterpreter::PSUBW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = reg_source1.read_uword(i) - reg_source2.read_uword(i);
-
-    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::SUB, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
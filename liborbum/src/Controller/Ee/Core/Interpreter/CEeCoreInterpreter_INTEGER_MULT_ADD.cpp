@@ -2,6 +2,7 @@
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 #include "Utilities/Utilities.hpp"
+#include "Utilities/VectorInteger.hpp"
 
 void CEeCoreInterpreter::MADD(const EeCoreInstruction inst)
 {
@@ -73,39 +74,15 @@ void CEeCoreInterpreter::PHMADH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    sword value[NUMBER_WORDS_IN_QWORD];
+    const uqword value = vector_integer_multiply_pairs_hword(false, reg_source1.read_uqword(), reg_source2.read_uqword());
 
-    auto madd = [](const uhword a0, const uhword b0, const uhword a1, const uhword b1) -> sword {
-        sword sa0 = static_cast<sword>(static_cast<shword>(a0));
-        sword sb0 = static_cast<sword>(static_cast<shword>(b0));
-        sword sa1 = static_cast<sword>(static_cast<shword>(a1));
-        sword sb1 = static_cast<sword>(static_cast<shword>(b1));
-        return ((sa1 * sb1) + (sa0 * sb0));
-    };
+    reg_dest.write_uqword(value);
+
+    lo.write_uword(0, value.uw[0]);
+    lo.write_uword(2, value.uw[2]);
 
-    value[0] = madd(
-        reg_source1.read_uhword(0), reg_source2.read_uhword(0),
-        reg_source1.read_uhword(1), reg_source2.read_uhword(1));
-    value[1] = madd(
-        reg_source1.read_uhword(2), reg_source2.read_uhword(2),
-        reg_source1.read_uhword(3), reg_source2.read_uhword(3));
-    value[2] = madd(
-        reg_source1.read_uhword(4), reg_source2.read_uhword(4),
-        reg_source1.read_uhword(5), reg_source2.read_uhword(5));
-    value[3] = madd(
-        reg_source1.read_uhword(6), reg_source2.read_uhword(6),
-        reg_source1.read_uhword(7), reg_source2.read_uhword(7));
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[1]);
-    reg_dest.write_uword(2, value[2]);
-    reg_dest.write_uword(3, value[3]);
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(2, value[2]);
-
-    hi.write_uword(0, value[1]);
-    hi.write_uword(2, value[3]);
+    hi.write_uword(0, value.uw[1]);
+    hi.write_uword(2, value.uw[3]);
 }
 
 void CEeCoreInterpreter::PHMSBH(const EeCoreInstruction inst)
@@ -120,39 +97,15 @@ void CEeCoreInterpreter::PHMSBH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    sword value[NUMBER_WORDS_IN_QWORD];
+    const uqword value = vector_integer_multiply_pairs_hword(true, reg_source1.read_uqword(), reg_source2.read_uqword());
 
-    auto madd = [](const uhword a0, const uhword b0, const uhword a1, const uhword b1) -> sword {
-        sword sa0 = static_cast<sword>(static_cast<shword>(a0));
-        sword sb0 = static_cast<sword>(static_cast<shword>(b0));
-        sword sa1 = static_cast<sword>(static_cast<shword>(a1));
-        sword sb1 = static_cast<sword>(static_cast<shword>(b1));
-        return ((sa1 * sb1) - (sa0 * sb0));
-    };
+    reg_dest.write_uqword(value);
+
+    lo.write_uword(0, value.uw[0]);
+    lo.write_uword(2, value.uw[2]);
 
-    value[0] = madd(
-        reg_source1.read_uhword(0), reg_source2.read_uhword(0),
-        reg_source1.read_uhword(1), reg_source2.read_uhword(1));
-    value[1] = madd(
-        reg_source1.read_uhword(2), reg_source2.read_uhword(2),
-        reg_source1.read_uhword(3), reg_source2.read_uhword(3));
-    value[2] = madd(
-        reg_source1.read_uhword(4), reg_source2.read_uhword(4),
-        reg_source1.read_uhword(5), reg_source2.read_uhword(5));
-    value[3] = madd(
-        reg_source1.read_uhword(6), reg_source2.read_uhword(6),
-        reg_source1.read_uhword(7), reg_source2.read_uhword(7));
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[1]);
-    reg_dest.write_uword(2, value[2]);
-    reg_dest.write_uword(3, value[3]);
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(2, value[2]);
-
-    hi.write_uword(0, value[1]);
-    hi.write_uword(2, value[3]);
+    hi.write_uword(0, value.uw[1]);
+    hi.write_uword(2, value.uw[3]);
 }
 
 void CEeCoreInterpreter::PMADDH(const EeCoreInstruction inst)
@@ -168,38 +121,18 @@ void CEeCoreInterpreter::PMADDH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    uword value[NUMBER_WORDS_IN_QWORD * 2];
+    uqword products_lower;
+    uqword products_upper;
+    vector_integer_multiply_hword(reg_source1.read_uqword(), reg_source2.read_uqword(), products_lower, products_upper);
 
-    auto madd = [](const uhword a, const uhword b, const uword c) -> sword {
-        shword sa = static_cast<shword>(a);
-        shword sb = static_cast<shword>(b);
-        sword sc = static_cast<sword>(c);
-        return ((sa * sb) + sc);
-    };
+    // LO accumulates the products of hwords 0, 1, 4, 5 and HI accumulates 2, 3, 6, 7.
+    const uqword value_lo = vector_integer_op(VectorIntegerOp::ADD, VectorIntegerWidth::WORD, lo.read_uqword(), uqword(products_lower.lo, products_upper.lo));
+    const uqword value_hi = vector_integer_op(VectorIntegerOp::ADD, VectorIntegerWidth::WORD, hi.read_uqword(), uqword(products_lower.hi, products_upper.hi));
+
+    lo.write_uqword(value_lo);
+    hi.write_uqword(value_hi);
 
-    value[0] = madd(reg_source1.read_uhword(0), reg_source2.read_uhword(0), lo.read_uword(0));
-    value[1] = madd(reg_source1.read_uhword(1), reg_source2.read_uhword(1), lo.read_uword(1));
-    value[2] = madd(reg_source1.read_uhword(2), reg_source2.read_uhword(2), hi.read_uword(0));
-    value[3] = madd(reg_source1.read_uhword(3), reg_source2.read_uhword(3), hi.read_uword(1));
-    value[4] = madd(reg_source1.read_uhword(4), reg_source2.read_uhword(4), lo.read_uword(2));
-    value[5] = madd(reg_source1.read_uhword(5), reg_source2.read_uhword(5), lo.read_uword(3));
-    value[6] = madd(reg_source1.read_uhword(6), reg_source2.read_uhword(6), hi.read_uword(2));
-    value[7] = madd(reg_source1.read_uhword(7), reg_source2.read_uhword(7), hi.read_uword(3));
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(1, value[1]);
-    lo.write_uword(2, value[4]);
-    lo.write_uword(3, value[5]);
-
-    hi.write_uword(0, value[2]);
-    hi.write_uword(1, value[3]);
-    hi.write_uword(2, value[6]);
-    hi.write_uword(3, value[7]);
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[2]);
-    reg_dest.write_uword(2, value[4]);
-    reg_dest.write_uword(3, value[5]);
+    reg_dest.write_uqword(uqword(value_lo.uw[0], value_hi.uw[0], value_lo.uw[2], value_hi.uw[2]));
 }
 
 void CEeCoreInterpreter::PMADDUW(const EeCoreInstruction inst)
@@ -254,9 +187,8 @@ void CEeCoreInterpreter::PMADDW(const EeCoreInstruction inst)
     auto madd = [](const uword a, const uword b, const uword c0, const uword c1) -> std::tuple<sdword, sdword, sdword> {
         sdword sda = static_cast<sdword>(static_cast<sword>(a));
         sdword sdb = static_cast<sdword>(static_cast<sword>(b));
-        sdword sdc0 = static_cast<sdword>(static_cast<sword>(c0));
-        sdword sdc1 = static_cast<sdword>(static_cast<sword>(c1));
-        sdword result = ((sdc1 << 32) | sdc0) + (sda * sdb);
+        sdword sdc = static_cast<sdword>((static_cast<udword>(c1) << 32) | c0);
+        sdword result = sdc + (sda * sdb);
         return {
             result,
             static_cast<sdword>(static_cast<sword>(result & 0xFFFFFFFF)),
@@ -289,38 +221,18 @@ void CEeCoreInterpreter::PMSUBH(const EeCoreInstruction inst)
     auto& lo = r.ee.core.r5900.lo;
     auto& hi = r.ee.core.r5900.hi;
 
-    uword value[NUMBER_WORDS_IN_QWORD * 2];
+    uqword products_lower;
+    uqword products_upper;
+    vector_integer_multiply_hword(reg_source1.read_uqword(), reg_source2.read_uqword(), products_lower, products_upper);
 
-    auto madd = [](const uhword a, const uhword b, const uword c) -> sword {
-        shword sa = static_cast<shword>(a);
-        shword sb = static_cast<shword>(b);
-        sword sc = static_cast<sword>(c);
-        return (sc - (sa * sb));
-    };
+    // LO accumulates the products of hwords 0, 1, 4, 5 and HI accumulates 2, 3, 6, 7.
+    const uqword value_lo = vector_integer_op(VectorIntegerOp::SUB, VectorIntegerWidth::WORD, lo.read_uqword(), uqword(products_lower.lo, products_upper.lo));
+    const uqword value_hi = vector_integer_op(VectorIntegerOp::SUB, VectorIntegerWidth::WORD, hi.read_uqword(), uqword(products_lower.hi, products_upper.hi));
+
+    lo.write_uqword(value_lo);
+    hi.write_uqword(value_hi);
 
-    value[0] = madd(reg_source1.read_uhword(0), reg_source2.read_uhword(0), lo.read_uword(0));
-    value[1] = madd(reg_source1.read_uhword(1), reg_source2.read_uhword(1), lo.read_uword(1));
-    value[2] = madd(reg_source1.read_uhword(2), reg_source2.read_uhword(2), hi.read_uword(0));
-    value[3] = madd(reg_source1.read_uhword(3), reg_source2.read_uhword(3), hi.read_uword(1));
-    value[4] = madd(reg_source1.read_uhword(4), reg_source2.read_uhword(4), lo.read_uword(2));
-    value[5] = madd(reg_source1.read_uhword(5), reg_source2.read_uhword(5), lo.read_uword(3));
-    value[6] = madd(reg_source1.read_uhword(6), reg_source2.read_uhword(6), hi.read_uword(2));
-    value[7] = madd(reg_source1.read_uhword(7), reg_source2.read_uhword(7), hi.read_uword(3));
-
-    lo.write_uword(0, value[0]);
-    lo.write_uword(1, value[1]);
-    lo.write_uword(2, value[4]);
-    lo.write_uword(3, value[5]);
-
-    hi.write_uword(0, value[2]);
-    hi.write_uword(1, value[3]);
-    hi.write_uword(2, value[6]);
-    hi.write_uword(3, value[7]);
-
-    reg_dest.write_uword(0, value[0]);
-    reg_dest.write_uword(1, value[2]);
-    reg_dest.write_uword(2, value[4]);
-    reg_dest.write_uword(3, value[5]);
+    reg_dest.write_uqword(uqword(value_lo.uw[0], value_hi.uw[0], value_lo.uw[2], value_hi.uw[2]));
 }
 
 void CEeCoreInterpreter::PMSUBW(const EeCoreInstruction inst)
@@ -338,9 +250,8 @@ void CEeCoreInterpreter::PMSUBW(const EeCoreInstruction inst)
     auto madd = [](const uword a, const uword b, const uword c0, const uword c1) -> std::tuple<sdword, sdword, sdword> {
         sdword sda = static_cast<sdword>(static_cast<sword>(a));
         sdword sdb = static_cast<sdword>(static_cast<sword>(b));
-        sdword sdc0 = static_cast<sdword>(static_cast<sword>(c0));
-        sdword sdc1 = static_cast<sdword>(static_cast<sword>(c1));
-        sdword result = ((sdc1 << 32) | sdc0) - (sda * sdb);
+        sdword sdc = static_cast<sdword>((static_cast<udword>(c1) << 32) | c0);
+        sdword result = sdc - (sda * sdb);
         return {
             result,
             static_cast<sdword>(static_cast<sword>(result & 0xFFFFFFFF)),
@@ -1,9 +1,8 @@
-#include <algorithm>
-
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 #include "Utilities/Utilities.hpp"
+#include "Utilities/VectorInteger.hpp"
 
 void CEeCoreInterpreter::PMAXH(const EeCoreInstruction inst)
 {
@@ -15,19 +14,8 @@ void CEeCoreInterpreter::PMAXH(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    auto max = [](const uhword a, const uhword b) -> uhword {
-        shword sa = static_cast<shword>(a);
-        shword sb = static_cast<shword>(b);
-        return static_cast<uhword>(std::max(a, b));
-    };
-
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = max(reg_source1.read_uhword(i), reg_source2.read_uhword(i));
-
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::MAX, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PMAXW(const EeCoreInstruction inst)
@@ -40,19 +28,8 @@ void CEeCoreInterpreter::PMAXW(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    auto max = [](const uword a, const uword b) -> uword {
-        sword sa = static_cast<sword>(a);
-        sword sb = static_cast<sword>(b);
-        return static_cast<uword>(std::max(a, b));
-    };
-
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = max(reg_source1.read_uword(i), reg_source2.read_uword(i));
-
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::MAX, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PMINH(const EeCoreInstruction inst)
@@ -65,19 +42,8 @@ void CEeCoreInterpreter::PMINH(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    uhword value[NUMBER_HWORDS_IN_QWORD];
-
-    auto max = [](const uhword a, const uhword b) -> uhword {
-        shword sa = static_cast<shword>(a);
-        shword sb = static_cast<shword>(b);
-        return static_cast<uhword>(std::min(a, b));
-    };
-
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        value[i] = max(reg_source1.read_uhword(i), reg_source2.read_uhword(i));
-
-    for (auto i = 0; i < NUMBER_HWORDS_IN_QWORD; i++)
-        reg_dest.write_uhword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::MIN, VectorIntegerWidth::HWORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PMINW(const EeCoreInstruction inst)
@@ -90,19 +56,8 @@ void CEeCoreInterpreter::PMINW(const EeCoreInstruction inst)
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.r5900.gpr[inst.rd()];
 
-    uword value[NUMBER_WORDS_IN_QWORD];
-
-    auto max = [](const uword a, const uword b) -> uword {
-        sword sa = static_cast<sword>(a);
-        sword sb = static_cast<sword>(b);
-        return static_cast<uword>(std::min(a, b));
-    };
-
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        value[i] = max(reg_source1.read_uword(i), reg_source2.read_uword(i));
-
-    for (auto i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
-        reg_dest.write_uword(i, value[i]);
+    const uqword value = vector_integer_op(VectorIntegerOp::MIN, VectorIntegerWidth::WORD, reg_source1.read_uqword(), reg_source2.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::MAX_S(const EeCoreInstruction inst)
@@ -36,6 +36,7 @@ void CEeCoreInterpreter::EI(const EeCoreInstruction inst)
     if ((reg_status.extract_field(EeCoreCop0Register_Status::EDI) == 1) || (reg_status.extract_field(EeCoreCop0Register_Status::EXL) == 1) || (reg_status.extract_field(EeCoreCop0Register_Status::ERL) == 1) || (reg_status.extract_field(EeCoreCop0Register_Status::KSU) == 0))
     {
         reg_status.insert_field(EeCoreCop0Register_Status::EIE, 1);
+        interrupt_check_requested = true;
     }
 }
 
@@ -97,8 +98,10 @@ void CEeCoreInterpreter::TLBR(const EeCoreInstruction inst)
     pagemask.insert_field(EeCoreCop0Register_PageMask::MASK, tlb_entry.mask.pagemask);
 
     // EntryHi.
+    const uword old_asid = entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID);
     entryhi.insert_field(EeCoreCop0Register_EntryHi::ASID, static_cast<uword>(tlb_entry.asid));
     entryhi.insert_field(EeCoreCop0Register_EntryHi::VPN2, tlb_entry.vpn2);
+    handle_translation_asid_update(old_asid);
 
     // EntryLo0 (even).
     entrylo0.insert_field(EeCoreCop0Register_EntryLo0::S, static_cast<uword>(tlb_entry.s));
@@ -156,10 +159,11 @@ void CEeCoreInterpreter::TLBWI(const EeCoreInstruction inst)
     // G bit (and of Lo0 and Lo1)
     tlb_entry.g = (entrylo0.extract_field(EeCoreCop0Register_EntryLo0::G) & entrylo1.extract_field(EeCoreCop0Register_EntryLo1::G)) > 0;
 
-    // Write to TLB and flush emulator cache.
-    tlb.set_tlb_entry_at(tlb_entry, index.extract_field(EeCoreCop0Register_Index::INDEX));
-    translation_cache_data.flush();
-    translation_cache_inst.flush();
+    // Write to TLB and invalidate the emulator cache for both the old and new mappings.
+    const int tlb_index = static_cast<int>(index.extract_field(EeCoreCop0Register_Index::INDEX));
+    handle_translation_tlb_entry_update(tlb.tlb_entry_at(tlb_index));
+    tlb.set_tlb_entry_at(tlb_entry, tlb_index);
+    handle_translation_tlb_entry_update(tlb_entry);
 }
 
 void CEeCoreInterpreter::TLBWR(const EeCoreInstruction inst)
@@ -202,8 +206,9 @@ void CEeCoreInterpreter::TLBWR(const EeCoreInstruction inst)
     // G bit (and of Lo0 and Lo1)
     tlb_entry.g = (entrylo0.extract_field(EeCoreCop0Register_EntryLo0::G) & entrylo1.extract_field(EeCoreCop0Register_EntryLo1::G)) > 0;
 
-    // Write to TLB and flush emulator cache.
-    tlb.set_tlb_entry_at(tlb_entry, random.extract_field(EeCoreCop0Register_Random::RANDOM));
-    translation_cache_data.flush();
-    translation_cache_inst.flush();
+    // Write to TLB and invalidate the emulator cache for both the old and new mappings.
+    const int tlb_index = static_cast<int>(random.extract_field(EeCoreCop0Register_Random::RANDOM));
+    handle_translation_tlb_entry_update(tlb.tlb_entry_at(tlb_index));
+    tlb.set_tlb_entry_at(tlb_entry, tlb_index);
+    handle_translation_tlb_entry_update(tlb_entry);
 }
@@ -2,6 +2,7 @@
 #include "Core.hpp"
 #include "Resources/RResources.hpp"
 #include "Utilities/Utilities.hpp"
+#include "Utilities/VectorInteger.hpp"
 
 void CEeCoreInterpreter::PCPYH(const EeCoreInstruction inst)
 {
@@ -157,39 +158,8 @@ void CEeCoreInterpreter::PEXTLB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value0 = reg_source2.read_ubyte(0);
-    ubyte value1 = reg_source1.read_ubyte(0);
-    ubyte value2 = reg_source2.read_ubyte(1);
-    ubyte value3 = reg_source1.read_ubyte(1);
-    ubyte value4 = reg_source2.read_ubyte(2);
-    ubyte value5 = reg_source1.read_ubyte(2);
-    ubyte value6 = reg_source2.read_ubyte(3);
-    ubyte value7 = reg_source1.read_ubyte(3);
-    ubyte value8 = reg_source2.read_ubyte(4);
-    ubyte value9 = reg_source1.read_ubyte(4);
-    ubyte value10 = reg_source2.read_ubyte(5);
-    ubyte value11 = reg_source1.read_ubyte(5);
-    ubyte value12 = reg_source2.read_ubyte(6);
-    ubyte value13 = reg_source1.read_ubyte(6);
-    ubyte value14 = reg_source2.read_ubyte(7);
-    ubyte value15 = reg_source1.read_ubyte(7);
-
-    reg_dest.write_ubyte(0, value0);
-    reg_dest.write_ubyte(1, value1);
-    reg_dest.write_ubyte(2, value2);
-    reg_dest.write_ubyte(3, value3);
-    reg_dest.write_ubyte(4, value4);
-    reg_dest.write_ubyte(5, value5);
-    reg_dest.write_ubyte(6, value6);
-    reg_dest.write_ubyte(7, value7);
-    reg_dest.write_ubyte(8, value8);
-    reg_dest.write_ubyte(9, value9);
-    reg_dest.write_ubyte(10, value10);
-    reg_dest.write_ubyte(11, value11);
-    reg_dest.write_ubyte(12, value12);
-    reg_dest.write_ubyte(13, value13);
-    reg_dest.write_ubyte(14, value14);
-    reg_dest.write_ubyte(15, value15);
+    const uqword value = vector_integer_interleave_lower(VectorIntegerWidth::BYTE, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PEXTLH(const EeCoreInstruction inst)
@@ -201,23 +171,8 @@ void CEeCoreInterpreter::PEXTLH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value0 = reg_source2.read_uhword(0);
-    uhword value1 = reg_source1.read_uhword(0);
-    uhword value2 = reg_source2.read_uhword(1);
-    uhword value3 = reg_source1.read_uhword(1);
-    uhword value4 = reg_source2.read_uhword(2);
-    uhword value5 = reg_source1.read_uhword(2);
-    uhword value6 = reg_source2.read_uhword(3);
-    uhword value7 = reg_source1.read_uhword(3);
-
-    reg_dest.write_uhword(0, value0);
-    reg_dest.write_uhword(1, value1);
-    reg_dest.write_uhword(2, value2);
-    reg_dest.write_uhword(3, value3);
-    reg_dest.write_uhword(4, value4);
-    reg_dest.write_uhword(5, value5);
-    reg_dest.write_uhword(6, value6);
-    reg_dest.write_uhword(7, value7);
+    const uqword value = vector_integer_interleave_lower(VectorIntegerWidth::HWORD, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PEXTLW(const EeCoreInstruction inst)
@@ -229,15 +184,8 @@ void CEeCoreInterpreter::PEXTLW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value0 = reg_source2.read_uword(0);
-    uword value1 = reg_source1.read_uword(0);
-    uword value2 = reg_source2.read_uword(1);
-    uword value3 = reg_source1.read_uword(1);
-
-    reg_dest.write_uword(0, value0);
-    reg_dest.write_uword(1, value1);
-    reg_dest.write_uword(2, value2);
-    reg_dest.write_uword(3, value3);
+    const uqword value = vector_integer_interleave_lower(VectorIntegerWidth::WORD, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PEXTUB(const EeCoreInstruction inst)
@@ -249,39 +197,8 @@ void CEeCoreInterpreter::PEXTUB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value0 = reg_source2.read_ubyte(8);
-    ubyte value1 = reg_source1.read_ubyte(8);
-    ubyte value2 = reg_source2.read_ubyte(9);
-    ubyte value3 = reg_source1.read_ubyte(9);
-    ubyte value4 = reg_source2.read_ubyte(10);
-    ubyte value5 = reg_source1.read_ubyte(10);
-    ubyte value6 = reg_source2.read_ubyte(11);
-    ubyte value7 = reg_source1.read_ubyte(11);
-    ubyte value8 = reg_source2.read_ubyte(12);
-    ubyte value9 = reg_source1.read_ubyte(12);
-    ubyte value10 = reg_source2.read_ubyte(13);
-    ubyte value11 = reg_source1.read_ubyte(13);
-    ubyte value12 = reg_source2.read_ubyte(14);
-    ubyte value13 = reg_source1.read_ubyte(14);
-    ubyte value14 = reg_source2.read_ubyte(15);
-    ubyte value15 = reg_source1.read_ubyte(15);
-
-    reg_dest.write_ubyte(0, value0);
-    reg_dest.write_ubyte(1, value1);
-    reg_dest.write_ubyte(2, value2);
-    reg_dest.write_ubyte(3, value3);
-    reg_dest.write_ubyte(4, value4);
-    reg_dest.write_ubyte(5, value5);
-    reg_dest.write_ubyte(6, value6);
-    reg_dest.write_ubyte(7, value7);
-    reg_dest.write_ubyte(8, value8);
-    reg_dest.write_ubyte(9, value9);
-    reg_dest.write_ubyte(10, value10);
-    reg_dest.write_ubyte(11, value11);
-    reg_dest.write_ubyte(12, value12);
-    reg_dest.write_ubyte(13, value13);
-    reg_dest.write_ubyte(14, value14);
-    reg_dest.write_ubyte(15, value15);
+    const uqword value = vector_integer_interleave_upper(VectorIntegerWidth::BYTE, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PEXTUH(const EeCoreInstruction inst)
@@ -293,23 +210,8 @@ void CEeCoreInterpreter::PEXTUH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value0 = reg_source2.read_uhword(4);
-    uhword value1 = reg_source1.read_uhword(4);
-    uhword value2 = reg_source2.read_uhword(5);
-    uhword value3 = reg_source1.read_uhword(5);
-    uhword value4 = reg_source2.read_uhword(6);
-    uhword value5 = reg_source1.read_uhword(6);
-    uhword value6 = reg_source2.read_uhword(7);
-    uhword value7 = reg_source1.read_uhword(7);
-
-    reg_dest.write_uhword(0, value0);
-    reg_dest.write_uhword(1, value1);
-    reg_dest.write_uhword(2, value2);
-    reg_dest.write_uhword(3, value3);
-    reg_dest.write_uhword(4, value4);
-    reg_dest.write_uhword(5, value5);
-    reg_dest.write_uhword(6, value6);
-    reg_dest.write_uhword(7, value7);
+    const uqword value = vector_integer_interleave_upper(VectorIntegerWidth::HWORD, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PEXTUW(const EeCoreInstruction inst)
@@ -321,15 +223,8 @@ void CEeCoreInterpreter::PEXTUW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value0 = reg_source2.read_uword(2);
-    uword value1 = reg_source1.read_uword(2);
-    uword value2 = reg_source2.read_uword(3);
-    uword value3 = reg_source1.read_uword(3);
-
-    reg_dest.write_uword(0, value0);
-    reg_dest.write_uword(1, value1);
-    reg_dest.write_uword(2, value2);
-    reg_dest.write_uword(3, value3);
+    const uqword value = vector_integer_interleave_upper(VectorIntegerWidth::WORD, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PINTEH(const EeCoreInstruction inst)
@@ -397,39 +292,8 @@ void CEeCoreInterpreter::PPACB(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    ubyte value0 = reg_source2.read_ubyte(0);
-    ubyte value1 = reg_source2.read_ubyte(2);
-    ubyte value2 = reg_source2.read_ubyte(4);
-    ubyte value3 = reg_source2.read_ubyte(6);
-    ubyte value4 = reg_source2.read_ubyte(8);
-    ubyte value5 = reg_source2.read_ubyte(10);
-    ubyte value6 = reg_source2.read_ubyte(12);
-    ubyte value7 = reg_source2.read_ubyte(14);
-    ubyte value8 = reg_source1.read_ubyte(0);
-    ubyte value9 = reg_source1.read_ubyte(2);
-    ubyte value10 = reg_source1.read_ubyte(4);
-    ubyte value11 = reg_source1.read_ubyte(6);
-    ubyte value12 = reg_source1.read_ubyte(8);
-    ubyte value13 = reg_source1.read_ubyte(10);
-    ubyte value14 = reg_source1.read_ubyte(12);
-    ubyte value15 = reg_source1.read_ubyte(14);
-
-    reg_dest.write_ubyte(0, value0);
-    reg_dest.write_ubyte(1, value1);
-    reg_dest.write_ubyte(2, value2);
-    reg_dest.write_ubyte(3, value3);
-    reg_dest.write_ubyte(4, value4);
-    reg_dest.write_ubyte(5, value5);
-    reg_dest.write_ubyte(6, value6);
-    reg_dest.write_ubyte(7, value7);
-    reg_dest.write_ubyte(8, value8);
-    reg_dest.write_ubyte(9, value9);
-    reg_dest.write_ubyte(10, value10);
-    reg_dest.write_ubyte(11, value11);
-    reg_dest.write_ubyte(12, value12);
-    reg_dest.write_ubyte(13, value13);
-    reg_dest.write_ubyte(14, value14);
-    reg_dest.write_ubyte(15, value15);
+    const uqword value = vector_integer_pack(VectorIntegerWidth::BYTE, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PPACH(const EeCoreInstruction inst)
@@ -441,23 +305,8 @@ void CEeCoreInterpreter::PPACH(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uhword value0 = reg_source2.read_uhword(0);
-    uhword value1 = reg_source2.read_uhword(2);
-    uhword value2 = reg_source2.read_uhword(4);
-    uhword value3 = reg_source2.read_uhword(6);
-    uhword value4 = reg_source1.read_uhword(0);
-    uhword value5 = reg_source1.read_uhword(2);
-    uhword value6 = reg_source1.read_uhword(4);
-    uhword value7 = reg_source1.read_uhword(6);
-
-    reg_dest.write_uhword(0, value0);
-    reg_dest.write_uhword(1, value1);
-    reg_dest.write_uhword(2, value2);
-    reg_dest.write_uhword(3, value3);
-    reg_dest.write_uhword(4, value4);
-    reg_dest.write_uhword(5, value5);
-    reg_dest.write_uhword(6, value6);
-    reg_dest.write_uhword(7, value7);
+    const uqword value = vector_integer_pack(VectorIntegerWidth::HWORD, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PPACW(const EeCoreInstruction inst)
@@ -469,15 +318,8 @@ void CEeCoreInterpreter::PPACW(const EeCoreInstruction inst)
     auto& reg_source1 = r.ee.core.r5900.gpr[inst.rs()];
     auto& reg_source2 = r.ee.core.r5900.gpr[inst.rt()];
 
-    uword value0 = reg_source2.read_uword(0);
-    uword value1 = reg_source2.read_uword(2);
-    uword value2 = reg_source1.read_uword(0);
-    uword value3 = reg_source1.read_uword(2);
-
-    reg_dest.write_uword(0, value0);
-    reg_dest.write_uword(1, value1);
-    reg_dest.write_uword(2, value2);
-    reg_dest.write_uword(3, value3);
+    const uqword value = vector_integer_pack(VectorIntegerWidth::WORD, reg_source2.read_uqword(), reg_source1.read_uqword());
+    reg_dest.write_uqword(value);
 }
 
 void CEeCoreInterpreter::PREVH(const EeCoreInstruction inst)
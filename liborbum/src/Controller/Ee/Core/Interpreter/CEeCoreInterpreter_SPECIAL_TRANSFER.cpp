@@ -198,8 +198,15 @@ void CEeCoreInterpreter::MTC0(const EeCoreInstruction inst)
 
     auto& reg_source = r.ee.core.r5900.gpr[inst.rt()];
     auto& reg_dest = r.ee.core.cop0.registers[inst.rd()];
+    const uword old_asid = r.ee.core.cop0.entryhi.extract_field(EeCoreCop0Register_EntryHi::ASID);
 
     reg_dest->write_uword(reg_source.read_uword(0));
+
+    // Status, Cause or Compare may have changed the interrupt state.
+    interrupt_check_requested = true;
+
+    // EntryHi may have changed the ASID used for address translation.
+    handle_translation_asid_update(old_asid);
 }
 
 void CEeCoreInterpreter::MTDAB(const EeCoreInstruction inst)
@@ -0,0 +1,1003 @@
+#include <cstddef>
+
+#include "Controller/Ee/Core/Recompiler/CEeCoreRecompiler.hpp"
+
+#include "Core.hpp"
+#include "Resources/RResources.hpp"
+
+using Reg = X64Emitter::Reg;
+using AluOp = X64Emitter::AluOp;
+using ShiftOp = X64Emitter::ShiftOp;
+using Cond = X64Emitter::Cond;
+using SseOp = X64Emitter::SseOp;
+using XmmReg = X64Emitter::XmmReg;
+
+/// Host calling convention argument registers.
+#if defined(_WIN32)
+constexpr Reg HOST_ARG0 = X64Emitter::RCX;
+constexpr Reg HOST_ARG1 = X64Emitter::RDX;
+#else
+constexpr Reg HOST_ARG0 = X64Emitter::RDI;
+constexpr Reg HOST_ARG1 = X64Emitter::RSI;
+#endif
+
+/// Size of the executable memory region holding compiled code.
+constexpr size_t CODE_MEMORY_SIZE = 32 * 1024 * 1024;
+
+CEeCoreRecompiler::CEeCoreRecompiler(Core* core) :
+    CEeCoreInterpreter(core),
+    code_memory(CODE_MEMORY_SIZE),
+    active_block(nullptr),
+    active_pc(0)
+{
+}
+
+int CEeCoreRecompiler::time_step(const int ticks_available)
+{
+    auto& r = core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+
+    // Check if any external interrupts are pending and immediately handle exception if there is one.
+    // Blocks are run as a whole, so this is done at every block boundary.
+    handle_interrupt_check();
+    interrupt_check_requested = false;
+    r.ee.intc.stat.write_latch = false;
+    r.ee.intc.mask.write_latch = false;
+
+    // Compiled blocks don't know about a pending branch (the interpreter stopped at the budget before its
+    // delay slot), so interpret, which ends the batch once the branch is taken.
+    if (r.ee.core.r5900.bdelay.is_branch_pending())
+        return CEeCoreInterpreter::time_step(ticks_available);
+
+    // Get the decoded block at the current PC, or interpret if not cacheable.
+    const uptr pc_address = pc.read_uword();
+    const uptr physical_address = translate_address_inst(pc_address).value();
+
+    DecodedBlockCache::Block* block = block_cache.find(physical_address);
+    if (!block || !block->is_valid())
+        block = build_block(physical_address);
+    current_block = block;
+
+    if (!block)
+        return CEeCoreInterpreter::time_step(ticks_available);
+
+    // Run the compiled block. Compiled blocks always run to the end, so a block which would overrun
+    // the cycles available is interpreted instead, stopping at the budget as the interpreter does.
+    const CompiledBlock& compiled = get_compiled_block(*block);
+    if (compiled.cycles > ticks_available)
+        return CEeCoreInterpreter::time_step(ticks_available);
+
+    active_block = block;
+    active_pc = pc_address;
+    const int executed = compiled.code(this, r.ee.core.r5900.gpr[0].get_storage());
+    active_block = nullptr;
+
+    if (pending_exception)
+    {
+        std::exception_ptr exception = pending_exception;
+        pending_exception = nullptr;
+        std::rethrow_exception(exception);
+    }
+
+    // Increment PC. Instructions run through the interpreter have already done this.
+    if (executed == static_cast<int>(compiled.length) && compiled.ends_with_native)
+    {
+        pc.write_uword(pc_address + (executed - 1) * Constants::MIPS::SIZE_MIPS_INSTRUCTION);
+        r.ee.core.r5900.bdelay.advance_pc(pc);
+    }
+
+    // Update the COP0.Count register, and check for interrupt.
+    int cycles = compiled.cycles;
+    if (executed != static_cast<int>(compiled.length))
+    {
+        cycles = 0;
+        for (int i = 0; i < executed; i++)
+            cycles += block->entries[i].inst.get_info()->cpi;
+    }
+    handle_count_update(cycles);
+    stats.instructions += executed;
+
+#if defined(BUILD_DEBUG)
+    // Debug increment loop counter.
+    DEBUG_LOOP_COUNTER += executed;
+#endif
+
+    // Return the number of cycles completed.
+    return cycles;
+}
+
+const CEeCoreRecompiler::CompiledBlock& CEeCoreRecompiler::get_compiled_block(const DecodedBlockCache::Block& block)
+{
+    // The decoded block is known to be valid, so a compiled block with the same page generation was compiled from the same code.
+    auto it = compiled_blocks.find(block.physical_address);
+    if (it != compiled_blocks.end() && it->second.page_generation == block.page_generation)
+        return it->second;
+
+    // Compiling may flush all compiled blocks, so insert afterwards.
+    const CompiledBlock compiled = compile_block(block);
+    return compiled_blocks[block.physical_address] = compiled;
+}
+
+CEeCoreRecompiler::CompiledBlock CEeCoreRecompiler::compile_block(const DecodedBlockCache::Block& block)
+{
+    auto& r = core->get_resources();
+
+    // GPR storage offsets, relative to the GPR base passed in.
+    auto& gpr = r.ee.core.r5900.gpr;
+    sword gpr_offsets[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS];
+    for (int i = 0; i < Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS; i++)
+        gpr_offsets[i] = static_cast<sword>(reinterpret_cast<ubyte*>(gpr[i].get_storage()) - reinterpret_cast<ubyte*>(gpr[0].get_storage()));
+
+    X64Emitter e;
+    RegisterCache cache(e, gpr_offsets);
+
+    // Prologue: RBX holds the GPR base, R12 holds the recompiler instance.
+    // The stack is kept 16-byte aligned for calls (and shadow space reserved on Windows).
+    e.push(X64Emitter::RBX);
+    e.push(X64Emitter::RBP);
+    e.push(X64Emitter::R12);
+#if defined(_WIN32)
+    e.push(X64Emitter::RSI);
+    e.push(X64Emitter::RDI);
+    e.alu_r64_imm32(AluOp::Sub, X64Emitter::RSP, 32);
+#endif
+    e.mov_r64_r64(X64Emitter::R12, HOST_ARG0);
+    e.mov_r64_r64(X64Emitter::RBX, HOST_ARG1);
+
+    CompiledBlock compiled{nullptr, block.page_generation, block.entries.size(), 0, false};
+    std::vector<size_t> stop_labels;
+
+    for (size_t i = 0; i < block.entries.size(); i++)
+    {
+        const DecodedInstruction& decoded = block.entries[i];
+        compiled.cycles += decoded.inst.get_info()->cpi;
+
+        compiled.ends_with_native = compile_native(e, cache, decoded, i, i + 1 == block.entries.size(), stop_labels);
+        cache.next_instruction();
+        if (compiled.ends_with_native)
+            continue;
+
+        // Not supported natively, call the interpreter. The GPR's need to be
+        // up to date in memory beforehand, and may have been changed afterwards.
+        cache.flush();
+        e.mov_r64_r64(HOST_ARG0, X64Emitter::R12);
+        e.mov_r32_imm32(HOST_ARG1, static_cast<uword>(i));
+        e.mov_r64_imm64(X64Emitter::RAX, reinterpret_cast<udword>(&CEeCoreRecompiler::run_interpreted));
+        e.call_r64(X64Emitter::RAX);
+
+        // Stop the block early if requested, returning the number of instructions run (including this one).
+        e.test_r8_r8(X64Emitter::RAX, X64Emitter::RAX);
+        const size_t continue_label = e.jcc_rel32(Cond::NE);
+        e.mov_r32_imm32(X64Emitter::RAX, static_cast<uword>(i + 1));
+        stop_labels.push_back(e.jmp_rel32());
+        e.bind(continue_label);
+    }
+
+    cache.flush();
+    e.mov_r32_imm32(X64Emitter::RAX, static_cast<uword>(block.entries.size()));
+
+    // Epilogue.
+    for (const size_t label : stop_labels)
+        e.bind(label);
+#if defined(_WIN32)
+    e.alu_r64_imm32(AluOp::Add, X64Emitter::RSP, 32);
+    e.pop(X64Emitter::RDI);
+    e.pop(X64Emitter::RSI);
+#endif
+    e.pop(X64Emitter::R12);
+    e.pop(X64Emitter::RBP);
+    e.pop(X64Emitter::RBX);
+    e.ret();
+
+    // Copy into executable memory, discarding all compiled code if full.
+    const ubyte* code = code_memory.allocate(e.get_code());
+    if (!code)
+    {
+        BOOST_LOG(Core::get_logger()) << "EeCore recompiler code memory full - flushing all compiled blocks";
+        compiled_blocks.clear();
+        code_memory.reset();
+        code = code_memory.allocate(e.get_code());
+        if (!code)
+            throw std::runtime_error("EeCore recompiler block too large for code memory.");
+    }
+
+    compiled.code = reinterpret_cast<CompiledCode>(const_cast<ubyte*>(code));
+    return compiled;
+}
+
+bool CEeCoreRecompiler::compile_native(X64Emitter& e, RegisterCache& cache, const DecodedInstruction& decoded, const size_t index, const bool is_last, std::vector<size_t>& stop_labels)
+{
+    const EeCoreInstruction& inst = decoded.inst;
+    const auto impl = decoded.impl;
+
+    // Integer add/sub (32-bit results are sign extended to 64-bits).
+    if (impl == &CEeCoreInterpreter::ADDU || impl == &CEeCoreInterpreter::SUBU)
+    {
+        if (!inst.rd())
+            return true;
+        const Reg rs = cache.read(inst.rs());
+        const Reg rt = cache.read(inst.rt());
+        e.mov_r32_r32(X64Emitter::RAX, rs);
+        e.alu_r32_r32((impl == &CEeCoreInterpreter::ADDU) ? AluOp::Add : AluOp::Sub, X64Emitter::RAX, rt);
+        e.movsxd_r64_r32(X64Emitter::RAX, X64Emitter::RAX);
+        e.mov_r64_r64(cache.write(inst.rd()), X64Emitter::RAX);
+        return true;
+    }
+
+    if (impl == &CEeCoreInterpreter::ADDIU)
+    {
+        if (!inst.rt())
+            return true;
+        const Reg rs = cache.read(inst.rs());
+        e.mov_r32_r32(X64Emitter::RAX, rs);
+        e.alu_r32_imm32(AluOp::Add, X64Emitter::RAX, inst.s_imm());
+        e.movsxd_r64_r32(X64Emitter::RAX, X64Emitter::RAX);
+        e.mov_r64_r64(cache.write(inst.rt()), X64Emitter::RAX);
+        return true;
+    }
+
+    // Integer add/sub (64-bit) and logical.
+    AluOp alu_op = AluOp::Add;
+    bool is_alu = true;
+    bool alu_not = false;
+    bool alu_rr = true;
+    if (impl == &CEeCoreInterpreter::DADDU)
+    {
+        alu_op = AluOp::Add;
+    }
+    else if (impl == &CEeCoreInterpreter::DSUBU)
+    {
+        alu_op = AluOp::Sub;
+    }
+    else if (impl == &CEeCoreInterpreter::AND)
+    {
+        alu_op = AluOp::And;
+    }
+    else if (impl == &CEeCoreInterpreter::OR)
+    {
+        alu_op = AluOp::Or;
+    }
+    else if (impl == &CEeCoreInterpreter::XOR)
+    {
+        alu_op = AluOp::Xor;
+    }
+    else if (impl == &CEeCoreInterpreter::NOR)
+    {
+        alu_op = AluOp::Or;
+        alu_not = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DADDIU)
+    {
+        alu_op = AluOp::Add;
+        alu_rr = false;
+    }
+    else if (impl == &CEeCoreInterpreter::ANDI)
+    {
+        alu_op = AluOp::And;
+        alu_rr = false;
+    }
+    else if (impl == &CEeCoreInterpreter::ORI)
+    {
+        alu_op = AluOp::Or;
+        alu_rr = false;
+    }
+    else if (impl == &CEeCoreInterpreter::XORI)
+    {
+        alu_op = AluOp::Xor;
+        alu_rr = false;
+    }
+    else
+    {
+        is_alu = false;
+    }
+
+    if (is_alu)
+    {
+        const int rd = alu_rr ? inst.rd() : inst.rt();
+        if (!rd)
+            return true;
+        const Reg rs = cache.read(inst.rs());
+        e.mov_r64_r64(X64Emitter::RAX, rs);
+        if (alu_rr)
+            e.alu_r64_r64(alu_op, X64Emitter::RAX, cache.read(inst.rt()));
+        else if (impl == &CEeCoreInterpreter::DADDIU)
+            e.alu_r64_imm32(alu_op, X64Emitter::RAX, inst.s_imm());
+        else
+            e.alu_r64_imm32(alu_op, X64Emitter::RAX, inst.u_imm());
+        if (alu_not)
+            e.not_r64(X64Emitter::RAX);
+        e.mov_r64_r64(cache.write(rd), X64Emitter::RAX);
+        return true;
+    }
+
+    if (impl == &CEeCoreInterpreter::LUI)
+    {
+        if (!inst.rt())
+            return true;
+        e.mov_r64_imm32(cache.write(inst.rt()), static_cast<sword>(static_cast<uword>(inst.u_imm()) << 16));
+        return true;
+    }
+
+    // Shifts.
+    ShiftOp shift_op = ShiftOp::Shl;
+    bool is_shift = true;
+    bool shift_64 = false;
+    bool shift_variable = false;
+    int shift_amount = inst.shamt();
+    if (impl == &CEeCoreInterpreter::SLL)
+    {
+        shift_op = ShiftOp::Shl;
+    }
+    else if (impl == &CEeCoreInterpreter::SRL)
+    {
+        shift_op = ShiftOp::Shr;
+    }
+    else if (impl == &CEeCoreInterpreter::SRA)
+    {
+        shift_op = ShiftOp::Sar;
+    }
+    else if (impl == &CEeCoreInterpreter::SLLV)
+    {
+        shift_op = ShiftOp::Shl;
+        shift_variable = true;
+    }
+    else if (impl == &CEeCoreInterpreter::SRLV)
+    {
+        shift_op = ShiftOp::Shr;
+        shift_variable = true;
+    }
+    else if (impl == &CEeCoreInterpreter::SRAV)
+    {
+        shift_op = ShiftOp::Sar;
+        shift_variable = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DSLL)
+    {
+        shift_op = ShiftOp::Shl;
+        shift_64 = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DSRL)
+    {
+        shift_op = ShiftOp::Shr;
+        shift_64 = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DSRA)
+    {
+        shift_op = ShiftOp::Sar;
+        shift_64 = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DSLL32)
+    {
+        shift_op = ShiftOp::Shl;
+        shift_64 = true;
+        shift_amount += 32;
+    }
+    else if (impl == &CEeCoreInterpreter::DSRL32)
+    {
+        shift_op = ShiftOp::Shr;
+        shift_64 = true;
+        shift_amount += 32;
+    }
+    else if (impl == &CEeCoreInterpreter::DSRA32)
+    {
+        shift_op = ShiftOp::Sar;
+        shift_64 = true;
+        shift_amount += 32;
+    }
+    else if (impl == &CEeCoreInterpreter::DSLLV)
+    {
+        shift_op = ShiftOp::Shl;
+        shift_64 = true;
+        shift_variable = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DSRLV)
+    {
+        shift_op = ShiftOp::Shr;
+        shift_64 = true;
+        shift_variable = true;
+    }
+    else if (impl == &CEeCoreInterpreter::DSRAV)
+    {
+        shift_op = ShiftOp::Sar;
+        shift_64 = true;
+        shift_variable = true;
+    }
+    else
+    {
+        is_shift = false;
+    }
+
+    if (is_shift)
+    {
+        // The host masks variable shift amounts the same way (5 bits for 32-bit, 6 bits for 64-bit).
+        if (!inst.rd())
+            return true;
+        const Reg rt = cache.read(inst.rt());
+        if (shift_variable)
+            e.mov_r32_r32(X64Emitter::RCX, cache.read(inst.rs()));
+        if (shift_64)
+        {
+            e.mov_r64_r64(X64Emitter::RAX, rt);
+            if (shift_variable)
+                e.shift_r64_cl(shift_op, X64Emitter::RAX);
+            else
+                e.shift_r64_imm(shift_op, X64Emitter::RAX, static_cast<ubyte>(shift_amount));
+        }
+        else
+        {
+            e.mov_r32_r32(X64Emitter::RAX, rt);
+            if (shift_variable)
+                e.shift_r32_cl(shift_op, X64Emitter::RAX);
+            else
+                e.shift_r32_imm(shift_op, X64Emitter::RAX, static_cast<ubyte>(shift_amount));
+            e.movsxd_r64_r32(X64Emitter::RAX, X64Emitter::RAX);
+        }
+        e.mov_r64_r64(cache.write(inst.rd()), X64Emitter::RAX);
+        return true;
+    }
+
+    // Set on less than.
+    if (impl == &CEeCoreInterpreter::SLT || impl == &CEeCoreInterpreter::SLTU)
+    {
+        if (!inst.rd())
+            return true;
+        const Reg rs = cache.read(inst.rs());
+        const Reg rt = cache.read(inst.rt());
+        e.alu_r32_r32(AluOp::Xor, X64Emitter::RAX, X64Emitter::RAX);
+        e.alu_r64_r64(AluOp::Cmp, rs, rt);
+        e.setcc_r8((impl == &CEeCoreInterpreter::SLT) ? Cond::L : Cond::B, X64Emitter::RAX);
+        e.mov_r64_r64(cache.write(inst.rd()), X64Emitter::RAX);
+        return true;
+    }
+
+    if (impl == &CEeCoreInterpreter::SLTI || impl == &CEeCoreInterpreter::SLTIU)
+    {
+        // Both compare against the sign extended immediate.
+        if (!inst.rt())
+            return true;
+        const Reg rs = cache.read(inst.rs());
+        e.alu_r32_r32(AluOp::Xor, X64Emitter::RAX, X64Emitter::RAX);
+        e.alu_r64_imm32(AluOp::Cmp, rs, inst.s_imm());
+        e.setcc_r8((impl == &CEeCoreInterpreter::SLTI) ? Cond::L : Cond::B, X64Emitter::RAX);
+        e.mov_r64_r64(cache.write(inst.rt()), X64Emitter::RAX);
+        return true;
+    }
+
+    // Conditional moves.
+    if (impl == &CEeCoreInterpreter::MOVZ || impl == &CEeCoreInterpreter::MOVN)
+    {
+        if (!inst.rd())
+            return true;
+        const Reg rs = cache.read(inst.rs());
+        const Reg rt = cache.read(inst.rt());
+        const Reg rd = cache.modify(inst.rd());
+        e.test_r64_r64(rt, rt);
+        e.cmovcc_r64_r64((impl == &CEeCoreInterpreter::MOVZ) ? Cond::E : Cond::NE, rd, rs);
+        return true;
+    }
+
+    if (compile_native_mmi(e, cache, decoded))
+        return true;
+
+    // COP1 instructions need the usable check, which can't stop the block after the last instruction.
+    if (!is_last && compile_native_cop1(e, cache, decoded, index, stop_labels))
+        return true;
+
+    return false;
+}
+
+bool CEeCoreRecompiler::compile_native_mmi(X64Emitter& e, RegisterCache& cache, const DecodedInstruction& decoded)
+{
+    const EeCoreInstruction& inst = decoded.inst;
+    const auto impl = decoded.impl;
+
+    // Instructions mapping onto a single SSE2 instruction (as in the VectorInteger kernels): Rd = Rs OP Rt.
+    // Interleaves and copies take Rt as the first operand. Saturating word add/sub, multiply/divide,
+    // packs, shuffles and shifts are left to the interpreter.
+    SseOp op = SseOp::Paddb;
+    bool swap = false;
+    bool is_mmi = true;
+    if (impl == &CEeCoreInterpreter::PADDB)
+    {
+        op = SseOp::Paddb;
+    }
+    else if (impl == &CEeCoreInterpreter::PADDH)
+    {
+        op = SseOp::Paddw;
+    }
+    else if (impl == &CEeCoreInterpreter::PADDW)
+    {
+        op = SseOp::Paddd;
+    }
+    else if (impl == &CEeCoreInterpreter::PADDSB)
+    {
+        op = SseOp::Paddsb;
+    }
+    else if (impl == &CEeCoreInterpreter::PADDSH)
+    {
+        op = SseOp::Paddsw;
+    }
+    else if (impl == &CEeCoreInterpreter::PADDUB)
+    {
+        op = SseOp::Paddusb;
+    }
+    else if (impl == &CEeCoreInterpreter::PADDUH)
+    {
+        op = SseOp::Paddusw;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBB)
+    {
+        op = SseOp::Psubb;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBH)
+    {
+        op = SseOp::Psubw;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBW)
+    {
+        op = SseOp::Psubd;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBSB)
+    {
+        op = SseOp::Psubsb;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBSH)
+    {
+        op = SseOp::Psubsw;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBUB)
+    {
+        op = SseOp::Psubusb;
+    }
+    else if (impl == &CEeCoreInterpreter::PSUBUH)
+    {
+        op = SseOp::Psubusw;
+    }
+    else if (impl == &CEeCoreInterpreter::PMAXH)
+    {
+        op = SseOp::Pmaxsw;
+    }
+    else if (impl == &CEeCoreInterpreter::PMINH)
+    {
+        op = SseOp::Pminsw;
+    }
+    else if (impl == &CEeCoreInterpreter::PCEQB)
+    {
+        op = SseOp::Pcmpeqb;
+    }
+    else if (impl == &CEeCoreInterpreter::PCEQH)
+    {
+        op = SseOp::Pcmpeqw;
+    }
+    else if (impl == &CEeCoreInterpreter::PCEQW)
+    {
+        op = SseOp::Pcmpeqd;
+    }
+    else if (impl == &CEeCoreInterpreter::PCGTB)
+    {
+        op = SseOp::Pcmpgtb;
+    }
+    else if (impl == &CEeCoreInterpreter::PCGTH)
+    {
+        op = SseOp::Pcmpgtw;
+    }
+    else if (impl == &CEeCoreInterpreter::PCGTW)
+    {
+        op = SseOp::Pcmpgtd;
+    }
+    else if (impl == &CEeCoreInterpreter::PAND)
+    {
+        op = SseOp::Pand;
+    }
+    else if (impl == &CEeCoreInterpreter::POR || impl == &CEeCoreInterpreter::PNOR)
+    {
+        op = SseOp::Por;
+    }
+    else if (impl == &CEeCoreInterpreter::PXOR)
+    {
+        op = SseOp::Pxor;
+    }
+    else if (impl == &CEeCoreInterpreter::PMAXW || impl == &CEeCoreInterpreter::PMINW)
+    {
+        op = SseOp::Pcmpgtd;
+    }
+    else if (impl == &CEeCoreInterpreter::PEXTLB)
+    {
+        op = SseOp::Punpcklbw;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PEXTLH)
+    {
+        op = SseOp::Punpcklwd;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PEXTLW)
+    {
+        op = SseOp::Punpckldq;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PEXTUB)
+    {
+        op = SseOp::Punpckhbw;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PEXTUH)
+    {
+        op = SseOp::Punpckhwd;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PEXTUW)
+    {
+        op = SseOp::Punpckhdq;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PCPYLD)
+    {
+        op = SseOp::Punpcklqdq;
+        swap = true;
+    }
+    else if (impl == &CEeCoreInterpreter::PCPYUD)
+    {
+        op = SseOp::Punpckhqdq;
+    }
+    else
+    {
+        is_mmi = false;
+    }
+
+    if (!is_mmi)
+        return false;
+    if (!inst.rd())
+        return true;
+
+    // The full 128-bit GPR's are operated on in memory, so the cached (lower 64-bits) values are written back first.
+    auto& gpr = core->get_resources().ee.core.r5900.gpr;
+    const int first = swap ? inst.rt() : inst.rs();
+    const int second = swap ? inst.rs() : inst.rt();
+    cache.store(first);
+    cache.store(second);
+    e.movdqu_x_m128(XmmReg::XMM0, X64Emitter::RBX, get_base_offset(gpr[first].get_storage()));
+    e.movdqu_x_m128(XmmReg::XMM1, X64Emitter::RBX, get_base_offset(gpr[second].get_storage()));
+
+    if (impl == &CEeCoreInterpreter::PMAXW || impl == &CEeCoreInterpreter::PMINW)
+    {
+        // No SSE2 equivalent, select Rs with the (Rs > Rt) mask for max or the (Rt > Rs) mask for min.
+        if (impl == &CEeCoreInterpreter::PMAXW)
+        {
+            e.sse_x_x(SseOp::Movdqa, XmmReg::XMM2, XmmReg::XMM0);
+            e.sse_x_x(SseOp::Pcmpgtd, XmmReg::XMM2, XmmReg::XMM1);
+        }
+        else
+        {
+            e.sse_x_x(SseOp::Movdqa, XmmReg::XMM2, XmmReg::XMM1);
+            e.sse_x_x(SseOp::Pcmpgtd, XmmReg::XMM2, XmmReg::XMM0);
+        }
+        e.sse_x_x(SseOp::Pand, XmmReg::XMM0, XmmReg::XMM2);
+        e.sse_x_x(SseOp::Pandn, XmmReg::XMM2, XmmReg::XMM1);
+        e.sse_x_x(SseOp::Por, XmmReg::XMM0, XmmReg::XMM2);
+    }
+    else
+    {
+        e.sse_x_x(op, XmmReg::XMM0, XmmReg::XMM1);
+        if (impl == &CEeCoreInterpreter::PNOR)
+        {
+            e.sse_x_x(SseOp::Pcmpeqd, XmmReg::XMM1, XmmReg::XMM1);
+            e.sse_x_x(SseOp::Pxor, XmmReg::XMM0, XmmReg::XMM1);
+        }
+    }
+
+    e.movdqu_m128_x(X64Emitter::RBX, get_base_offset(gpr[inst.rd()].get_storage()), XmmReg::XMM0);
+    cache.discard(inst.rd());
+    return true;
+}
+
+bool CEeCoreRecompiler::compile_native_cop1(X64Emitter& e, RegisterCache& cache, const DecodedInstruction& decoded, const size_t index, std::vector<size_t>& stop_labels)
+{
+    const EeCoreInstruction& inst = decoded.inst;
+    const auto impl = decoded.impl;
+
+    if (impl != &CEeCoreInterpreter::MFC1 && impl != &CEeCoreInterpreter::MTC1 && impl != &CEeCoreInterpreter::MOV_S
+        && impl != &CEeCoreInterpreter::ABS_S && impl != &CEeCoreInterpreter::NEG_S
+        && impl != &CEeCoreInterpreter::ADD_S && impl != &CEeCoreInterpreter::SUB_S && impl != &CEeCoreInterpreter::MUL_S)
+        return false;
+
+    auto& r = core->get_resources();
+    auto& fpr = r.ee.core.fpu.fpr;
+    const sword fs = get_base_offset(fpr[inst.rd()].get_storage());
+    const sword ft = get_base_offset(fpr[inst.rt()].get_storage());
+    const sword fd = get_base_offset(fpr[inst.shamt()].get_storage());
+    const sword csr = get_base_offset(r.ee.core.fpu.csr.get_storage());
+
+    // Bits of the CSR flags (see EeCoreFpuRegister_Csr::clear_flags() and update_result_flags()).
+    constexpr uword CSR_U = 1 << 14;
+    constexpr uword CSR_O = 1 << 15;
+    constexpr uword CSR_FLAGS = CSR_U | CSR_O | (1 << 16) | (1 << 17);
+    constexpr uword CSR_SU = 1 << 3;
+    constexpr uword CSR_SO = 1 << 4;
+
+    emit_cop1_usable_check(e, cache, index, stop_labels);
+
+    // Register transfers.
+    if (impl == &CEeCoreInterpreter::MTC1)
+    {
+        e.mov_m32_r32(X64Emitter::RBX, fs, cache.read(inst.rt()));
+        return true;
+    }
+
+    if (impl == &CEeCoreInterpreter::MFC1)
+    {
+        // Rt = SignExtend(Fs), where the sign comes from the float compare (Fs < 0.0) for all 128-bits.
+        if (!inst.rt())
+            return true;
+        e.alu_r32_r32(AluOp::Xor, X64Emitter::RCX, X64Emitter::RCX);
+        e.sse_x_x(SseOp::Pxor, XmmReg::XMM1, XmmReg::XMM1);
+        e.movss_x_m32(XmmReg::XMM0, X64Emitter::RBX, fs);
+        e.sse_x_x(SseOp::Comiss, XmmReg::XMM1, XmmReg::XMM0);
+        e.setcc_r8(Cond::A, X64Emitter::RCX);
+        e.neg_r64(X64Emitter::RCX);
+        e.mov_r32_m32(X64Emitter::RAX, X64Emitter::RBX, fs);
+        e.mov_r64_r64(X64Emitter::RDX, X64Emitter::RCX);
+        e.shift_r64_imm(ShiftOp::Shl, X64Emitter::RDX, 32);
+        e.alu_r64_r64(AluOp::Or, X64Emitter::RAX, X64Emitter::RDX);
+        e.mov_m64_r64(X64Emitter::RBX, get_base_offset(r.ee.core.r5900.gpr[inst.rt()].get_storage()) + sizeof(udword), X64Emitter::RCX);
+        e.mov_r64_r64(cache.write(inst.rt()), X64Emitter::RAX);
+        return true;
+    }
+
+    if (impl == &CEeCoreInterpreter::MOV_S)
+    {
+        e.mov_r32_m32(X64Emitter::RAX, X64Emitter::RBX, fs);
+        e.mov_m32_r32(X64Emitter::RBX, fd, X64Emitter::RAX);
+        return true;
+    }
+
+    // Sign operations, which only clear the flags.
+    if (impl == &CEeCoreInterpreter::ABS_S || impl == &CEeCoreInterpreter::NEG_S)
+    {
+        e.mov_r32_m32(X64Emitter::RAX, X64Emitter::RBX, fs);
+        if (impl == &CEeCoreInterpreter::ABS_S)
+            e.alu_r32_imm32(AluOp::And, X64Emitter::RAX, 0x7FFFFFFF);
+        else
+            e.alu_r32_imm32(AluOp::Xor, X64Emitter::RAX, static_cast<sword>(0x80000000));
+        e.mov_m32_r32(X64Emitter::RBX, fd, X64Emitter::RAX);
+        e.mov_r32_m32(X64Emitter::RAX, X64Emitter::RBX, csr);
+        e.alu_r32_imm32(AluOp::And, X64Emitter::RAX, static_cast<sword>(~CSR_FLAGS));
+        e.mov_m32_r32(X64Emitter::RBX, csr, X64Emitter::RAX);
+        return true;
+    }
+
+    // Arithmetic: Fd = Fs OP Ft, with the result formatted as in to_ps2_float().
+    const SseOp op = (impl == &CEeCoreInterpreter::ADD_S) ? SseOp::Addss : (impl == &CEeCoreInterpreter::SUB_S) ? SseOp::Subss : SseOp::Mulss;
+    e.movss_x_m32(XmmReg::XMM0, X64Emitter::RBX, fs);
+    e.movss_x_m32(XmmReg::XMM1, X64Emitter::RBX, ft);
+    e.sse_x_x(op, XmmReg::XMM0, XmmReg::XMM1);
+    e.movd_r32_x(X64Emitter::RAX, XmmReg::XMM0);
+
+    // EAX = result, EDX = magnitude, ECX = flags to set.
+    e.mov_r32_r32(X64Emitter::RDX, X64Emitter::RAX);
+    e.alu_r32_imm32(AluOp::And, X64Emitter::RDX, 0x7FFFFFFF);
+    e.alu_r32_r32(AluOp::Xor, X64Emitter::RCX, X64Emitter::RCX);
+
+    // Inf -> +/- Fmax and NaN -> +Fmax (the sign compare is false), setting O.
+    e.alu_r32_imm32(AluOp::Cmp, X64Emitter::RDX, 0x7F800000);
+    const size_t finite_label = e.jcc_rel32(Cond::B);
+    e.mov_r32_imm32(X64Emitter::RCX, CSR_O | CSR_SO);
+    const size_t inf_label = e.jcc_rel32(Cond::E);
+    e.alu_r32_r32(AluOp::Xor, X64Emitter::RAX, X64Emitter::RAX);
+    e.bind(inf_label);
+    e.alu_r32_imm32(AluOp::And, X64Emitter::RAX, static_cast<sword>(0x80000000));
+    e.alu_r32_imm32(AluOp::Or, X64Emitter::RAX, 0x7F7FFFFF);
+    const size_t overflow_done_label = e.jmp_rel32();
+
+    // Denormal -> +/- 0, setting U.
+    e.bind(finite_label);
+    e.alu_r32_imm32(AluOp::Cmp, X64Emitter::RDX, 0x00800000);
+    const size_t normal_label = e.jcc_rel32(Cond::AE);
+    e.test_r64_r64(X64Emitter::RDX, X64Emitter::RDX);
+    const size_t zero_label = e.jcc_rel32(Cond::E);
+    e.mov_r32_imm32(X64Emitter::RCX, CSR_U | CSR_SU);
+    e.alu_r32_imm32(AluOp::And, X64Emitter::RAX, static_cast<sword>(0x80000000));
+    e.bind(normal_label);
+    e.bind(zero_label);
+    e.bind(overflow_done_label);
+
+    e.mov_m32_r32(X64Emitter::RBX, fd, X64Emitter::RAX);
+    e.mov_r32_m32(X64Emitter::RAX, X64Emitter::RBX, csr);
+    e.alu_r32_imm32(AluOp::And, X64Emitter::RAX, static_cast<sword>(~CSR_FLAGS));
+    e.alu_r32_r32(AluOp::Or, X64Emitter::RAX, X64Emitter::RCX);
+    e.mov_m32_r32(X64Emitter::RBX, csr, X64Emitter::RAX);
+    return true;
+}
+
+void CEeCoreRecompiler::emit_cop1_usable_check(X64Emitter& e, RegisterCache& cache, const size_t index, std::vector<size_t>& stop_labels)
+{
+    // COP0.Status.CU[1].
+    auto& r = core->get_resources();
+    e.mov_r32_m32(X64Emitter::RAX, X64Emitter::RBX, get_base_offset(r.ee.core.cop0.status.get_storage()));
+    e.test_r32_imm32(X64Emitter::RAX, 1 << 29);
+    const size_t usable_label = e.jcc_rel32(Cond::NE);
+
+    // Not usable, let the interpreter raise the exception and stop the block.
+    // The cache state is left as is for the usable path.
+    cache.store_all();
+    e.mov_r64_r64(HOST_ARG0, X64Emitter::R12);
+    e.mov_r32_imm32(HOST_ARG1, static_cast<uword>(index));
+    e.mov_r64_imm64(X64Emitter::RAX, reinterpret_cast<udword>(&CEeCoreRecompiler::run_interpreted));
+    e.call_r64(X64Emitter::RAX);
+    e.mov_r32_imm32(X64Emitter::RAX, static_cast<uword>(index + 1));
+    stop_labels.push_back(e.jmp_rel32());
+
+    e.bind(usable_label);
+}
+
+sword CEeCoreRecompiler::get_base_offset(const void* address)
+{
+    const std::ptrdiff_t offset = reinterpret_cast<const ubyte*>(address) - reinterpret_cast<const ubyte*>(core->get_resources().ee.core.r5900.gpr[0].get_storage());
+    if (offset < VALUE_SWORD_MIN || offset > VALUE_SWORD_MAX)
+        throw std::runtime_error("EeCore recompiler resource out of range of the GPR base.");
+    return static_cast<sword>(offset);
+}
+
+bool CEeCoreRecompiler::run_interpreted(CEeCoreRecompiler* recompiler, const int index)
+{
+    auto& r = recompiler->core->get_resources();
+    auto& pc = r.ee.core.r5900.pc;
+
+    // Exceptions cannot be propagated through the compiled code, rethrown from time_step().
+    try
+    {
+        // The PC is not kept up to date by natively translated instructions.
+        const uptr inst_pc = recompiler->active_pc + index * Constants::MIPS::SIZE_MIPS_INSTRUCTION;
+        pc.write_uword(inst_pc);
+
+        const DecodedInstruction& decoded = recompiler->active_block->entries[index];
+        (recompiler->*decoded.impl)(decoded.inst);
+        r.ee.core.r5900.reset_zero_gpr();
+
+        // Any non-sequential PC change (an exception being raised, or a not taken branch likely skipping its delay slot)
+        // means the rest of the block doesn't follow. Taken branches go through the branch delay slot instead.
+        const bool pc_changed = pc.read_uword() != inst_pc;
+
+        // Increment PC.
+        r.ee.core.r5900.bdelay.advance_pc(pc);
+
+        // Stop the block if the PC changed, it was invalidated by the instruction (self modifying code), or an interrupt may now be pending.
+        return !pc_changed
+               && !recompiler->interrupt_check_requested
+               && !r.ee.intc.stat.write_latch
+               && !r.ee.intc.mask.write_latch
+               && recompiler->active_block->is_valid();
+    }
+    catch (...)
+    {
+        recompiler->pending_exception = std::current_exception();
+        return false;
+    }
+}
+
+CEeCoreRecompiler::RegisterCache::RegisterCache(X64Emitter& emitter, const sword* gpr_offsets) :
+    slots{{X64Emitter::RSI, -1, false, false, 0},
+          {X64Emitter::RDI, -1, false, false, 0},
+          {X64Emitter::R8, -1, false, false, 0},
+          {X64Emitter::R9, -1, false, false, 0},
+          {X64Emitter::R10, -1, false, false, 0},
+          {X64Emitter::R11, -1, false, false, 0}},
+    emitter(emitter),
+    gpr_offsets(gpr_offsets),
+    use_counter(0)
+{
+}
+
+X64Emitter::Reg CEeCoreRecompiler::RegisterCache::read(const int index)
+{
+    return allocate(index, true).host;
+}
+
+X64Emitter::Reg CEeCoreRecompiler::RegisterCache::write(const int index)
+{
+    Slot& slot = allocate(index, false);
+    slot.dirty = true;
+    return slot.host;
+}
+
+X64Emitter::Reg CEeCoreRecompiler::RegisterCache::modify(const int index)
+{
+    Slot& slot = allocate(index, true);
+    slot.dirty = true;
+    return slot.host;
+}
+
+void CEeCoreRecompiler::RegisterCache::next_instruction()
+{
+    for (auto& slot : slots)
+        slot.locked = false;
+}
+
+void CEeCoreRecompiler::RegisterCache::flush()
+{
+    for (auto& slot : slots)
+    {
+        if (slot.index != -1 && slot.dirty)
+            emitter.mov_m64_r64(X64Emitter::RBX, gpr_offsets[slot.index], slot.host);
+        slot.index = -1;
+        slot.dirty = false;
+        slot.locked = false;
+    }
+}
+
+void CEeCoreRecompiler::RegisterCache::store(const int index)
+{
+    for (auto& slot : slots)
+    {
+        if (slot.index == index && slot.dirty)
+        {
+            emitter.mov_m64_r64(X64Emitter::RBX, gpr_offsets[slot.index], slot.host);
+            slot.dirty = false;
+        }
+    }
+}
+
+void CEeCoreRecompiler::RegisterCache::discard(const int index)
+{
+    for (auto& slot : slots)
+    {
+        if (slot.index == index)
+        {
+            slot.index = -1;
+            slot.dirty = false;
+        }
+    }
+}
+
+void CEeCoreRecompiler::RegisterCache::store_all()
+{
+    for (auto& slot : slots)
+    {
+        if (slot.index != -1 && slot.dirty)
+            emitter.mov_m64_r64(X64Emitter::RBX, gpr_offsets[slot.index], slot.host);
+    }
+}
+
+CEeCoreRecompiler::RegisterCache::Slot& CEeCoreRecompiler::RegisterCache::allocate(const int index, const bool load)
+{
+    Slot* selected = nullptr;
+
+    // Already cached.
+    for (auto& slot : slots)
+    {
+        if (slot.index == index)
+        {
+            selected = &slot;
+            break;
+        }
+    }
+
+    if (!selected)
+    {
+        // Use a free slot, otherwise evict the least recently used one not in use by the current instruction.
+        for (auto& slot : slots)
+        {
+            if (slot.locked)
+                continue;
+            if (slot.index == -1)
+            {
+                selected = &slot;
+                break;
+            }
+            if (!selected || slot.last_use < selected->last_use)
+                selected = &slot;
+        }
+
+        if (selected->index != -1 && selected->dirty)
+            emitter.mov_m64_r64(X64Emitter::RBX, gpr_offsets[selected->index], selected->host);
+
+        selected->index = index;
+        selected->dirty = false;
+        if (load)
+            emitter.mov_r64_m64(selected->host, X64Emitter::RBX, gpr_offsets[index]);
+    }
+
+    selected->locked = true;
+    selected->last_use = use_counter++;
+    return *selected;
+}
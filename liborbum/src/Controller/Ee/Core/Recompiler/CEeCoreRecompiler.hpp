@@ -0,0 +1,141 @@
+#pragma once
+
+#include <exception>
+#include <unordered_map>
+#include <vector>
+
+#include "Common/Types/Recompiler/ExecutableMemory.hpp"
+#include "Common/Types/Recompiler/X64Emitter.hpp"
+#include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
+
+class Core;
+
+/// The EE Core recompiler (dynarec), targeting x86-64 hosts.
+/// Translates the decoded blocks (see CEeCoreInterpreter::build_block()) into host code, which is run as a whole.
+/// Common integer ALU instructions are translated natively, with the GPR's cached in host registers across the block.
+/// The MMI instructions with a direct SSE2 equivalent (the same instructions as the VectorInteger SSE2 kernels) and the
+/// COP1 moves and ADD/SUB/MUL.S (with the PS2 float clamping and CSR flags) are translated natively too.
+/// All other instructions (branches, loads/stores, the other MMI and COP1 instructions, COP0/2, etc) are called from
+/// the host code through the interpreter implementations, so every instruction is supported.
+/// Code outside of plain memory is not cacheable, and is run through the interpreter instead.
+class CEeCoreRecompiler : public CEeCoreInterpreter
+{
+public:
+    CEeCoreRecompiler(Core* core);
+
+    /// Steps through the EE Core state, running one block of instructions.
+    int time_step(const int ticks_available) override;
+
+    /// Returns if the host is able to run recompiled code.
+    static constexpr bool is_supported()
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+        return true;
+#else
+        return false;
+#endif
+    }
+
+private:
+    /// Compiled code entry point. Returns the number of instructions run, which
+    /// is less than the block length if the block was stopped early.
+    using CompiledCode = int (*)(CEeCoreRecompiler* recompiler, uqword* gpr_base);
+
+    /// A compiled block, which is valid as long as its source (decoded) block has the same page generation.
+    struct CompiledBlock
+    {
+        CompiledCode code;
+        uword page_generation;
+        size_t length;
+        int cycles;
+
+        /// If the last instruction was translated natively, the PC has not been advanced past it yet.
+        bool ends_with_native;
+    };
+
+    /// Caches the guest GPR's (lower 64-bits) in host registers while compiling a block.
+    /// Registers are loaded on first use and written back when evicted or flushed.
+    class RegisterCache
+    {
+    public:
+        RegisterCache(X64Emitter& emitter, const sword* gpr_offsets);
+
+        /// Returns a host register holding the GPR value.
+        X64Emitter::Reg read(const int index);
+
+        /// Returns a host register allocated to the GPR, marked to be written back.
+        /// The existing value is only loaded if modify is used.
+        X64Emitter::Reg write(const int index);
+        X64Emitter::Reg modify(const int index);
+
+        /// Allows registers used by the current instruction to be evicted.
+        void next_instruction();
+
+        /// Writes back all modified registers and forgets all mappings.
+        void flush();
+
+        /// Writes back the GPR if modified, keeping it cached (ie: before the full GPR is read from memory).
+        void store(const int index);
+
+        /// Forgets the GPR without writing it back (ie: after the full GPR is written to memory).
+        void discard(const int index);
+
+        /// Writes back all modified registers without changing the cache state, for code paths leaving the block.
+        void store_all();
+
+    private:
+        struct Slot
+        {
+            X64Emitter::Reg host;
+            int index;
+            bool dirty;
+            bool locked;
+            size_t last_use;
+        };
+
+        /// Host registers available for caching.
+        /// These are either caller-saved or saved by the block prologue.
+        static constexpr int NUMBER_SLOTS = 6;
+        Slot slots[NUMBER_SLOTS];
+
+        X64Emitter& emitter;
+        const sword* gpr_offsets;
+        size_t use_counter;
+
+        Slot& allocate(const int index, const bool load);
+    };
+
+    /// Compiled blocks, keyed by physical address, and the memory backing them.
+    std::unordered_map<uptr, CompiledBlock> compiled_blocks;
+    ExecutableMemory code_memory;
+
+    /// State for the block currently running, used by run_interpreted().
+    DecodedBlockCache::Block* active_block;
+    uptr active_pc;
+    std::exception_ptr pending_exception;
+
+    /// Returns the compiled block for the decoded block, compiling it if needed.
+    const CompiledBlock& get_compiled_block(const DecodedBlockCache::Block& block);
+
+    /// Translates the decoded block into host code.
+    CompiledBlock compile_block(const DecodedBlockCache::Block& block);
+
+    /// Emits host code for the instruction, returns false if it is not supported natively.
+    /// Exits from the block (see emit_cop1_usable_check()) are added to stop_labels.
+    bool compile_native(X64Emitter& e, RegisterCache& cache, const DecodedInstruction& decoded, const size_t index, const bool is_last, std::vector<size_t>& stop_labels);
+    bool compile_native_mmi(X64Emitter& e, RegisterCache& cache, const DecodedInstruction& decoded);
+    bool compile_native_cop1(X64Emitter& e, RegisterCache& cache, const DecodedInstruction& decoded, const size_t index, std::vector<size_t>& stop_labels);
+
+    /// Emits the COP1 usable check for the instruction. If not usable, the instruction is run through the
+    /// interpreter (raising the exception) and the block is stopped, so this is not used for the last
+    /// instruction of a block (the PC would be advanced twice, see CompiledBlock::ends_with_native).
+    void emit_cop1_usable_check(X64Emitter& e, RegisterCache& cache, const size_t index, std::vector<size_t>& stop_labels);
+
+    /// Returns the offset of the resource from the GPR base (all resources are within RResources).
+    sword get_base_offset(const void* address);
+
+    /// Called from compiled code to run an instruction through the interpreter.
+    /// Handles the PC like the interpreter does, and returns false if the block
+    /// should be stopped (exception raised, block invalidated, or interrupt check requested).
+    static bool run_interpreted(CEeCoreRecompiler* recompiler, const int index);
+};
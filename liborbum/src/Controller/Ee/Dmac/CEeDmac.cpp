@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <cstring>
+
 #include <boost/format.hpp>
 
 #include "Controller/Ee/Dmac/CEeDmac.hpp"
@@ -21,9 +24,11 @@ void CEeDmac::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -56,7 +61,10 @@ int CEeDmac::time_step(const int ticks_available)
 
     // Check if DMA transfers are enabled. If not, DMAC has nothing to do.
     if (!r.ee.dmac.ctrl.extract_field(EeDmacRegister_Ctrl::DMAE))
+    {
+        stats.idle_ticks++;
         return 1;
+    }
 
     // Check for any pending/started DMA transfers and perform transfer if enabled.
     for (auto& channel : r.ee.dmac.channels)
@@ -99,8 +107,20 @@ int CEeDmac::time_step(const int ticks_available)
     return 1;
 }
 
-int CEeDmac::transfer_data(EeDmacChannel& channel)
+int CEeDmac::transfer_data(EeDmacChannel& channel, const size_t max_qwords)
 {
+    // Try to transfer multiple data units at once first, otherwise transfer one through the bus.
+    if (max_qwords > 1)
+    {
+        const std::uint64_t t1 = TraceRecorder::begin();
+        if (const int count = transfer_data_burst(channel, max_qwords))
+        {
+            stats.dma_bytes += count * NUMBER_BYTES_IN_QWORD;
+            TraceRecorder::record("EeDmac burst", "dma", t1, PerfCounters::read_cycles(), "bytes", count * NUMBER_BYTES_IN_QWORD);
+            return count;
+        }
+    }
+
     // Determine the runtime direction of data flow by checking the CHCR.DIR field.
     Direction direction = channel.chcr->get_direction();
 
@@ -155,6 +175,7 @@ int CEeDmac::transfer_data(EeDmacChannel& channel)
         channel.sadr->offset(NUMBER_BYTES_IN_QWORD);
         channel.qwc->offset(-1);
 
+        stats.dma_bytes += NUMBER_BYTES_IN_QWORD;
         return 1;
     }
     else
@@ -166,7 +187,7 @@ int CEeDmac::transfer_data(EeDmacChannel& channel)
             if (!channel.dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
                 return 0;
             uqword packet;
-            channel.dma_fifo_queue->read(reinterpret_cast<ubyte*>(&packet), NUMBER_BYTES_IN_QWORD);
+            channel.dma_fifo_queue->read_uqwords(&packet, 1);
             write_qword_memory(address, spr_flag, packet);
 
 #if DEBUG_LOG_EE_DMAC_XFERS
@@ -182,7 +203,7 @@ int CEeDmac::transfer_data(EeDmacChannel& channel)
             if (!channel.dma_fifo_queue->has_write_available(NUMBER_BYTES_IN_QWORD))
                 return 0;
             uqword packet = read_qword_memory(address, spr_flag);
-            channel.dma_fifo_queue->write(reinterpret_cast<const ubyte*>(&packet), NUMBER_BYTES_IN_QWORD);
+            channel.dma_fifo_queue->write_uqwords(&packet, 1);
 
 #if DEBUG_LOG_EE_DMAC_XFERS
             BOOST_LOG(Core::get_logger()) << boost::format("EE DMAC Write uqword channel %d, w0 = 0x%08X, w1 = 0x%08X, w2 = 0x%08X, w3 = 0x%08X <---- mem_addr = 0x%08X")
@@ -200,10 +221,98 @@ int CEeDmac::transfer_data(EeDmacChannel& channel)
         channel.madr->offset(NUMBER_BYTES_IN_QWORD);
         channel.qwc->offset(-1);
 
+        stats.dma_bytes += NUMBER_BYTES_IN_QWORD;
         return 1;
     }
 }
 
+int CEeDmac::transfer_data_burst(EeDmacChannel& channel, const size_t max_qwords)
+{
+    auto& r = core->get_resources();
+
+    // See transfer_data() for the address masks.
+    const Direction direction = channel.chcr->get_direction();
+    const bool spr_flag = channel.madr->extract_field(EeDmacChannelRegister_Addr::SPR) > 0;
+    const uword address = channel.madr->extract_field(EeDmacChannelRegister_Addr::ADDR) & 0x1FFFFFF0;
+
+    size_t count = max_qwords;
+    if (*channel.channel_id == 8 || *channel.channel_id == 9)
+    {
+        // mem <-> SPR, bounded by the end of the SPR as the address wraps around.
+        const uptr spr_address = channel.sadr->read_uword() & 0x3FF0;
+        count = std::min(count, static_cast<size_t>((0x4000 - spr_address) / NUMBER_BYTES_IN_QWORD));
+        const size_t length = count * NUMBER_BYTES_IN_QWORD;
+
+        ubyte* memory = r.ee.bus.get_host_range(address, length, direction == Direction::FROM);
+        ubyte* spr_memory = r.ee.bus.get_host_range(0x70000000 + spr_address, length, direction == Direction::TO);
+        if (!memory || !spr_memory)
+            return 0;
+
+        if (direction == Direction::FROM)
+        {
+            std::memcpy(memory, spr_memory, length);
+            r.ee.bus.notify_host_range_written(address, length);
+        }
+        else if (direction == Direction::TO)
+        {
+            std::memcpy(spr_memory, memory, length);
+            r.ee.bus.notify_host_range_written(0x70000000 + spr_address, length);
+        }
+        else
+        {
+            throw std::runtime_error("EE DMAC could not determine transfer direction (SPR)! Please debug.");
+        }
+
+        channel.madr->offset(static_cast<sword>(length));
+        channel.sadr->offset(static_cast<sword>(length));
+        channel.qwc->offset(-static_cast<sword>(count));
+
+        return static_cast<int>(count);
+    }
+    else
+    {
+        // mem <-> FIFO, bounded by the data/space available in the FIFO.
+        if (direction == Direction::FROM)
+            count = std::min(count, channel.dma_fifo_queue->read_available() / NUMBER_BYTES_IN_QWORD);
+        else if (direction == Direction::TO)
+            count = std::min(count, channel.dma_fifo_queue->write_available() / NUMBER_BYTES_IN_QWORD);
+        else
+            throw std::runtime_error("EE DMAC could not determine transfer direction! Please debug.");
+
+        if (!count)
+            return 0;
+
+        const size_t length = count * NUMBER_BYTES_IN_QWORD;
+        const uptr bus_address = spr_flag ? (0x70000000 + address) : address;
+        ubyte* memory = r.ee.bus.get_host_range(bus_address, length, direction == Direction::FROM);
+        if (!memory)
+            return 0;
+
+        if (direction == Direction::FROM)
+        {
+            channel.dma_fifo_queue->read(memory, length);
+            r.ee.bus.notify_host_range_written(bus_address, length);
+        }
+        else
+        {
+            channel.dma_fifo_queue->write(memory, length);
+        }
+
+        channel.madr->offset(static_cast<sword>(length));
+        channel.qwc->offset(-static_cast<sword>(count));
+
+        return static_cast<int>(count);
+    }
+}
+
+size_t CEeDmac::get_max_transfer_qwords(EeDmacChannel& channel)
+{
+    if (!core->get_options().eedmac_burst || is_drain_stall_control_on(channel))
+        return 1;
+
+    return std::max(static_cast<size_t>(channel.qwc->read_uword()), static_cast<size_t>(1));
+}
+
 void CEeDmac::set_state_suspended(EeDmacChannel& channel)
 {
     auto& r = core->get_resources();
@@ -262,8 +371,8 @@ bool CEeDmac::transfer_normal(EeDmacChannel& channel)
             return false;
         }
 
-        // Transfer a data unit (128-bits). If no data was transfered, try again next cycle.
-        int count = transfer_data(channel);
+        // Transfer data unit(s) (128-bits). If no data was transfered, try again next cycle.
+        int count = transfer_data(channel, get_max_transfer_qwords(channel));
         if (count == 0)
             return false;
 
@@ -298,8 +407,8 @@ bool CEeDmac::transfer_chain(EeDmacChannel& channel)
                 return false;
             }
 
-            // Transfer a data unit (128-bits). If no data was transfered, try again next cycle.
-            int count = transfer_data(channel);
+            // Transfer data unit(s) (128-bits). If no data was transfered, try again next cycle.
+            int count = transfer_data(channel, get_max_transfer_qwords(channel));
             if (count == 0)
                 return false;
 
@@ -535,7 +644,7 @@ bool CEeDmac::read_chain_source_tag(EeDmacChannel& channel)
         if (!channel.dma_fifo_queue->has_write_available(NUMBER_BYTES_IN_QWORD))
             return false;
         uqword sendTag = uqword(tag.uw[2], tag.uw[3], 0, 0);
-        channel.dma_fifo_queue->write(reinterpret_cast<const ubyte*>(&sendTag), NUMBER_BYTES_IN_QWORD);
+        channel.dma_fifo_queue->write_uqwords(&sendTag, 1);
     }
 
     // Set channel tag based upon the LSB 64-bits of tag.
@@ -559,7 +668,7 @@ bool CEeDmac::read_chain_dest_tag(EeDmacChannel& channel)
     if (!channel.dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
         return false;
     uqword tag;
-    channel.dma_fifo_queue->read(reinterpret_cast<ubyte*>(&tag), NUMBER_BYTES_IN_QWORD);
+    channel.dma_fifo_queue->read_uqwords(&tag, 1);
 
     // Set channel tag based upon the first 2 words read from the channel.
     EeDmatag dma_tag = EeDmatag(tag.uw[0], tag.uw[1]);
@@ -52,10 +52,18 @@ public:
     /// See EE Core Users Manual page 73-75 for the EE Core details. Note that on page 75, there is a typo, where the INTx lines are mixed up on bits 10 and 11 (verified through running through bios code).
     void handle_interrupt_check();
 
-    /// Transfers data units (128-bits) between mem <-> channel.
+    /// Transfers data units (128-bits) between mem <-> channel, up to max_qwords at once.
     /// Returns the number of data units transfered.
     /// On the condition that the channel FIFO is empty (source) or full (drain), returns 0.
-    int transfer_data(EeDmacChannel& channel);
+    int transfer_data(EeDmacChannel& channel, const size_t max_qwords);
+
+    /// Transfers multiple data units at once with a memcpy, used by transfer_data().
+    /// Only possible if the memory is contiguous host memory (see ByteBus::get_host_range()), returns 0 otherwise.
+    int transfer_data_burst(EeDmacChannel& channel, const size_t max_qwords);
+
+    /// Returns the maximum number of data units that can be transfered in one step.
+    /// This is the remaining QWC in burst mode (see CoreOptions), or 1 for per-tick transfers and when drain stall control is on.
+    size_t get_max_transfer_qwords(EeDmacChannel& channel);
 
     /// Sets the DMAC and channel state for suspend conditions.
     void set_state_suspended(EeDmacChannel& channel);
@@ -14,9 +14,11 @@ void CEeIntc::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
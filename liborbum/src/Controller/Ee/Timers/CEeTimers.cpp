@@ -14,9 +14,10 @@ void CEeTimers::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
         for (int i = 0; i < ticks; i++)
             tick_timer(ControllerEvent::Type::Time);
+        stats.ticks += ticks;
         break;
     }
     case ControllerEvent::Type::HBlank:
@@ -120,8 +121,7 @@ void CEeTimers::handle_timer_interrupt(EeTimersUnit& unit)
     // Assert interrupt bit if flag set. IRQ line for timers is 9 -> 12.
     if (interrupt)
     {
-        auto _lock = r.ee.intc.stat.scope_lock();
-        r.ee.intc.stat.insert_field(EeIntcRegister_Stat::TIM_KEYS[*unit.unit_id], 1);
+        r.ee.intc.stat.set_field(EeIntcRegister_Stat::TIM_KEYS[*unit.unit_id]);
     }
 }
 
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <boost/format.hpp>
 
 #include "Controller/Ee/Vpu/Vif/CVif.hpp"
@@ -16,9 +18,11 @@ void CVif::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -49,47 +53,64 @@ int CVif::time_step(const int ticks_available)
 {
     auto& r = core->get_resources();
 
+    // Each unit processes one packet per tick, up to all packets available for this step.
+    // Packets are popped one at a time, as a VIFcode can stall the unit partway through the step.
+    int ticks_used = 1;
+    bool idle = true;
     for (auto& unit : r.ee.vpu.vif.units)
     {
-        // Check if VIF is stalled, do not do anything (FBRST.STC needs to be written to before we continue).
-        if (unit->stat.is_stalled())
-            continue;
-
-        // Check the FIFO queue for incoming DMA packet. Exit early if there is nothing to process.
-        if (!unit->dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
-            continue;
-        uqword packet;
-        unit->dma_fifo_queue->read(reinterpret_cast<ubyte*>(&packet), NUMBER_BYTES_IN_QWORD);
-
-        // We have an incoming DMA unit of data, now we must split it into 4 x 32-bit and process each one. // TODO: check wih pcsx2's code.
-        for (auto& data : packet.uw)
+        const size_t max_packets = std::min(static_cast<size_t>(ticks_available), MAX_PACKETS_PER_STEP);
+        size_t number_packets = 0;
+        while (number_packets < max_packets)
         {
-            // Check the NUM register, to determine if we are continuing a VIFcode instruction instead of reading a VIFcode.
-            if (unit->num.extract_field(VifUnitRegister_Num::NUM))
-            {
-            }
-            else
+            // Check if VIF is stalled, do not do anything (FBRST.STC needs to be written to before we continue).
+            if (unit->stat.is_stalled())
+                break;
+
+            // Check the FIFO queue for incoming DMA packets. Exit early if there is nothing to process.
+            if (!unit->dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
+                break;
+            uqword packet;
+            unit->dma_fifo_queue->read_uqwords(&packet, 1);
+            number_packets++;
+
+            // We have an incoming DMA unit of data, now we must split it into 4 x 32-bit and process each one. // TODO: check wih pcsx2's code.
+            for (auto& data : packet.uw)
             {
-                // Set the current data as the VIFcode.
-                VifcodeInstruction inst = VifcodeInstruction(data);
-
-                // Process the VIFcode by calling the instruction handler.
-                (this->*INSTRUCTION_TABLE[inst.get_info()->impl_index])(unit, inst);
-
-                // If the I bit is set, we need to raise an interrupt after the whole VIF packet has been processed - set a context variable.
-                /*
-                if (instruction.i())
+                // Check the NUM register, to determine if we are continuing a VIFcode instruction instead of reading a VIFcode.
+                if (unit->num.extract_field(VifUnitRegister_Num::NUM))
                 {
-                    auto _lock = r.ee.intc.stat.scope_lock();
-                    r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VIF, 1);
                 }
-                */
+                else
+                {
+                    // Set the current data as the VIFcode.
+                    VifcodeInstruction inst = VifcodeInstruction(data);
+
+                    // Process the VIFcode by calling the instruction handler.
+                    (this->*INSTRUCTION_TABLE[inst.get_info()->impl_index])(unit, inst);
+
+                    // If the I bit is set, we need to raise an interrupt after the whole VIF packet has been processed - set a context variable.
+                    /*
+                    if (instruction.i())
+                    {
+                        r.ee.intc.stat.set_field(EeIntcRegister_Stat::VIF);
+                    }
+                    */
+                }
             }
         }
+
+        if (number_packets)
+        {
+            ticks_used = std::max(ticks_used, static_cast<int>(number_packets));
+            idle = false;
+        }
     }
 
-    // TODO: different for each unit...
-    return 1;
+    if (idle)
+        stats.idle_ticks++;
+
+    return ticks_used;
 }
 
 void CVif::INSTRUCTION_UNSUPPORTED(VifUnit_Base* unit, const VifcodeInstruction inst)
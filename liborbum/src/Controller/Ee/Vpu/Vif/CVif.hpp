@@ -22,7 +22,9 @@ public:
 
     /// Steps through the VIF core state:
     /// - Check the FIFO queue and process data if available.
+    /// Up to MAX_PACKETS_PER_STEP packets are processed in one go, one per tick, stopping if the unit stalls.
     int time_step(const int ticks_available);
+    static constexpr size_t MAX_PACKETS_PER_STEP = 32;
 
     /// VIFcode handler functions.
     /// See EE Users Manual page 87 onwards.
@@ -3,6 +3,7 @@
 #include "Controller/CController.hpp"
 #include "Resources/Ee/Vpu/Vu/VuInstruction.hpp"
 #include "Resources/Ee/Vpu/Vu/VuUnits.hpp"
+#include "Utilities/VectorFloat.hpp"
 
 class Core;
 
@@ -14,6 +15,12 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
+    /// Not yet implemented, so there is nothing to do on time events.
+    bool is_idle() const override
+    {
+        return true;
+    }
+
     /// Converts a time duration into the number of ticks that would have occurred.
     int time_to_ticks(const double time_us);
 
@@ -29,6 +36,13 @@ public:
     size_t DEBUG_LOOP_COUNTER = 0;
 #endif
 
+    /// Runs a vectorised float op (see vector_float_op()), writing the fields in dest to reg_dest
+    /// and updating the MAC and status flags.
+    void execute_float_op(VuUnit_Base* unit, const ubyte dest, SizedQwordRegister& reg_dest, const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c = uqword());
+
+    /// Dest field mask for the outer product instructions (OPMULA/OPMSUB), which always operate on x, y and z.
+    static constexpr ubyte OP_DEST_XYZ = 0b1110;
+
     ///////////////////////////////
     // Instruction Functionality //
     ///////////////////////////////
@@ -7,6 +7,7 @@
 #include "Resources/Ee/Vpu/Vu/VuUnitRegisters.hpp"
 #include "Resources/Ee/Vpu/Vu/VuUnits.hpp"
 #include "Utilities/Utilities.hpp"
+#include "Utilities/VectorFloat.hpp"
 
 // All instructions here are related to float arithmetic.
 // 
@@ -14,6 +15,24 @@
 // VF[x]    - the x-th register of VF
 // VF[x](f) - the f field of the x-th register of VF, if not specified
 //            then the operation is applied to all fields (xyzw)
+//
+// The FMAC instructions operate on all of the fields at once through the
+// vectorised float kernels (see Utilities/VectorFloat.hpp).
+
+void CVuInterpreter::execute_float_op(VuUnit_Base* unit, const ubyte dest, SizedQwordRegister& reg_dest, const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c)
+{
+    FpuVectorFlags product_flags;
+    FpuVectorFlags flags;
+    const uqword result = vector_float_op(op, a, b, c, dest, product_flags, flags);
+
+    // According to the VU manual, for MADD/MSUB the MAC flag and status flag are set according
+    // to the final result, and the sticky flags indicate the exceptions raised during multiplication.
+    if (op == VectorFloatOp::MADD || op == VectorFloatOp::MSUB)
+        unit->mac.update_vector_fields(product_flags);
+    unit->mac.update_vector_fields(flags);
+
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), result, dest));
+}
 
 void CVuInterpreter::ABS(VuUnit_Base* unit, const VuInstruction inst)
 {
@@ -22,23 +41,8 @@ void CVuInterpreter::ABS(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source = unit->vf[inst.fs()];
     SizedQwordRegister& reg_dest = unit->vf[inst.ft()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            // std::abs uses compiler intrinsics internally, and hence it's
-            // sometimes faster than bit ops ...
-            // const f32 val = reg_source.read_float(field);
-            // const f32 result = to_ps2_float(std::abs(val), flags);
-
-            // ... but it might screw the PS2 floats out, so we do bit ops by
-            // ANDing the value with 0x7FFFFFFF, setting the first bit to 0 (positive).
-            const uword raw = reg_source.read_uword(field) & 0x7FFFFFFF;
-            const f32 result = *reinterpret_cast<const f32*>(&raw);
-
-            reg_dest.write_float(field, result);
-        }
-    }
+    // Bit ops (ANDing the value with 0x7FFFFFFF) rather than std::abs, which might screw the PS2 floats out.
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_abs(reg_source.read_uqword()), inst.dest()));
 }
 
 void CVuInterpreter::ADD(VuUnit_Base* unit, const VuInstruction inst)
@@ -49,22 +53,9 @@ void CVuInterpreter::ADD(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDi(VuUnit_Base* unit, const VuInstruction inst)
@@ -75,22 +66,9 @@ void CVuInterpreter::ADDi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDq(VuUnit_Base* unit, const VuInstruction inst)
@@ -101,22 +79,9 @@ void CVuInterpreter::ADDq(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->q;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -129,22 +94,9 @@ void CVuInterpreter::ADDbc(VuUnit_Base* unit, const VuInstruction inst, const in
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -179,22 +131,9 @@ void CVuInterpreter::ADDA(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDAi(VuUnit_Base* unit, const VuInstruction inst)
@@ -205,22 +144,9 @@ void CVuInterpreter::ADDAi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDAq(VuUnit_Base* unit, const VuInstruction inst)
@@ -231,22 +157,9 @@ void CVuInterpreter::ADDAq(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->q;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -259,22 +172,9 @@ void CVuInterpreter::ADDAbc(VuUnit_Base* unit, const VuInstruction inst, const i
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a + b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::ADD, a, b);
 }
 
 void CVuInterpreter::ADDAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -309,20 +209,9 @@ void CVuInterpreter::SUB(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_1 = unit->vf[inst.fs()];
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-            unit->mac.clear_vector_field(field);
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBi(VuUnit_Base* unit, const VuInstruction inst)
@@ -333,22 +222,9 @@ void CVuInterpreter::SUBi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBq(VuUnit_Base* unit, const VuInstruction inst)
@@ -359,22 +235,9 @@ void CVuInterpreter::SUBq(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->q;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -387,22 +250,9 @@ void CVuInterpreter::SUBbc(VuUnit_Base* unit, const VuInstruction inst, const in
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -437,22 +287,9 @@ void CVuInterpreter::SUBA(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBAi(VuUnit_Base* unit, const VuInstruction inst)
@@ -463,22 +300,9 @@ void CVuInterpreter::SUBAi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBAq(VuUnit_Base* unit, const VuInstruction inst)
@@ -489,22 +313,9 @@ void CVuInterpreter::SUBAq(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->q;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -517,22 +328,9 @@ void CVuInterpreter::SUBAbc(VuUnit_Base* unit, const VuInstruction inst, const i
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a - b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::SUB, a, b);
 }
 
 void CVuInterpreter::SUBAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -567,22 +365,9 @@ void CVuInterpreter::MUL(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULi(VuUnit_Base* unit, const VuInstruction inst)
@@ -593,22 +378,9 @@ void CVuInterpreter::MULi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULq(VuUnit_Base* unit, const VuInstruction inst)
@@ -619,22 +391,9 @@ void CVuInterpreter::MULq(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->q;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];    
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -647,22 +406,9 @@ void CVuInterpreter::MULbc(VuUnit_Base* unit, const VuInstruction inst, const in
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -697,22 +443,9 @@ void CVuInterpreter::MULA(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULAi(VuUnit_Base* unit, const VuInstruction inst)
@@ -723,22 +456,9 @@ void CVuInterpreter::MULAi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULAq(VuUnit_Base* unit, const VuInstruction inst)
@@ -749,22 +469,9 @@ void CVuInterpreter::MULAq(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->q;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -777,22 +484,9 @@ void CVuInterpreter::MULAbc(VuUnit_Base* unit, const VuInstruction inst, const i
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 result = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::MULAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -828,31 +522,10 @@ void CVuInterpreter::MADD(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-
-            // According to the VU manual,
-            // MAC flag and status flag are set according to the final result
-            // and the sticky flags indicate the exceptions raised during multiplication
-            const f32 multiplied = to_ps2_float(a * b, flags);
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDi(VuUnit_Base* unit, const VuInstruction inst)
@@ -864,28 +537,10 @@ void CVuInterpreter::MADDi(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDq(VuUnit_Base* unit, const VuInstruction inst)
@@ -897,28 +552,10 @@ void CVuInterpreter::MADDq(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -932,28 +569,10 @@ void CVuInterpreter::MADDbc(VuUnit_Base* unit, const VuInstruction inst, const i
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -989,28 +608,10 @@ void CVuInterpreter::MADDA(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDAi(VuUnit_Base* unit, const VuInstruction inst)
@@ -1022,28 +623,10 @@ void CVuInterpreter::MADDAi(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDAq(VuUnit_Base* unit, const VuInstruction inst)
@@ -1055,28 +638,10 @@ void CVuInterpreter::MADDAq(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -1090,28 +655,10 @@ void CVuInterpreter::MADDAbc(VuUnit_Base* unit, const VuInstruction inst, const
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c + multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MADD, a, b, c);
 }
 
 void CVuInterpreter::MADDAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1147,28 +694,10 @@ void CVuInterpreter::MSUB(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBi(VuUnit_Base* unit, const VuInstruction inst)
@@ -1180,28 +709,10 @@ void CVuInterpreter::MSUBi(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBq(VuUnit_Base* unit, const VuInstruction inst)
@@ -1213,28 +724,10 @@ void CVuInterpreter::MSUBq(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -1248,28 +741,10 @@ void CVuInterpreter::MSUBbc(VuUnit_Base* unit, const VuInstruction inst, const i
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1305,28 +780,10 @@ void CVuInterpreter::MSUBA(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBAi(VuUnit_Base* unit, const VuInstruction inst)
@@ -1338,28 +795,10 @@ void CVuInterpreter::MSUBAi(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBAq(VuUnit_Base* unit, const VuInstruction inst)
@@ -1371,28 +810,10 @@ void CVuInterpreter::MSUBAq(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_3 = unit->acc;
     SizedQwordRegister& reg_dest = unit->acc;
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBAbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -1406,28 +827,10 @@ void CVuInterpreter::MSUBAbc(VuUnit_Base* unit, const VuInstruction inst, const
     // const ubyte bc = inst.bc();
     const ubyte bc = static_cast<ubyte>(idx);
 
-    FpuFlags flags;
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            const f32 c = reg_source_3.read_float(field);
-            
-            const f32 multiplied = to_ps2_float(a * b, flags); // See MADD for details
-            unit->mac.update_vector_field(field, flags);
-
-            const f32 result = to_ps2_float(c - multiplied, flags);
-            unit->mac.update_vector_field(field, flags);
-            
-            reg_dest.write_float(field, result);
-        }
-        else
-        {
-            unit->mac.clear_vector_field(field);
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    const uqword c = reg_source_3.read_uqword();
+    execute_float_op(unit, inst.dest(), reg_dest, VectorFloatOp::MSUB, a, b, c);
 }
 
 void CVuInterpreter::MSUBAbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1462,15 +865,9 @@ void CVuInterpreter::MAX(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            reg_dest.write_float(field, std::max(a, b));
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_max(a, b), inst.dest()));
 }
 
 void CVuInterpreter::MAXi(VuUnit_Base* unit, const VuInstruction inst)
@@ -1481,15 +878,9 @@ void CVuInterpreter::MAXi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            reg_dest.write_float(field, std::max(a, b));
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_max(a, b), inst.dest()));
 }
 
 void CVuInterpreter::MAXbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -1502,15 +893,9 @@ void CVuInterpreter::MAXbc(VuUnit_Base* unit, const VuInstruction inst, const in
 
     const ubyte bc = static_cast<ubyte>(idx);
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            reg_dest.write_float(field, std::max(a, b));
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_max(a, b), inst.dest()));
 }
 
 void CVuInterpreter::MAXbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1545,15 +930,9 @@ void CVuInterpreter::MINI(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& reg_source_2 = unit->vf[inst.ft()];
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(field);
-            reg_dest.write_float(field, std::min(a, b));
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = reg_source_2.read_uqword();
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_min(a, b), inst.dest()));
 }
 
 void CVuInterpreter::MINIi(VuUnit_Base* unit, const VuInstruction inst)
@@ -1564,15 +943,9 @@ void CVuInterpreter::MINIi(VuUnit_Base* unit, const VuInstruction inst)
     SizedWordRegister& reg_source_2 = unit->i;
     SizedQwordRegister& reg_dest = unit->vf[inst.fd()];
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float();
-            reg_dest.write_float(field, std::min(a, b));
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword());
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_min(a, b), inst.dest()));
 }
 
 void CVuInterpreter::MINIbc(VuUnit_Base* unit, const VuInstruction inst, const int idx)
@@ -1585,15 +958,9 @@ void CVuInterpreter::MINIbc(VuUnit_Base* unit, const VuInstruction inst, const i
 
     const ubyte bc = static_cast<ubyte>(idx);
 
-    for (auto field : VuVectorField::VECTOR_FIELDS)
-    {
-        if (inst.test_dest_field(field))
-        {
-            const f32 a = reg_source_1.read_float(field);
-            const f32 b = reg_source_2.read_float(bc);
-            reg_dest.write_float(field, std::min(a, b));
-        }
-    }
+    const uqword a = reg_source_1.read_uqword();
+    const uqword b = vector_float_broadcast(reg_source_2.read_uword(bc));
+    reg_dest.write_uqword(vector_float_merge(reg_dest.read_uqword(), vector_float_min(a, b), inst.dest()));
 }
 
 void CVuInterpreter::MINIbc_0(VuUnit_Base* unit, const VuInstruction inst)
@@ -1630,18 +997,9 @@ void CVuInterpreter::OPMULA(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& ft = unit->vf[inst.ft()];
     SizedQwordRegister& acc = unit->acc;
 
-    FpuFlags flags;
-
-    acc.write_float(VuVectorField::X, to_ps2_float(fs.read_float(VuVectorField::Y) * ft.read_float(VuVectorField::Z), flags));
-    unit->mac.update_vector_field(VuVectorField::X, flags);
-
-    acc.write_float(VuVectorField::Y, to_ps2_float(fs.read_float(VuVectorField::Z) * ft.read_float(VuVectorField::X), flags));
-    unit->mac.update_vector_field(VuVectorField::Y, flags);
-
-    acc.write_float(VuVectorField::Z, to_ps2_float(fs.read_float(VuVectorField::X) * ft.read_float(VuVectorField::Y), flags));
-    unit->mac.update_vector_field(VuVectorField::Z, flags);
-
-    unit->mac.clear_vector_field(VuVectorField::W);
+    const uqword a(fs.read_uword(VuVectorField::Y), fs.read_uword(VuVectorField::Z), fs.read_uword(VuVectorField::X), 0);
+    const uqword b(ft.read_uword(VuVectorField::Z), ft.read_uword(VuVectorField::X), ft.read_uword(VuVectorField::Y), 0);
+    execute_float_op(unit, OP_DEST_XYZ, acc, VectorFloatOp::MUL, a, b);
 }
 
 void CVuInterpreter::OPMSUB(VuUnit_Base* unit, const VuInstruction inst)
@@ -1655,17 +1013,9 @@ void CVuInterpreter::OPMSUB(VuUnit_Base* unit, const VuInstruction inst)
     SizedQwordRegister& ft = unit->vf[inst.ft()];
     SizedQwordRegister& acc = unit->acc;
 
-    FpuFlags flags;
-    fd.write_float(VuVectorField::X, to_ps2_float(acc.read_float(VuVectorField::X) - fs.read_float(VuVectorField::Y) * ft.read_float(VuVectorField::Z), flags));
-    unit->mac.update_vector_field(VuVectorField::X, flags);
-
-    fd.write_float(VuVectorField::Y, to_ps2_float(acc.read_float(VuVectorField::Y) - fs.read_float(VuVectorField::Z) * ft.read_float(VuVectorField::X), flags));
-    unit->mac.update_vector_field(VuVectorField::Y, flags);
-
-    fd.write_float(VuVectorField::Z, to_ps2_float(acc.read_float(VuVectorField::Z) - fs.read_float(VuVectorField::X) * ft.read_float(VuVectorField::Y), flags));
-    unit->mac.update_vector_field(VuVectorField::Z, flags);
-
-    unit->mac.clear_vector_field(VuVectorField::W);
+    const uqword a(fs.read_uword(VuVectorField::Y), fs.read_uword(VuVectorField::Z), fs.read_uword(VuVectorField::X), 0);
+    const uqword b(ft.read_uword(VuVectorField::Z), ft.read_uword(VuVectorField::X), ft.read_uword(VuVectorField::Y), 0);
+    execute_float_op(unit, OP_DEST_XYZ, fd, VectorFloatOp::OPMSUB, a, b, acc.read_uqword());
 }
 
 void CVuInterpreter::DIV(VuUnit_Base* unit, const VuInstruction inst)
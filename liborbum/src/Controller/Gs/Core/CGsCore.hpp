@@ -9,6 +9,12 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
+    /// Not yet implemented, so there is nothing to do on time events.
+    bool is_idle() const override
+    {
+        return true;
+    }
+
     /// Converts a time duration into the number of ticks that would have occurred.
     int time_to_ticks(const double time_us);
 
@@ -7,7 +7,8 @@
 #include "Resources/RResources.hpp"
 
 CCrtc::CCrtc(Core* core) :
-    CController(core)
+    CController(core),
+    ticks_elapsed(0)
 {
 }
 
@@ -18,8 +19,14 @@ void CCrtc::handle_event(const ControllerEvent& event)
     case ControllerEvent::Type::Time:
     {
         int ticks_remaining = time_to_ticks(event.data.time_us);
+        ticks_elapsed = 0;
         while (ticks_remaining > 0)
-            ticks_remaining -= time_step(ticks_remaining);
+        {
+            const int ticks = time_step(ticks_remaining);
+            ticks_remaining -= ticks;
+            ticks_elapsed += ticks;
+        }
+        stats.ticks += ticks_elapsed;
         break;
     }
     default:
@@ -49,11 +56,10 @@ int CCrtc::time_to_ticks(const double time_us)
 int CCrtc::time_step(const int ticks_available)
 {
     auto& r = core->get_resources();
+    auto& col = r.gs.crtc.column;
+    auto& row = r.gs.crtc.row;
 
     // TODO: quick hack to get started...
-    static int col = 0;
-    static int row = 0;
-
     if (col == -1)
     {
         // Send HBlank end.
@@ -65,22 +71,29 @@ int CCrtc::time_step(const int ticks_available)
     {
         col = -640;
 
-        // Send HBlank start.
+        // Send HBlank start. The first one is sent immediately, after which the next one is
+        // scheduled a scanline ahead, so the timers receive it at the correct emulated time.
         auto hblank_event = ControllerEvent{ControllerEvent::Type::HBlank, 1};
-        core->enqueue_controller_event(ControllerType::Type::EeTimers, hblank_event);
-        core->enqueue_controller_event(ControllerType::Type::IopTimers, hblank_event);
+        if (!r.gs.crtc.hblank_scheduled)
+        {
+            core->enqueue_controller_event(ControllerType::Type::EeTimers, hblank_event);
+            core->enqueue_controller_event(ControllerType::Type::IopTimers, hblank_event);
+            r.gs.crtc.hblank_scheduled = true;
+        }
+
+        const double ticks_per_us = Constants::GS::CRTC::PCRTC_CLK_SPEED_DEFAULT * core->get_options().system_bias_crtc / 1.0e6;
+        const double next_hblank_time_us = core->get_time_us() + (ticks_elapsed + 1 + 2 * 640) / ticks_per_us;
+        core->schedule_controller_event(ControllerType::Type::EeTimers, hblank_event, next_hblank_time_us);
+        core->schedule_controller_event(ControllerType::Type::IopTimers, hblank_event, next_hblank_time_us);
 
         // Copy scanline to host render.
         // core->render_scan_line(&raw_row_pixels);
 
         if (row == -1)
         {
-            auto _ee_lock = r.ee.intc.stat.scope_lock();
-            auto _iop_lock = r.iop.intc.stat.scope_lock();
-
             // Send VBlank end.
-            r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VBOF, 1);
-            r.iop.intc.stat.insert_field(IopIntcRegister_Stat::EVBLANK, 1);
+            r.ee.intc.stat.set_field(EeIntcRegister_Stat::VBOF);
+            r.iop.intc.stat.set_field(IopIntcRegister_Stat::EVBLANK);
             //BOOST_LOG(Core::get_logger()) << "EVBLANK fired!";
         }
 
@@ -90,12 +103,9 @@ int CCrtc::time_step(const int ticks_available)
         {
             row = -224;
 
-            auto _ee_lock = r.ee.intc.stat.scope_lock();
-            auto _iop_lock = r.iop.intc.stat.scope_lock();
-
             // Send VBlank start.
-            r.ee.intc.stat.insert_field(EeIntcRegister_Stat::VBON, 1);
-            r.iop.intc.stat.insert_field(IopIntcRegister_Stat::VBLANK, 1);
+            r.ee.intc.stat.set_field(EeIntcRegister_Stat::VBON);
+            r.iop.intc.stat.set_field(IopIntcRegister_Stat::VBLANK);
             //BOOST_LOG(Core::get_logger()) << "VBLANK fired!";
 
             // Tell core to render frame.
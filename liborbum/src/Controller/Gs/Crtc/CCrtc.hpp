@@ -24,4 +24,8 @@ public:
     /// When a row of pixels has been completed (scanline), copy's the row to the VM buffer and sends a HBlank clock event to EE/IOP Timers.
     /// When a whole frame/field has been completed, calls the VM render function and sends a VBlank start/end interrupt to the EE/IOP Intc.
     int time_step(const int ticks_available);
+
+private:
+    /// Number of ticks run so far within the current time event, used to work out the current emulated time.
+    int ticks_elapsed;
 };
\ No newline at end of file
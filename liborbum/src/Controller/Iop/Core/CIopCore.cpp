@@ -7,6 +7,7 @@
 #include <boost/format.hpp>
 
 #include "Common/Options.hpp"
+#include "Common/Types/Mips/MipsSegments.hpp"
 #include "Controller/Iop/Core/Interpreter/CIopCoreInterpreter.hpp"
 #include "Core.hpp"
 #include "Resources/Iop/Dmac/IopDmacConstants.hpp"
@@ -51,9 +52,11 @@ void CIopCore::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -67,6 +70,12 @@ void CIopCore::handle_event(const ControllerEvent& event)
 #endif
 }
 
+void CIopCore::handle_state_loaded()
+{
+    translation_cache_data.flush();
+    translation_cache_inst.flush();
+}
+
 int CIopCore::time_to_ticks(const double time_us)
 {
     int ticks = static_cast<int>(time_us / 1.0e6 * Constants::IOP::IOPCore::IOPCORE_CLK_SPEED * core->get_options().system_bias_iopcore);
@@ -212,7 +221,7 @@ void CIopCore::debug_print_ksprintf()
 
     if (pc == 0x86D0)
     {
-        auto& memory = r.iop.main_memory.get_memory();
+        ubyte* memory = r.iop.main_memory.get_memory();
 
         // Get format string ($a2), replace all newline characters.
         const uptr format_ptr = r.iop.core.r3000.gpr[6].read_uword();
@@ -362,9 +371,17 @@ std::optional<uptr> CIopCore::translate_address_data(const uptr virtual_address,
     }
 #endif
 
+    // Unmapped kernel segments (kseg0/kseg1) are a fixed offset, no need to use the cache.
+    auto& cop0 = r.iop.core.cop0;
+    if (cop0.operating_context() == MipsCoprocessor0::OperatingContext::Kernel)
+    {
+        const auto& segment = MipsSegments::kernel_segment(virtual_address);
+        if (segment.is_unmapped())
+            return std::make_optional(virtual_address - segment.unmapped_base);
+    }
+
     // Check if a write is being performed with isolate cache turned on - don't run through the cache.
-    auto& status = r.iop.core.cop0.status;
-    if (rw_access == WRITE && status.extract_field(IopCoreCop0Register_Status::ISC))
+    if (rw_access == WRITE && cop0.status.extract_field(IopCoreCop0Register_Status::ISC))
         return translate_address_fallback(virtual_address, rw_access);
 
     return translation_cache_data.lookup(virtual_address, rw_access);
@@ -393,6 +410,15 @@ std::optional<uptr> CIopCore::translate_address_inst(const uptr virtual_address)
     }
 #endif
 
+    // Unmapped kernel segments (kseg0/kseg1) are a fixed offset, no need to use the cache.
+    auto& cop0 = core->get_resources().iop.core.cop0;
+    if (cop0.operating_context() == MipsCoprocessor0::OperatingContext::Kernel)
+    {
+        const auto& segment = MipsSegments::kernel_segment(virtual_address);
+        if (segment.is_unmapped())
+            return std::make_optional(virtual_address - segment.unmapped_base);
+    }
+
     return translation_cache_inst.lookup(virtual_address, READ);
 }
 
@@ -21,6 +21,9 @@ public:
 
     void handle_event(const ControllerEvent& event) override;
 
+    /// Flushes the address translation caches.
+    void handle_state_loaded() override;
+
 protected:
 #if defined(BUILD_DEBUG)
     // Debug loop counter
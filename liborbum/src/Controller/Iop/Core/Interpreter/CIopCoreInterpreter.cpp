@@ -59,6 +59,7 @@ int CIopCoreInterpreter::time_step(const int ticks_available)
 
     // Increment PC.
     r.iop.core.r3000.bdelay.advance_pc(r.iop.core.r3000.pc);
+    stats.instructions++;
 
 #if defined(BUILD_DEBUG)
     // Debug increment loop counter.
@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include <boost/format.hpp>
 
 #include "Controller/Iop/Dmac/CIopDmac.hpp"
@@ -20,9 +22,11 @@ void CIopDmac::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -55,7 +59,10 @@ int CIopDmac::time_step(const int ticks_available)
 
     // Check if DMA transfers are enabled. If not, DMAC has nothing to do.
     if (!r.iop.dmac.gctrl.read_uword())
+    {
+        stats.idle_ticks++;
         return 1;
+    }
 
     // Run through each channel that's enabled.
     for (auto& channel : r.iop.dmac.channels)
@@ -86,7 +93,8 @@ int CIopDmac::time_step(const int ticks_available)
             case LogicalMode::LINKEDLIST:
             {
                 // Linked list mode.
-                throw std::runtime_error("IOP DMAC linked list mode not implemented.");
+                transfer_linkedlist(channel);
+                break;
             }
             case LogicalMode::CHAIN:
             {
@@ -135,8 +143,8 @@ bool CIopDmac::transfer_normal_burst(IopDmacChannel& channel)
             return true;
         }
 
-        // Transfer a data unit (32-bits). If no data was transfered, try again next cycle.
-        int count = transfer_data(channel);
+        // Transfer data unit(s) (32-bits). If no data was transfered, try again next cycle.
+        int count = transfer_data(channel, get_max_transfer_words(channel, false));
         if (count == 0)
             return false;
 
@@ -175,8 +183,8 @@ bool CIopDmac::transfer_normal_slice(IopDmacChannel& channel)
             return true;
         }
 
-        // Transfer a data unit (32-bits). If no data was transfered, try again next cycle.
-        int count = transfer_data(channel);
+        // Transfer data unit(s) (32-bits). If no data was transfered, try again next cycle.
+        int count = transfer_data(channel, get_max_transfer_words(channel, true));
         if (count == 0)
             return false;
 
@@ -206,8 +214,8 @@ bool CIopDmac::transfer_chain(IopDmacChannel& channel)
         // Check the transfer size, make sure that size > 0 for a transfer to occur (otherwise read a tag).
         if (channel.bcr->transfer_length > 0)
         {
-            // Transfer a data unit (32-bits). If no data was transfered, try again next cycle.
-            int count = transfer_data(channel);
+            // Transfer data unit(s) (32-bits). If no data was transfered, try again next cycle.
+            int count = transfer_data(channel, get_max_transfer_words(channel, false));
             if (count == 0)
                 return false;
 
@@ -270,6 +278,75 @@ bool CIopDmac::transfer_chain(IopDmacChannel& channel)
     }
 }
 
+bool CIopDmac::transfer_linkedlist(IopDmacChannel& channel)
+{
+    auto& r = core->get_resources();
+
+    // Perform pre-start checks.
+    if (!channel.chcr->dma_started)
+    {
+        // Linked lists are only defined for memory -> peripheral transfers.
+        if (channel.chcr->get_direction() != Direction::TO)
+            throw std::runtime_error("IOP DMAC linked list mode used with a FROM direction - what is meant to happen?");
+
+        // The first node is at MADR.
+        channel.bcr->transfer_length = 0;
+        channel.chcr->dma_tag = IopDmatag(IopDmatag::ADDR.insert_into<uword>(0, channel.madr->read_uword()), 0);
+
+        // Pre checks ok - start the DMA transfer.
+        channel.chcr->dma_started = true;
+        return true;
+    }
+    else
+    {
+        // Transfer the node data first.
+        if (channel.bcr->transfer_length > 0)
+        {
+            // Transfer data unit(s) (32-bits). If no data was transfered, try again next cycle.
+            int count = transfer_data(channel, get_max_transfer_words(channel, false));
+            if (count == 0)
+                return false;
+
+            // Transfer successful, done for this cycle.
+            return true;
+        }
+        else
+        {
+            // Check if the last node was reached.
+            if (channel.chcr->dma_tag.ert())
+            {
+                // Check that the peripheral received the data before interrupting IOP INTC.
+                // Try again until condition is met.
+                if (!channel.dma_fifo_queue->is_empty())
+                    return false;
+
+                // Send interrupt to IOP INTC.
+                set_state_suspended(channel);
+                return true;
+            }
+
+            // Read in the next node header, the data follows it.
+            const uptr node_address = channel.chcr->dma_tag.addr();
+            const uword header = r.iop.bus.read_uword(BusContext::Iop, node_address);
+            const uword next_address = header & 0xFFFFFF;
+            const uword end = (next_address & 0x800000) ? 1 : 0;
+            channel.chcr->dma_tag = IopDmatag(IopDmatag::ERT.insert_into<uword>(IopDmatag::ADDR.insert_into<uword>(0, next_address), end), 0);
+            channel.madr->write_uword(static_cast<uword>(node_address + NUMBER_BYTES_IN_WORD));
+            channel.bcr->transfer_length = header >> 24;
+
+#if DEBUG_LOG_IOP_DMAC_TAGS
+            BOOST_LOG(Core::get_logger()) << boost::format("IOP linked list node read on channel %s, address = 0x%08X, header = 0x%08X.")
+                                                 % *channel.channel_id
+                                                 % node_address
+                                                 % header;
+#endif
+
+            // Node read was successful, done for this cycle.
+            return true;
+        }
+    }
+}
+
 void CIopDmac::handle_interrupt_check()
 {
     auto& r = core->get_resources();
@@ -279,15 +356,26 @@ void CIopDmac::handle_interrupt_check()
     // Check ICR0 and ICR1 for interrupt status, else clear the master interrupt and INTC bits.
     if (r.iop.dmac.icrw.is_interrupt_pending_and_set_master())
     {
-        auto _lock = r.iop.intc.stat.scope_lock();
-        r.iop.intc.stat.insert_field(IopIntcRegister_Stat::DMAC, 1);
+        r.iop.intc.stat.set_field(IopIntcRegister_Stat::DMAC);
     }
 }
 
-int CIopDmac::transfer_data(IopDmacChannel& channel)
+int CIopDmac::transfer_data(IopDmacChannel& channel, const size_t max_words)
 {
     auto& r = core->get_resources();
 
+    // Try to transfer multiple data units at once first, otherwise transfer one through the bus.
+    if (max_words > 1)
+    {
+        const std::uint64_t t1 = TraceRecorder::begin();
+        if (const int count = transfer_data_block(channel, max_words))
+        {
+            stats.dma_bytes += count * NUMBER_BYTES_IN_WORD;
+            TraceRecorder::record("IopDmac block", "dma", t1, PerfCounters::read_cycles(), "bytes", count * NUMBER_BYTES_IN_WORD);
+            return count;
+        }
+    }
+
     // Determine the direction of data flow.
     Direction direction = channel.chcr->get_direction();
 
@@ -342,9 +430,68 @@ int CIopDmac::transfer_data(IopDmacChannel& channel)
     // Update number of word units left (BCR).
     channel.bcr->transfer_length -= 1;
 
+    stats.dma_bytes += NUMBER_BYTES_IN_WORD;
     return 1;
 }
 
+int CIopDmac::transfer_data_block(IopDmacChannel& channel, const size_t max_words)
+{
+    auto& r = core->get_resources();
+
+    // Decrementing MADR transfers are not contiguous in the FIFO order.
+    if (channel.chcr->extract_field(IopDmacChannelRegister_Chcr::MAS) != 0)
+        return 0;
+
+    // Bound the transfer by the data/space available in the FIFO.
+    const Direction direction = channel.chcr->get_direction();
+    size_t count;
+    if (direction == Direction::FROM)
+        count = std::min(max_words, channel.dma_fifo_queue->read_available() / NUMBER_BYTES_IN_WORD);
+    else if (direction == Direction::TO)
+        count = std::min(max_words, channel.dma_fifo_queue->write_available() / NUMBER_BYTES_IN_WORD);
+    else
+        throw std::runtime_error("IOP DMAC could not determine direction! Please debug.");
+
+    if (!count)
+        return 0;
+
+    const uptr address = channel.madr->read_uword();
+    const size_t length = count * NUMBER_BYTES_IN_WORD;
+    ubyte* memory = r.iop.bus.get_host_range(address, length, direction == Direction::FROM);
+    if (!memory)
+        return 0;
+
+    if (direction == Direction::FROM)
+    {
+        channel.dma_fifo_queue->read(memory, length);
+        r.iop.bus.notify_host_range_written(address, length);
+    }
+    else
+    {
+        channel.dma_fifo_queue->write(memory, length);
+    }
+
+    channel.madr->offset(static_cast<sword>(length));
+    channel.bcr->transfer_length -= count;
+
+    return static_cast<int>(count);
+}
+
+size_t CIopDmac::get_max_transfer_words(IopDmacChannel& channel, const bool slice)
+{
+    if (!core->get_options().iopdmac_burst)
+        return 1;
+
+    if (slice)
+    {
+        uword bs = channel.bcr->extract_field(IopDmacChannelRegister_Bcr::BS);
+        bs = (bs > 0) ? bs : 0x10000;
+        return std::min(channel.bcr->transfer_length, static_cast<size_t>(bs));
+    }
+
+    return channel.bcr->transfer_length;
+}
+
 void CIopDmac::set_state_suspended(IopDmacChannel& channel)
 {
     auto& r = core->get_resources();
@@ -382,7 +529,7 @@ bool CIopDmac::read_chain_source_tag(IopDmacChannel& channel)
         if (!channel.dma_fifo_queue->has_write_available(NUMBER_BYTES_IN_QWORD))
             return false;
         uqword ee_tag = uqword(tag.uw[2], tag.uw[3], 0, 0);
-        channel.dma_fifo_queue->write(reinterpret_cast<const ubyte*>(&ee_tag), NUMBER_BYTES_IN_QWORD);
+        channel.dma_fifo_queue->write_uqwords(&ee_tag, 1);
     }
 
     // Set channel.chcr->dma_tag based upon the LSB 64-bits of tag.
@@ -420,7 +567,7 @@ bool CIopDmac::read_chain_dest_tag(IopDmacChannel& channel)
     if (!channel.dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_QWORD))
         return false;
     uqword tag;
-    channel.dma_fifo_queue->read(reinterpret_cast<ubyte*>(&tag), NUMBER_BYTES_IN_QWORD);
+    channel.dma_fifo_queue->read_uqwords(&tag, 1);
 
     // Set channel.chcr->dma_tag based upon the first 2 words read from the channel.
     IopDmatag dma_tag = IopDmatag(tag.uw[0], tag.uw[1]);
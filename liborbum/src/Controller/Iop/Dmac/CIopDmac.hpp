@@ -39,6 +39,12 @@ public:
     /// Do a chain logical mode transfer through the specified DMA channel.
     bool transfer_chain(IopDmacChannel& channel);
 
+    /// Do a linked list logical mode transfer through the specified DMA channel (memory -> peripheral only).
+    /// Each node has a header word (number of words in bits 24-31, next node address in bits 0-23) followed by the data.
+    /// The list ends after a node with bit 23 set in the next address (usually 0xFFFFFF).
+    /// The next node address is kept in the channel DMA tag (ERT set for the end), see nocash PSX docs.
+    bool transfer_linkedlist(IopDmacChannel& channel);
+
     ///////////////////////////
     // DMAC Helper Functions //
     ///////////////////////////
@@ -46,10 +52,18 @@ public:
     /// Checks if there is an DMA transfer interrupt pending, and handles the interrupting of the IOP Core (through the INTC).
     void handle_interrupt_check();
 
-    /// Transfers data units (32-bits) between mem <-> channel.
+    /// Transfers data units (32-bits) between mem <-> channel, up to max_words at once.
     /// Returns the number of data units transfered.
     /// On the condition that the channel FIFO is empty (source) or full (drain), returns 0.
-    int transfer_data(IopDmacChannel& channel);
+    int transfer_data(IopDmacChannel& channel, const size_t max_words);
+
+    /// Transfers multiple data units at once with a memcpy, used by transfer_data().
+    /// Only possible if the memory is contiguous host memory (see ByteBus::get_host_range()) and MADR is incrementing, returns 0 otherwise.
+    int transfer_data_block(IopDmacChannel& channel, const size_t max_words);
+
+    /// Returns the maximum number of data units that can be transfered in one step, given the remaining length.
+    /// In burst mode (see CoreOptions), slice transfers are limited to one block (BCR.BS), otherwise this is 1 (per-tick transfers).
+    size_t get_max_transfer_words(IopDmacChannel& channel, const bool slice);
 
     /// Sets the DMAC and channel state for suspend conditions.
     void set_state_suspended(IopDmacChannel& channel);
@@ -16,9 +16,11 @@ void CSio0::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -107,8 +109,7 @@ void CSio0::handle_irq_check()
     // Raise IOP INTC IRQ if requested.
     if (stat.extract_field(Sio0Register_Stat::IRQ))
     {
-        auto _stat_lock = r.iop.intc.stat.scope_lock();
-        r.iop.intc.stat.insert_field(IopIntcRegister_Stat::SIO0, 1);
+        r.iop.intc.stat.set_field(IopIntcRegister_Stat::SIO0);
     }
 }
 void CSio0::handle_transfer()
@@ -21,9 +21,11 @@ void CSio2::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -140,9 +142,7 @@ void CSio2::handle_port_trasnfer()
     {
         if (ctrl.transfer_direction == Direction::RX)
         {
-            auto& intc_stat = r.iop.intc.stat;
-            auto _intc_lock = intc_stat.scope_lock();
-            intc_stat.insert_field(IopIntcRegister_Stat::SIO2, 1);
+            r.iop.intc.stat.set_field(IopIntcRegister_Stat::SIO2);
         }
 
         ctrl.transfer_started = false;
@@ -14,9 +14,10 @@ void CIopTimers::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
         for (int i = 0; i < ticks; i++)
             tick_timer(ControllerEvent::Type::Time);
+        stats.ticks += ticks;
         break;
     }
     case ControllerEvent::Type::HBlank:
@@ -141,8 +142,7 @@ void CIopTimers::handle_timer_interrupt(IopTimersUnit_Base* unit, const bool has
         if (unit->mode.extract_field(IopTimersUnitRegister_Mode::IRQ_REQUEST) == 0)
         {
             // Raise IRQ.
-            auto _lock = r.iop.intc.stat.scope_lock();
-            r.iop.intc.stat.insert_field(IopIntcRegister_Stat::TMR_KEYS[unit->unit_id], 1);
+            r.iop.intc.stat.set_field(IopIntcRegister_Stat::TMR_KEYS[unit->unit_id]);
         }
     }
 }
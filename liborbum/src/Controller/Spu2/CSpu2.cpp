@@ -1,3 +1,5 @@
+#include <algorithm>
+
 #include "Controller/Spu2/CSpu2.hpp"
 
 #include "Core.hpp"
@@ -15,9 +17,11 @@ void CSpu2::handle_event(const ControllerEvent& event)
     {
     case ControllerEvent::Type::Time:
     {
-        int ticks_remaining = time_to_ticks(event.data.time_us);
+        const int ticks = time_to_ticks(event.data.time_us);
+        int ticks_remaining = ticks;
         while (ticks_remaining > 0)
             ticks_remaining -= time_step(ticks_remaining);
+        stats.ticks += ticks - ticks_remaining;
         break;
     }
     default:
@@ -48,20 +52,21 @@ int CSpu2::time_step(const int ticks_available)
 {
     auto& r = core->get_resources();
 
+    int ticks_used = 1;
     for (auto& spu2_core : r.spu2.cores)
     {
         // For each core, run through DMA transfers and sound generation.
-        handle_dma_transfer(*spu2_core);
+        ticks_used = std::max(ticks_used, handle_dma_transfer(*spu2_core, ticks_available));
         handle_sound_generation(*spu2_core);
 
         // Finally do an interrupt check, and send signal to the IOP INTC if needed.
         handle_interrupt_check(*spu2_core);
     }
 
-    return 1;
+    return ticks_used;
 }
 
-bool CSpu2::handle_dma_transfer(Spu2Core_Base& spu2_core)
+int CSpu2::handle_dma_transfer(Spu2Core_Base& spu2_core, const int max_count)
 {
     // Check which DMA mode we are in, based on the ATTR.DMAMODE bits. Either manual DMA read/writes or auto DMA read/writes are possible.
     // If we are using auto DMA, the ADMAS register still needs to be set properly.
@@ -80,26 +85,26 @@ bool CSpu2::handle_dma_transfer(Spu2Core_Base& spu2_core)
     {
         // Auto DMA write mode.
         if (spu2_core.admas.is_adma_enabled())
-            dma_count = transfer_data_adma_write(spu2_core);
+            dma_count = transfer_data_adma_write(spu2_core, max_count);
         break;
     }
     case 1:
     {
         // Auto DMA read mode.
         if (spu2_core.admas.is_adma_enabled())
-            dma_count = transfer_data_adma_read(spu2_core);
+            dma_count = transfer_data_adma_read(spu2_core, max_count);
         break;
     }
     case 2:
     {
         // Manual DMA write mode.
-        dma_count = transfer_data_mdma_write(spu2_core);
+        dma_count = transfer_data_mdma_write(spu2_core, max_count);
         break;
     }
     case 3:
     {
         // Manual DMA read mode.
-        dma_count = transfer_data_mdma_read(spu2_core);
+        dma_count = transfer_data_mdma_read(spu2_core, max_count);
         break;
     }
     default:
@@ -108,7 +113,7 @@ bool CSpu2::handle_dma_transfer(Spu2Core_Base& spu2_core)
     }
     }
 
-    return (dma_count > 0);
+    return dma_count;
 }
 
 bool CSpu2::handle_sound_generation(Spu2Core_Base& spu2_core)
@@ -120,13 +125,16 @@ bool CSpu2::handle_sound_generation(Spu2Core_Base& spu2_core)
     return true;
 }
 
-int CSpu2::transfer_data_adma_write(Spu2Core_Base& spu2_core)
+int CSpu2::transfer_data_adma_write(Spu2Core_Base& spu2_core, const int max_count)
 {
     // TODO: Check this, its probably wrong. The write addresses are also meant to be used in conjunction with the current read address (double buffer).
     // Note: TSA is not used here! The write addresses are fixed. See pages 13, 28 and 55 of the SPU2 Overview manual.
 
     // Exit early if theres no data to process.
-    if (!spu2_core.dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_HWORD))
+    const size_t count = std::min({spu2_core.dma_fifo_queue->read_available() / NUMBER_BYTES_IN_HWORD,
+                                   static_cast<size_t>(max_count),
+                                   MAX_TRANSFER_HWORDS});
+    if (!count)
     {
         // Set 'no data available' magic values for SPU2 registers (done on each try).
         spu2_core.admas.set_adma_running(false);
@@ -135,55 +143,61 @@ int CSpu2::transfer_data_adma_write(Spu2Core_Base& spu2_core)
     }
 
     // Read in data and set 'data available' magic values for SPU2 registers.
-    uhword data;
-    spu2_core.dma_fifo_queue->read(reinterpret_cast<ubyte*>(&data), NUMBER_BYTES_IN_HWORD);
+    uhword data[MAX_TRANSFER_HWORDS];
+    spu2_core.dma_fifo_queue->read_uhwords(data, count);
     spu2_core.admas.set_adma_running(true);
     spu2_core.statx.insert_field(Spu2CoreRegister_Statx::DREQ, 0);
 
-    // Depending on the current transfer count, we are in the left or right sound channel data block (from SPU2-X/Dma.cpp).
-    // Data incoming is in a striped pattern with 0x100 hwords for the left channel, followed by 0x100 hwords for the right channel, repeated.
-    int block = static_cast<int>(spu2_core.attr.dma_offset / 0x100);
-    bool in_left_block = ((block % 2) == 0);
-    size_t channel_offset;
-    if (in_left_block)
-        channel_offset = spu2_core.attr.dma_offset - (block / 2) * 0x100;
-    else
-        channel_offset = spu2_core.attr.dma_offset - (block / 2 + 1) * 0x100;
-
-    // ADMA is limited to a hword space of 0x100 for each sound channel (left and right), for each buffer (2 total), for a total of 0x100 * 4 address space.
-    // See SPU2 Overview manual page 28.
-    channel_offset %= 0x400;
-
-    // Calculate final address.
-    uptr address;
-    if (in_left_block)
-        address = Spu2CoreConstants::SPU2_STATIC_INFO[spu2_core.core_id].base_tsa_left + static_cast<uptr>(channel_offset);
-    else
-        address = Spu2CoreConstants::SPU2_STATIC_INFO[spu2_core.core_id].base_tsa_right + static_cast<uptr>(channel_offset);
-
-    //log(Debug, "SPU2 core %d ADMA write ATTR.dma_offset = 0x%08X, channel_offset = 0x%08X, address = 0x%08X. FIFO queue size = 0x%X.", spu2_core.core_id, spu2_core.attr.dma_offset, channel_offset, address, spu2_core.FifoQueue->read_available());
-
-    // Write to SPU2 memory.
-    write_hword_memory(spu2_core, address, data);
-
-    // Increment the transfer count.
-    spu2_core.attr.dma_offset += 1;
-
-    // ADMA has completed one transfer.
-    return 1;
+    for (size_t i = 0; i < count; i++)
+    {
+        // Depending on the current transfer count, we are in the left or right sound channel data block (from SPU2-X/Dma.cpp).
+        // Data incoming is in a striped pattern with 0x100 hwords for the left channel, followed by 0x100 hwords for the right channel, repeated.
+        int block = static_cast<int>(spu2_core.attr.dma_offset / 0x100);
+        bool in_left_block = ((block % 2) == 0);
+        size_t channel_offset;
+        if (in_left_block)
+            channel_offset = spu2_core.attr.dma_offset - (block / 2) * 0x100;
+        else
+            channel_offset = spu2_core.attr.dma_offset - (block / 2 + 1) * 0x100;
+
+        // ADMA is limited to a hword space of 0x100 for each sound channel (left and right), for each buffer (2 total), for a total of 0x100 * 4 address space.
+        // See SPU2 Overview manual page 28.
+        channel_offset %= 0x400;
+
+        // Calculate final address.
+        uptr address;
+        if (in_left_block)
+            address = Spu2CoreConstants::SPU2_STATIC_INFO[spu2_core.core_id].base_tsa_left + static_cast<uptr>(channel_offset);
+        else
+            address = Spu2CoreConstants::SPU2_STATIC_INFO[spu2_core.core_id].base_tsa_right + static_cast<uptr>(channel_offset);
+
+        //log(Debug, "SPU2 core %d ADMA write ATTR.dma_offset = 0x%08X, channel_offset = 0x%08X, address = 0x%08X. FIFO queue size = 0x%X.", spu2_core.core_id, spu2_core.attr.dma_offset, channel_offset, address, spu2_core.FifoQueue->read_available());
+
+        // Write to SPU2 memory.
+        write_hword_memory(spu2_core, address, data[i]);
+
+        // Increment the transfer count.
+        spu2_core.attr.dma_offset += 1;
+    }
+
+    // ADMA has completed the transfers.
+    return static_cast<int>(count);
 }
 
-int CSpu2::transfer_data_adma_read(Spu2Core_Base& spu2_core)
+int CSpu2::transfer_data_adma_read(Spu2Core_Base& spu2_core, const int max_count)
 {
     throw std::runtime_error("SPU2 ADMA read not yet implemented. Look into the ATTR.DMAMODE bits, as this might be incorrectly called.");
 }
 
-int CSpu2::transfer_data_mdma_write(Spu2Core_Base& spu2_core)
+int CSpu2::transfer_data_mdma_write(Spu2Core_Base& spu2_core, const int max_count)
 {
     // TODO: Check this!
 
     // Exit early if theres no data to process.
-    if (!spu2_core.dma_fifo_queue->has_read_available(NUMBER_BYTES_IN_HWORD))
+    const size_t count = std::min({spu2_core.dma_fifo_queue->read_available() / NUMBER_BYTES_IN_HWORD,
+                                   static_cast<size_t>(max_count),
+                                   MAX_TRANSFER_HWORDS});
+    if (!count)
     {
         // Set 'no data available' magic values for SPU2 registers.
         spu2_core.statx.insert_field(Spu2CoreRegister_Statx::DREQ, 1);
@@ -191,29 +205,34 @@ int CSpu2::transfer_data_mdma_write(Spu2Core_Base& spu2_core)
     }
 
     // Read in data and set 'data available' magic values for SPU2 registers.
-    uhword data;
-    spu2_core.dma_fifo_queue->read(reinterpret_cast<ubyte*>(&data), NUMBER_BYTES_IN_HWORD);
+    uhword data[MAX_TRANSFER_HWORDS];
+    spu2_core.dma_fifo_queue->read_uhwords(data, count);
     spu2_core.statx.insert_field(Spu2CoreRegister_Statx::DREQ, 0);
 
-    // Calculate write address. Make sure address is not outside 2MB limit (remember, we are addressing by hwords).
+    // Calculate the start address.
     uhword tsal_addr_lo = spu2_core.tsal.read_uhword();
     uhword tsal_addr_hi = spu2_core.tsah.read_uhword();
     uptr tsal_addr = (static_cast<uptr>(tsal_addr_hi) << 16) | tsal_addr_lo;
-    uptr address = static_cast<uptr>((tsal_addr + spu2_core.attr.dma_offset) % 0x100000);
 
-    // Write to SPU2 memory.
-    write_hword_memory(spu2_core, address, data);
+    for (size_t i = 0; i < count; i++)
+    {
+        // Make sure address is not outside 2MB limit (remember, we are addressing by hwords).
+        uptr address = static_cast<uptr>((tsal_addr + spu2_core.attr.dma_offset) % 0x100000);
+
+        // Write to SPU2 memory.
+        write_hword_memory(spu2_core, address, data[i]);
 
-    //log(Debug, "SPU2 core %d ADMA write ATTR.dma_offset = 0x%08X, address = 0x%08X. FIFO queue size = 0x%X.", spu2_core.core_id, spu2_core.attr.dma_offset, address, spu2_core.FifoQueue->read_available());
+        //log(Debug, "SPU2 core %d ADMA write ATTR.dma_offset = 0x%08X, address = 0x%08X. FIFO queue size = 0x%X.", spu2_core.core_id, spu2_core.attr.dma_offset, address, spu2_core.FifoQueue->read_available());
 
-    // Increment the transfer count.
-    spu2_core.attr.dma_offset += 1;
+        // Increment the transfer count.
+        spu2_core.attr.dma_offset += 1;
+    }
 
-    // ADMA has completed one transfer.
-    return 1;
+    // MDMA has completed the transfers.
+    return static_cast<int>(count);
 }
 
-int CSpu2::transfer_data_mdma_read(Spu2Core_Base& spu2_core)
+int CSpu2::transfer_data_mdma_read(Spu2Core_Base& spu2_core, const int max_count)
 {
     throw std::runtime_error("SPU2 MDMA read not yet implemented. Look into the ATTR.DMAMODE bits, as this might be incorrectly called.");
 }
@@ -254,7 +273,6 @@ void CSpu2::handle_interrupt_check(Spu2Core_Base& spu2_core)
         && r.spu2.spdif_irqinfo.extract_field(Spu2Register_Spdif_Irqinfo::IRQ_KEYS[spu2_core.core_id]))
     {
         // IRQ was set, notify the IOP INTC.
-        auto _lock = r.iop.intc.stat.scope_lock();
-        r.iop.intc.stat.insert_field(IopIntcRegister_Stat::SPU, 1);
+        r.iop.intc.stat.set_field(IopIntcRegister_Stat::SPU);
     }
 }
\ No newline at end of file
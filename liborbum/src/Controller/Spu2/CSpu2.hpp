@@ -32,17 +32,21 @@ public:
 
     /// Checks the DMA status, and initiates transfers if enabled and data is ready.
     /// An IOP interrupt is generated after a buffer has been filled - this is 256 hwords in stereo mode, 512 hwords in mono mode.
-    /// Return value indicates if one or more DMA transfers occurred.
-    bool handle_dma_transfer(Spu2Core_Base& spu2_core);
+    /// Up to max_count hwords are transfered at once (one per tick).
+    /// Returns the number of hwords transfered.
+    int handle_dma_transfer(Spu2Core_Base& spu2_core, const int max_count);
 
-    /// Transfers data between the SPU2 FIFO and the SPU2 memory.
+    /// Transfers data between the SPU2 FIFO and the SPU2 memory, up to max_count hwords in one go.
     /// Returns the number of data packets transfered.
     /// On the condition that the channel FIFO is empty (source) or full (drain), returns 0.
     /// There are separate read/write functions for both manual DMA (MDMA) and auto DMA (ADMA) modes - see inside the functions for more info.
-    int transfer_data_adma_write(Spu2Core_Base& spu2_core);
-    int transfer_data_adma_read(Spu2Core_Base& spu2_core);
-    int transfer_data_mdma_write(Spu2Core_Base& spu2_core);
-    int transfer_data_mdma_read(Spu2Core_Base& spu2_core);
+    int transfer_data_adma_write(Spu2Core_Base& spu2_core, const int max_count);
+    int transfer_data_adma_read(Spu2Core_Base& spu2_core, const int max_count);
+    int transfer_data_mdma_write(Spu2Core_Base& spu2_core, const int max_count);
+    int transfer_data_mdma_read(Spu2Core_Base& spu2_core, const int max_count);
+
+    /// Maximum number of hwords transfered in one go.
+    static constexpr size_t MAX_TRANSFER_HWORDS = 256;
 
     /// Read or write hwords to the SPU2 memory, while automatically setting the core IRQ status if the address is the same as the IRQA register.
     /// Careful: the address supplied is in terms of a hword offset, not byte offset.
@@ -1,9 +1,18 @@
+#include <algorithm>
 #include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
 #include <stdexcept>
 #include <thread>
 
 #include <boost/filesystem.hpp>
 #include <boost/format.hpp>
+#include <boost/iostreams/copy.hpp>
+#include <boost/iostreams/device/back_inserter.hpp>
+#include <boost/iostreams/filter/zlib.hpp>
+#include <boost/iostreams/filtering_stream.hpp>
 #include <boost/log/attributes.hpp>
 #include <boost/log/core.hpp>
 #include <boost/log/sinks/text_file_backend.hpp>
@@ -11,14 +20,20 @@
 #include <boost/log/utility/setup/console.hpp>
 #include <boost/log/utility/setup/file.hpp>
 
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/portable_binary.hpp>
+
 #include <Console.hpp>
 #include <Macros.hpp>
 #include <Datetime.hpp>
 
 #include "Core.hpp"
 
+#include "Common/Types/Memory/ByteMemorySnapshots.hpp"
+#include "Common/Types/TraceRecorder.hpp"
 #include "Controller/Cdvd/CCdvd.hpp"
 #include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
+#include "Controller/Ee/Core/Recompiler/CEeCoreRecompiler.hpp"
 #include "Controller/Ee/Dmac/CEeDmac.hpp"
 #include "Controller/Ee/Gif/CGif.hpp"
 #include "Controller/Ee/Intc/CEeIntc.hpp"
@@ -51,8 +66,21 @@ CoreOptions CoreOptions::make_default()
         "",
         "",
         10,
+        false,
+        1.0,
+        100.0,
         4, //std::thread::hardware_concurrency() - 1,
 
+        false,
+        true,
+        true,
+        true,
+
+        false,
+        false,
+
+        false,
+
         1.0,
         1.0,
         1.0,
@@ -98,18 +126,67 @@ void CoreApi::save_state()
     impl->save_state();
 }
 
+void CoreApi::load_state(const std::string& path)
+{
+    impl->load_state(path);
+}
+
+size_t CoreApi::take_snapshot()
+{
+    return impl->take_snapshot();
+}
+
+void CoreApi::restore_snapshot(const size_t index)
+{
+    impl->restore_snapshot(index);
+}
+
+size_t CoreApi::get_snapshot_count() const
+{
+    return impl->get_snapshot_count();
+}
+
+CoreStats CoreApi::get_stats() const
+{
+    return impl->get_stats();
+}
+
+void CoreApi::save_trace(const std::string& path) const
+{
+    impl->save_trace(path);
+}
+
 Core::Core(const CoreOptions& options) :
-    options(options)
+    options(options),
+    time_us(0.0),
+    runs(0),
+    host_time_us(0.0),
+    host_cycles(0),
+    last_time_slice_us(0.0),
+    adaptive_time_slice_us(options.time_slice_per_run_us),
+    adaptive_dma_bytes(0)
 {
     // Initialise logging.
     init_logging();
 
     BOOST_LOG(get_logger()) << "Core initialising... please wait";
 
+    if (options.adaptive_time_slice && !(options.adaptive_time_slice_min_us >= MINIMUM_TIME_SLICE_US && options.adaptive_time_slice_min_us <= options.adaptive_time_slice_max_us))
+        throw std::runtime_error("Invalid adaptive time slice bounds");
+
     // Initialise resources.
     resources = std::make_unique<RResources>();
     initialise_resources(resources);
 
+    // Enable fastmem for the EE bus, before any memory contents are loaded.
+    if (options.fastmem)
+    {
+        auto& r = get_resources();
+        // The ROMs are also mapped on the IOP bus, which follows the relocation (see ByteBus::map()).
+        if (!r.ee.bus.enable_fastmem({&r.ee.main_memory, &r.ee.core.scratchpad_memory, &r.boot_rom, &r.rom1, &r.erom, &r.rom2}))
+            BOOST_LOG(get_logger()) << "Unable to reserve the host address space for fastmem, continuing without it";
+    }
+
     // Initialise roms (boot_rom (required), rom1, rom2, erom).
     const std::string roms_dir_path = options.roms_dir_path;
     const std::string boot_rom_file_name = options.boot_rom_file_name;
@@ -125,8 +202,24 @@ Core::Core(const CoreOptions& options) :
     if (!erom_file_name.empty())
         get_resources().erom.read_from_file(roms_dir_path + erom_file_name, Constants::EE::ROM::SIZE_EROM);
 
+    // Snapshots of the large memories are paged, see take_snapshot().
+    {
+        auto& r = get_resources();
+        memory_snapshots = std::make_unique<ByteMemorySnapshots>(MAXIMUM_SNAPSHOTS);
+        memory_snapshots->add(&r.ee.main_memory);
+        memory_snapshots->add(&r.iop.main_memory);
+        memory_snapshots->add(&r.spu2.main_memory);
+        memory_snapshots->add(&r.boot_rom);
+        memory_snapshots->add(&r.rom1);
+        memory_snapshots->add(&r.erom);
+        memory_snapshots->add(&r.rom2);
+    }
+
     // Initialise controllers.
-    controllers[ControllerType::Type::EeCore] = std::make_unique<CEeCoreInterpreter>(this);
+    if (options.eecore_recompiler && CEeCoreRecompiler::is_supported())
+        controllers[ControllerType::Type::EeCore] = std::make_unique<CEeCoreRecompiler>(this);
+    else
+        controllers[ControllerType::Type::EeCore] = std::make_unique<CEeCoreInterpreter>(this);
     controllers[ControllerType::Type::EeDmac] = std::make_unique<CEeDmac>(this);
     controllers[ControllerType::Type::EeTimers] = std::make_unique<CEeTimers>(this);
     controllers[ControllerType::Type::EeIntc] = std::make_unique<CEeIntc>(this);
@@ -145,8 +238,27 @@ Core::Core(const CoreOptions& options) :
     controllers[ControllerType::Type::Sio0] = std::make_unique<CSio0>(this);
     controllers[ControllerType::Type::Sio2] = std::make_unique<CSio2>(this);
 
-    // Task executor.
-    task_executor = std::make_unique<TaskExecutor>(options.number_workers);
+    // Task executor, or the controller affinity executor (the task executor is then left without workers).
+    if (options.controller_affinity)
+    {
+        auto handler = [this](const ControllerTask& task) {
+            TraceRecorderScope trace_scope(trace_recorder.get());
+            controllers[task.t]->handle_event_marshall_(task.t, task.e);
+        };
+
+        task_executor = std::make_unique<TaskExecutor>(0);
+        affinity_executor = std::make_unique<AffinityExecutor<ControllerTask, 64>>(NUMBER_CONTROLLER_GROUPS, handler, options.pin_controller_threads);
+    }
+    else
+    {
+        task_executor = std::make_unique<TaskExecutor>(options.number_workers);
+    }
+
+    // Tracing, recorded until the core is destroyed.
+    if (options.tracing)
+    {
+        trace_recorder = std::make_unique<TraceRecorder>();
+    }
 
     BOOST_LOG(get_logger()) << "Core initialised";
 }
@@ -163,6 +275,11 @@ boost::log::sources::logger_mt& Core::get_logger()
 
 void Core::run()
 {
+    const auto host_t1 = std::chrono::steady_clock::now();
+    const std::uint64_t host_cycles_t1 = PerfCounters::read_cycles();
+    TraceRecorderScope trace_scope(trace_recorder.get());
+    const std::uint64_t trace_t1 = TraceRecorder::begin();
+
     try
     {
 #if defined(BUILD_DEBUG)
@@ -184,37 +301,84 @@ void Core::run()
             DEBUG_TIME_LOGGED = DEBUG_TIME_ELAPSED;
             DEBUG_T1 = DEBUG_T2;
         }
-        DEBUG_TIME_ELAPSED += options.time_slice_per_run_us;
 #endif
 
-        // Enqueue time events (always done on each run).
-        auto event = ControllerEvent{ControllerEvent::Type::Time, options.time_slice_per_run_us};
-        for (int i = 0; i < static_cast<int>(ControllerType::Type::COUNT); i++) // TODO: find better syntax..
-        {
-            auto controller = static_cast<ControllerType::Type>(i);
-            enqueue_controller_event(controller, event);
-        }
+        // Move newly enqueued events into the scheduler.
+        schedule_enqueued_events();
 
-        // Package events into tasks and send to workers.
-        EventEntry entry;
-        while (controller_event_queue.try_pop(entry))
-        {
-            auto task = [this, entry]() {
-                if (controllers[entry.t])
-                    controllers[entry.t]->handle_event_marshall_(entry.e);
+        // Run until the next scheduled event, bounded by the (adaptive) time slice, but at least the minimum time slice.
+        double time_slice_us = options.adaptive_time_slice ? adaptive_time_slice_us : options.time_slice_per_run_us;
+        if (!controller_scheduler.is_empty())
+            time_slice_us = std::min(controller_scheduler.next_time_us() - time_us, time_slice_us);
+        time_slice_us = std::max(MINIMUM_TIME_SLICE_US, time_slice_us);
+
+#if defined(BUILD_DEBUG)
+        DEBUG_TIME_ELAPSED += time_slice_us;
+#endif
+
+        // Package the due events into tasks and send to workers (or the controller's group thread).
+        auto enqueue_task = [this](const ControllerType::Type t, const ControllerEvent& e) {
+            if (affinity_executor)
+            {
+                affinity_executor->enqueue(CONTROLLER_GROUPS[static_cast<size_t>(t)], {t, e});
+                return;
+            }
+
+            auto task = [this, t, e]() {
+                TraceRecorderScope trace_scope(trace_recorder.get());
+                controllers[t]->handle_event_marshall_(t, e);
             };
 
             task_executor->enqueue_task(task);
+        };
+
+        ControllerScheduler::Entry scheduled;
+        while (controller_scheduler.pop_due(time_us, scheduled))
+        {
+            if (controllers[scheduled.t])
+                enqueue_task(scheduled.t, scheduled.e);
+        }
+
+        // Time events for all controllers which have work to do.
+        auto event = ControllerEvent{ControllerEvent::Type::Time, time_slice_us};
+        for (int i = 0; i < static_cast<int>(ControllerType::Type::COUNT); i++) // TODO: find better syntax..
+        {
+            auto controller = static_cast<ControllerType::Type>(i);
+            if (controllers[controller] && !controllers[controller]->is_idle())
+                enqueue_task(controller, event);
         }
 
         // Dispatch all tasks and wait for resynchronisation.
-        task_executor->dispatch();
-        task_executor->wait_for_idle();
+        {
+            TraceScope trace("wait_for_idle", "core");
+            if (affinity_executor)
+            {
+                affinity_executor->wait_for_idle();
+            }
+            else
+            {
+                task_executor->dispatch();
+                task_executor->wait_for_idle();
+            }
+        }
 
 #if defined(BUILD_DEBUG)
-        if (!task_executor->task_sync.running_task_queue.is_empty() || task_executor->task_sync.thread_busy_counter.busy_counter)
+        if (!task_executor->is_idle() || (affinity_executor && !affinity_executor->is_idle()))
             throw std::runtime_error("Task queue was not empty!");
 #endif
+
+        time_us += time_slice_us;
+        last_time_slice_us = time_slice_us;
+        if (options.adaptive_time_slice)
+            update_adaptive_time_slice();
+
+        const std::chrono::duration<double, std::micro> host_duration = std::chrono::steady_clock::now() - host_t1;
+        host_time_us += host_duration.count();
+        const std::uint64_t host_cycles_t2 = PerfCounters::read_cycles();
+        host_cycles += host_cycles_t2 - host_cycles_t1;
+        runs++;
+
+        TraceRecorder::record("Core::run", "core", trace_t1, host_cycles_t2, "time_slice_us", time_slice_us);
     }
     catch (const std::runtime_error& e)
     {
@@ -223,6 +387,72 @@ void Core::run()
     }
 }
 
+CoreStats Core::get_stats() const
+{
+    const double cycles_per_us = get_cycles_per_us();
+
+    CoreStats stats{};
+    stats.time_us = time_us;
+    stats.host_time_us = host_time_us;
+    stats.cycles_per_us = cycles_per_us;
+    stats.runs = runs;
+    stats.time_slice_us = last_time_slice_us;
+    stats.eecore_pc = get_resources().ee.core.r5900.pc.read_uword();
+    stats.iopcore_pc = get_resources().iop.core.r3000.pc.read_uword();
+
+    for (int i = 0; i < static_cast<int>(ControllerType::Type::COUNT); i++)
+    {
+        auto controller = static_cast<ControllerType::Type>(i);
+        if (controllers[controller])
+        {
+            const auto& counters = controllers[controller]->get_stats();
+            auto& controller_stats = stats.controllers[i];
+            controller_stats.events = counters.events;
+            controller_stats.host_time_us = counters.host_cycles / cycles_per_us;
+            controller_stats.ticks = counters.ticks;
+            controller_stats.idle_ticks = counters.idle_ticks;
+            controller_stats.instructions = counters.instructions;
+            controller_stats.dma_bytes = counters.dma_bytes;
+            std::copy(std::begin(counters.bus_accesses), std::end(counters.bus_accesses), controller_stats.bus_accesses);
+        }
+    }
+
+    return stats;
+}
+
+void Core::update_adaptive_time_slice()
+{
+    auto& r = get_resources();
+
+    // Any bytes moved by the DMAC's since the last run, or any pending (unmasked) interrupts not yet taken by the CPU's.
+    const size_t dma_bytes = controllers[ControllerType::Type::EeDmac]->get_stats().dma_bytes
+                             + controllers[ControllerType::Type::IopDmac]->get_stats().dma_bytes;
+    const bool dma_active = dma_bytes != adaptive_dma_bytes;
+    const bool irq_pending = (r.ee.intc.stat.read_uword() & r.ee.intc.mask.read_uword())
+                             || (r.iop.intc.stat.read_uword() & r.iop.intc.mask.read_uword());
+    adaptive_dma_bytes = dma_bytes;
+
+    const double factor = (dma_active || irq_pending) ? ADAPTIVE_TIME_SLICE_SHRINK : ADAPTIVE_TIME_SLICE_GROWTH;
+    adaptive_time_slice_us = std::clamp(adaptive_time_slice_us * factor, options.adaptive_time_slice_min_us, options.adaptive_time_slice_max_us);
+}
+
+double Core::get_cycles_per_us() const
+{
+    // Before the first run there is nothing to measure against, the counters are all 0 anyway.
+    if (!host_cycles || host_time_us <= 0.0)
+        return 1.0;
+
+    return host_cycles / host_time_us;
+}
+
+void Core::save_trace(const std::string& path) const
+{
+    if (!trace_recorder)
+        throw std::runtime_error("Tracing is not enabled");
+
+    trace_recorder->write(path, get_cycles_per_us());
+}
+
 void Core::dump_all_memory() const
 {
     const std::string dumps_dir_path = options.dumps_dir_path;
@@ -247,15 +477,145 @@ void Core::init_logging()
         boost::log::keywords::format = "[%TimeStamp%]: %Message%");
 }
 
-void Core::save_state() 
+void Core::schedule_enqueued_events()
+{
+    EventEntry entry;
+    while (controller_event_queue.try_pop(entry))
+        controller_scheduler.schedule({entry.time_us, entry.t, entry.e});
+}
+
+template<class Archive>
+void Core::serialize_state(Archive& archive)
+{
+    archive(
+        CEREAL_NVP(time_us),
+        CEREAL_NVP(adaptive_time_slice_us),
+        CEREAL_NVP(controller_scheduler)
+    );
+    archive(get_resources());
+}
+
+void Core::handle_state_loaded()
+{
+    for (int i = 0; i < static_cast<int>(ControllerType::Type::COUNT); i++)
+    {
+        auto controller = static_cast<ControllerType::Type>(i);
+        if (controllers[controller])
+            controllers[controller]->handle_state_loaded();
+    }
+
+    // The adaptive time slice is part of the state, only the DMA activity needs to restart from here.
+    adaptive_dma_bytes = controllers[ControllerType::Type::EeDmac]->get_stats().dma_bytes
+                         + controllers[ControllerType::Type::IopDmac]->get_stats().dma_bytes;
+}
+
+void Core::save_state()
 {
     const std::string save_states_dir_path = options.save_states_dir_path;
     boost::filesystem::create_directory(save_states_dir_path);
 
-    std::ofstream fout(save_states_dir_path + "save_" + datetime_fmt(Core::DATETIME_FORMAT) + ".json", std::ios_base::out);
+    std::ofstream fout(save_states_dir_path + "save_" + datetime_fmt(Core::DATETIME_FORMAT) + ".state", std::ios_base::out | std::ios_base::binary);
     if (!fout)
         throw std::runtime_error("Unable to write file");
 
-    cereal::JSONOutputArchive oarchive(fout);
-    oarchive(get_resources());
+    schedule_enqueued_events();
+
+    {
+        const std::uint32_t version = SAVE_STATE_VERSION;
+        cereal::PortableBinaryOutputArchive header(fout);
+        header(cereal::binary_data(SAVE_STATE_MAGIC, SAVE_STATE_MAGIC_LENGTH), version);
+    }
+
+    // Favour speed over size, most of the state is empty memory which compresses well regardless.
+    boost::iostreams::filtering_ostream out;
+    out.push(boost::iostreams::zlib_compressor(boost::iostreams::zlib::best_speed));
+    out.push(fout);
+    {
+        cereal::PortableBinaryOutputArchive archive(out);
+        serialize_state(archive);
+    }
+    out.reset();
+
+    if (!fout)
+        throw std::runtime_error("Unable to write file");
+}
+
+void Core::load_state(const std::string& path)
+{
+    std::ifstream fin(path, std::ios_base::in | std::ios_base::binary);
+    if (!fin)
+        throw std::runtime_error("Unable to read file");
+
+    char magic[SAVE_STATE_MAGIC_LENGTH];
+    std::uint32_t version;
+    {
+        cereal::PortableBinaryInputArchive header(fin);
+        header(cereal::binary_data(magic, SAVE_STATE_MAGIC_LENGTH), version);
+    }
+
+    if (std::memcmp(magic, SAVE_STATE_MAGIC, SAVE_STATE_MAGIC_LENGTH) != 0)
+        throw std::runtime_error("Not a save state file: " + path);
+    if (version != SAVE_STATE_VERSION)
+        throw std::runtime_error(str(boost::format("Save state version %d is not supported (expected %d)") % version % SAVE_STATE_VERSION));
+
+    // Decompress the whole state up front, so a corrupt file is detected before any state is replaced.
+    std::string state;
+    {
+        boost::iostreams::filtering_istream in;
+        in.push(boost::iostreams::zlib_decompressor());
+        in.push(fin);
+        boost::iostreams::copy(in, boost::iostreams::back_inserter(state));
+    }
+
+    schedule_enqueued_events();
+
+    std::istringstream sin(state);
+    cereal::PortableBinaryInputArchive archive(sin);
+    serialize_state(archive);
+
+    // The snapshots belong to the replaced timeline.
+    memory_snapshots->clear();
+    snapshot_states.clear();
+
+    handle_state_loaded();
+}
+
+size_t Core::take_snapshot()
+{
+    schedule_enqueued_events();
+
+    // The paged memory contents are held by the memory snapshots, everything else is stored in full.
+    std::ostringstream out;
+    {
+        ByteMemorySnapshots::ExcludeContents exclude(*memory_snapshots);
+        cereal::BinaryOutputArchive archive(out);
+        serialize_state(archive);
+    }
+
+    const size_t index = memory_snapshots->take();
+    snapshot_states.push_back(out.str());
+    while (snapshot_states.size() > memory_snapshots->count())
+        snapshot_states.pop_front();
+
+    return index;
+}
+
+void Core::restore_snapshot(const size_t index)
+{
+    if (index >= snapshot_states.size())
+        throw std::runtime_error("Tried to restore a snapshot that does not exist.");
+
+    schedule_enqueued_events();
+
+    {
+        ByteMemorySnapshots::ExcludeContents exclude(*memory_snapshots);
+        std::istringstream in(snapshot_states[index]);
+        cereal::BinaryInputArchive archive(in);
+        serialize_state(archive);
+    }
+
+    memory_snapshots->restore(index);
+    snapshot_states.resize(index + 1);
+
+    handle_state_loaded();
 }
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -9,14 +12,15 @@
 #include <boost/log/sources/logger.hpp>
 #include <boost/log/sources/record_ostream.hpp>
 
-#include <cereal/archives/json.hpp>
-
 #include <EnumMap.hpp>
 #include <Macros.hpp>
+#include <AffinityExecutor.hpp>
 #include <Queues.hpp>
 #include <TaskExecutor.hpp>
 
+#include "Common/Types/PerfCounters.hpp"
 #include "Controller/ControllerEvent.hpp"
+#include "Controller/ControllerScheduler.hpp"
 #include "Controller/ControllerType.hpp"
 
 #ifdef orbum_EXPORTS
@@ -27,6 +31,8 @@
 
 class RResources;
 class CController;
+class ByteMemorySnapshots;
+class TraceRecorder;
 
 /// Core runtime options.
 struct CORE_API CoreOptions
@@ -40,6 +46,22 @@ struct CORE_API CoreOptions
     // - us = microseconds.
     // - Boot ROM is required, other roms are optional -> empty string will cause it to not be loaded.
     // - Speed biases are a ratio, 1.0x is normal speed.
+    // - The EE Core recompiler is only available on x86-64 hosts, the interpreter is used otherwise.
+    // - Fastmem places the EE plain memory (main memory, scratchpad, ROMs) into a reserved host address range,
+    //   and is disabled automatically if the range cannot be reserved.
+    // - EE DMAC burst mode moves up to QWC qwords per step directly between host memory and the FIFO's.
+    //   Turn it off for per-tick (one qword per tick) transfers, ie: when cycle accuracy is needed.
+    //   The IOP DMAC burst mode is the same, moving a whole BCR block (or the whole transfer) per step.
+    // - Controller affinity runs each group of related controllers (see Core::CONTROLLER_GROUPS) on its own
+    //   dedicated thread instead of the worker pool, and number_workers is not used. The threads can further
+    //   be pinned to a host CPU each (Linux only).
+    // - The adaptive time slice grows the time slice of each run (up to the maximum) while the controllers are quiescent,
+    //   and shrinks it (down to the minimum) while interrupts are pending or DMA transfers are running, see Core::run().
+    //   Fewer runs means less synchronisation overhead, while the short runs keep the latency between controllers low
+    //   when it matters. The time slice per run is the starting size in this mode. The minimum can't be lower than
+    //   Core::MINIMUM_TIME_SLICE_US, which also applies to the fixed time slice.
+    // - Tracing records a timeline of the runs, controller events, lock waits and DMA bursts, see save_trace().
+    //   It has a small overhead on each event, so is off by default.
 
     /* Log dir path.             */ const char* logs_dir_path;
     /* Roms dir path.            */ const char* roms_dir_path;
@@ -51,9 +73,22 @@ struct CORE_API CoreOptions
     /* EROM file name.           */ const char* erom_file_name;
 
     /* Time slice per run in us. */ double time_slice_per_run_us;
+    /* Adaptive time slice.      */ bool adaptive_time_slice;
+    /* Adaptive min slice in us. */ double adaptive_time_slice_min_us;
+    /* Adaptive max slice in us. */ double adaptive_time_slice_max_us;
 
     /* Number of worker threads. */ size_t number_workers;
 
+    /* EE Core recompiler.       */ bool eecore_recompiler;
+    /* EE bus fastmem.           */ bool fastmem;
+    /* EE DMAC burst mode.       */ bool eedmac_burst;
+    /* IOP DMAC burst mode.      */ bool iopdmac_burst;
+
+    /* Controller affinity.      */ bool controller_affinity;
+    /* Pin controller threads.   */ bool pin_controller_threads;
+
+    /* Tracing.                  */ bool tracing;
+
     /* EE Core speed bias.       */ double system_bias_eecore;
     /* EE Dmac speed bias.       */ double system_bias_eedmac;
     /* EE Timers speed bias.     */ double system_bias_eetimers;
@@ -74,6 +109,35 @@ struct CORE_API CoreOptions
     /* SIO2 speed bias.          */ double system_bias_sio2;
 };
 
+/// Core runtime statistics and profiling counters, see CoreApi::get_stats().
+/// Counters are totals since the core was created. The host time in runs is a wall clock time, the controller
+/// host times are measured with the host timestamp counter (see PerfCounters), converted using the rate measured over the runs.
+struct CORE_API CoreStats
+{
+    /// Per controller statistics, see PerfCounters.
+    /// Instructions are only counted by the CPU controllers (EE Core, IOP Core), DMA bytes by the DMA controllers.
+    /// Bus accesses are the ones made while running the controller, by region type (see PerfBusRegion).
+    struct Controller
+    {
+        /* Events handled.           */ size_t events;
+        /* Host time in events (us). */ double host_time_us;
+        /* Ticks run.                */ size_t ticks;
+        /* Idle ticks.               */ size_t idle_ticks;
+        /* Instructions run.         */ size_t instructions;
+        /* Bytes moved by DMA.       */ size_t dma_bytes;
+        /* Bus accesses.             */ size_t bus_accesses[static_cast<size_t>(PerfBusRegion::Type::COUNT)];
+    };
+
+    /* Emulated time (us).       */ double time_us;
+    /* Host time in runs (us).   */ double host_time_us;
+    /* Host cycles per us.       */ double cycles_per_us;
+    /* Number of runs.           */ size_t runs;
+    /* Last run time slice (us). */ double time_slice_us;
+    /* EE Core PC.               */ std::uint32_t eecore_pc;
+    /* IOP Core PC.              */ std::uint32_t iopcore_pc;
+    /* Controller statistics.    */ Controller controllers[static_cast<size_t>(ControllerType::Type::COUNT)];
+};
+
 /// Exported Core class interface.
 class CORE_API CoreApi
 {
@@ -84,6 +148,12 @@ public:
     void run();
     void dump_all_memory() const;
     void save_state();
+    void load_state(const std::string& path);
+    size_t take_snapshot();
+    void restore_snapshot(const size_t index);
+    size_t get_snapshot_count() const;
+    CoreStats get_stats() const;
+    void save_trace(const std::string& path) const;
 
 private:
     class Core* impl;
@@ -93,11 +163,57 @@ private:
 /// This is the manager for the PS2's execution.
 /// Execution occurs in synchronised blocks - the core waits until all events
 /// are processed by the controllers before dispatching any new ones.
+/// Each block runs until the next scheduled event (bounded by the time slice
+/// option), and idle controllers are skipped.
 class Core
 {
 public:
     static constexpr const char * DATETIME_FORMAT = "%Y-%m-%d_%H-%M-%S";
-    
+
+    /// Save state file header, see save_state().
+    /// The version needs to be bumped whenever the serialized state changes, states from other versions are rejected.
+    static constexpr const char * SAVE_STATE_MAGIC = "ORBUMSAV";
+    static constexpr size_t SAVE_STATE_MAGIC_LENGTH = 8;
+    static constexpr std::uint32_t SAVE_STATE_VERSION = 2;
+
+    /// Maximum number of in-memory snapshots kept, the oldest ones are dropped first.
+    /// Enough for 10 seconds of rewind at one snapshot per frame.
+    static constexpr size_t MAXIMUM_SNAPSHOTS = 600;
+
+    /// Minimum length of a run in us, used when an event is due (almost) immediately.
+    /// Keeps the slower controllers from being starved of ticks.
+    static constexpr double MINIMUM_TIME_SLICE_US = 1.0;
+
+    /// Adaptive time slice factors, applied after each run (see CoreOptions::adaptive_time_slice).
+    /// Shrinks faster than it grows, so a burst of activity is tracked closely.
+    static constexpr double ADAPTIVE_TIME_SLICE_GROWTH = 1.25;
+    static constexpr double ADAPTIVE_TIME_SLICE_SHRINK = 0.5;
+
+    /// Controller groups used in the controller affinity mode, each run on a dedicated thread.
+    /// Controllers that share resources are kept together to keep them within the same caches.
+    static constexpr size_t NUMBER_CONTROLLER_GROUPS = 4;
+    static constexpr size_t CONTROLLER_GROUPS[static_cast<size_t>(ControllerType::Type::COUNT)] =
+        {
+            0, // EeCore
+            1, // EeDmac
+            3, // EeTimers
+            3, // EeIntc
+            1, // Gif
+            1, // Ipu
+            1, // Vif
+            0, // Vu
+            2, // IopCore
+            2, // IopDmac
+            3, // IopTimers
+            3, // IopIntc
+            2, // Cdvd
+            2, // Spu2
+            1, // GsCore
+            3, // Crtc
+            2, // Sio0
+            2, // Sio2
+    };
+
     Core(const CoreOptions& options);
     ~Core();
 
@@ -129,10 +245,31 @@ public:
         return *resources;
     }
 
+    /// Returns the emulated time at the start of the current run, in us.
+    double get_time_us() const
+    {
+        return time_us;
+    }
+
+    /// Returns a snapshot of the runtime statistics and profiling counters. Only valid between runs.
+    CoreStats get_stats() const;
+
+    /// Writes the recorded trace events (the most recent ones of each thread) to the path given,
+    /// in the Chrome trace event format (open with chrome://tracing or https://ui.perfetto.dev).
+    /// Throws if tracing is not enabled. Only valid between runs.
+    void save_trace(const std::string& path) const;
+
     /// Enqueues a controller event that is dispatched on the next synchronised run.
     void enqueue_controller_event(const ControllerType::Type c_type, const ControllerEvent& event)
     {
-        controller_event_queue.push({c_type, event});
+        controller_event_queue.push({c_type, event, time_us});
+    }
+
+    /// Schedules a controller event to be dispatched at the (absolute) emulated time given.
+    /// The run containing this time is ended early so the event is dispatched on time.
+    void schedule_controller_event(const ControllerType::Type c_type, const ControllerEvent& event, const double time_us)
+    {
+        controller_event_queue.push({c_type, event, time_us});
     }
 
 private:
@@ -149,12 +286,38 @@ private:
     std::unique_ptr<RResources> resources;
 
     /// Controller Event handling queues.
+    /// Events are enqueued from any thread, and moved into the scheduler at the start of each run.
     struct EventEntry
     {
         ControllerType::Type t;
         ControllerEvent e;
+        double time_us;
     };
     MpmcQueue<EventEntry, 128> controller_event_queue;
+    ControllerScheduler controller_scheduler;
+
+    /// Emulated time at the start of the current run, in us.
+    double time_us;
+
+    /// Number of runs and the host time spent in them, see CoreStats.
+    /// The host cycles are used to convert the controller counters into time (see PerfCounters).
+    size_t runs;
+    double host_time_us;
+    std::uint64_t host_cycles;
+
+    /// Returns the host cycles (see PerfCounters::read_cycles()) per us, measured over the runs so far.
+    double get_cycles_per_us() const;
+
+    /// Time slice of the last run, see CoreStats.
+    double last_time_slice_us;
+
+    /// Adaptive time slice state: the time slice of the next run (saved with the state, so runs from a
+    /// state are reproduced), and the DMA bytes moved as of the last run.
+    double adaptive_time_slice_us;
+    size_t adaptive_dma_bytes;
+
+    /// Grows or shrinks the adaptive time slice, depending on the interrupt and DMA activity of the last run.
+    void update_adaptive_time_slice();
 
     /// Controllers.
     EnumMap<ControllerType::Type, std::unique_ptr<CController>> controllers;
@@ -162,10 +325,52 @@ private:
     /// Task executor.
     std::unique_ptr<TaskExecutor> task_executor;
 
+    /// Controller affinity executor, used instead of the task executor if enabled.
+    struct ControllerTask
+    {
+        ControllerType::Type t;
+        ControllerEvent e;
+    };
+    std::unique_ptr<AffinityExecutor<ControllerTask, 64>> affinity_executor;
+
+    /// Trace recorder, only created if tracing is enabled. Set as the current recorder on threads running this core's work.
+    std::unique_ptr<TraceRecorder> trace_recorder;
+
+    /// Moves newly enqueued events into the scheduler.
+    void schedule_enqueued_events();
+
+    /// Serializes the emulator state: the resources, emulated time and pending scheduled events.
+    template<class Archive>
+    void serialize_state(Archive& archive);
+
+    /// Notifies the controllers that the state has been replaced.
+    void handle_state_loaded();
+
+    /// In-memory snapshots: the (paged) contents of the large memories, and the rest of the state for each snapshot.
+    std::unique_ptr<ByteMemorySnapshots> memory_snapshots;
+    std::deque<std::string> snapshot_states;
+
 public:
-    /// Save the current emulator state. JSON is used for debugging purposes
-    /// (makes it easy to view state).
-    /// TODO: for debugging only for now - some things are not serialized,
-    /// but most of the important stuff is. 
+    /// Saves the current emulator state to the save states folder.
+    /// The file is a header (magic, version), followed by the zlib compressed portable binary archive of the state.
+    /// TODO: some things are not serialized yet (ie: controller side state), but most of the important stuff is.
     void save_state();
+
+    /// Loads the emulator state from the save state file given, see save_state().
+    /// Throws if the file is not a valid save state for this version, in which case the state is left untouched.
+    void load_state(const std::string& path);
+
+    /// Takes an in-memory snapshot of the emulator state, returning its index.
+    /// Only the memory pages changed since the last snapshot are stored, so this is cheap enough
+    /// to run every frame (ie: for rewinding, or bisecting a long run).
+    size_t take_snapshot();
+
+    /// Restores the snapshot at the index given, discarding all later snapshots.
+    void restore_snapshot(const size_t index);
+
+    /// Returns the number of snapshots held.
+    size_t get_snapshot_count() const
+    {
+        return snapshot_states.size();
+    }
 };
@@ -2,24 +2,22 @@
 
 #include "Resources/Cdvd/CdvdRegisters.hpp"
 
-ubyte CdvdFifoQueue_Ns_Data_Out::read_ubyte()
+void CdvdFifoQueue_Ns_Data_Out::read(ubyte* buffer, const size_t length)
 {
     auto _lock = scope_lock();
 
-    ubyte data = DmaFifoQueue::read_ubyte();
+    DmaFifoQueue::read(buffer, length);
 
     // Check if FIFO is empty and signal no more data.
     if (is_empty())
         ns_rdy_din->ready.insert_field(CdvdRegister_Ns_Rdy_Din::READY_EMPTY, 1);
-
-    return data;
 }
 
-void CdvdFifoQueue_Ns_Data_Out::write_ubyte(const ubyte data)
+void CdvdFifoQueue_Ns_Data_Out::write(const ubyte* buffer, const size_t length)
 {
     auto _lock = scope_lock();
 
-    DmaFifoQueue::write_ubyte(data);
+    DmaFifoQueue::write(buffer, length);
 
     // Signal some data is available.
     ns_rdy_din->ready.insert_field(CdvdRegister_Ns_Rdy_Din::READY_EMPTY, 0);
@@ -12,8 +12,8 @@ class CdvdFifoQueue_Ns_Data_Out : public DmaFifoQueue<>, public ScopeLock
 public:
     /// Updates the Ready register upon reads/writes with magic values, based on if FIFO is empty.
     /// Scope locked for the entire duration.
-    ubyte read_ubyte() override;
-    void write_ubyte(const ubyte data) override;
+    void read(ubyte* buffer, const size_t length) override;
+    void write(const ubyte* buffer, const size_t length) override;
 
     /// Reference to the NS_RDY_DIN register.
     CdvdRegister_Ns_Rdy_Din* ns_rdy_din;
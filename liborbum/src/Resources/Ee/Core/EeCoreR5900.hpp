@@ -4,6 +4,7 @@
 
 #include "Common/Constants.hpp"
 #include "Common/Types/Mips/BranchDelaySlot.hpp"
+#include "Common/Types/Register/InlineQwordRegister.hpp"
 #include "Common/Types/Register/PcRegisters.hpp"
 #include "Common/Types/Register/SizedQwordRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
@@ -28,7 +29,17 @@ public:
     /// The upper 64-bits are only used when specific instructions are run, such as
     /// using the EE Core specific multimedia instructions (parallel instructions). Example: PADDB.
     /// See EE Core Users Manual, pg 60.
-    SizedQwordRegister gpr[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS];
+    /// This is the hot register file, kept as a plain aligned array of non-virtual registers so
+    /// the interpreter and recompiler access it with direct loads/stores (see InlineQwordRegister).
+    /// GPR 0 is hardwired to 0, see reset_zero_gpr().
+    InlineQwordRegister gpr[Constants::EE::EECore::R5900::NUMBER_GP_REGISTERS];
+
+    /// Discards any writes made to GPR 0, which need to be undone after running each instruction.
+    /// Cheaper than checking for it on every write (instructions only write their destination after reading the sources).
+    void reset_zero_gpr()
+    {
+        gpr[0].write_uqword(uqword());
+    }
 
     /// The HI and LO registers. See EE Core Users manual, pg 60.
     /// These registers are used to hold the results of integer multiply and divide operations.
@@ -1,20 +1,37 @@
 #include "Resources/Ee/Intc/EeIntcRegisters.hpp"
 
-void EeIntcRegister_Stat::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
+EeIntcRegister_Stat::EeIntcRegister_Stat() :
+    write_latch(false)
 {
-    auto _lock = scope_lock();
+}
 
-    uword temp = value;
+void EeIntcRegister_Stat::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
+{
     if (context == BusContext::Ee)
-        temp = read_uword() & (~value);
+    {
+        clear_bits(value);
+        write_latch = true;
+    }
+    else
+    {
+        write_uword(value);
+    }
+}
 
-    SizedWordRegister::write_uword(temp);
+EeIntcRegister_Mask::EeIntcRegister_Mask() :
+    write_latch(false)
+{
 }
 
 void EeIntcRegister_Mask::byte_bus_write_uword(const BusContext context, const usize offset, const uword value)
 {
     if (context == BusContext::Ee)
+    {
         SizedWordRegister::write_uword(read_uword() ^ value);
+        write_latch = true;
+    }
     else
+    {
         SizedWordRegister::write_uword(value);
+    }
 }
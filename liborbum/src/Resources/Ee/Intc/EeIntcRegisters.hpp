@@ -2,8 +2,8 @@
 
 #include "Common/Constants.hpp"
 #include "Common/Types/Bitfield.hpp"
+#include "Common/Types/Register/AtomicWordRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
-#include "Common/Types/ScopeLock.hpp"
 
 /// The EE INTC I_MASK register, which holds a set of flags determining if the interrupt source is masked.
 /// Bits are reversed by writing 1 (through EE context).
@@ -26,15 +26,21 @@ public:
     static constexpr Bitfield SFIFO = Bitfield(13, 1);
     static constexpr Bitfield VU0WD = Bitfield(14, 1);
 
-    /// (EE) Reverses any bits written to.
+    EeIntcRegister_Mask();
+
+    /// (EE) Reverses any bits written to, and sets the write latch.
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
+
+    /// Bus write latch. Signifies the EE Core should check for interrupts, as a masked interrupt may now be pending.
+    /// Only used within an EE Core time step (reset at the start of each), so not serialised.
+    bool write_latch;
 };
 
 /// The EE INTC I_STAT register, which holds a set of flags determining if a component caused an interrupt.
 /// Bits are cleared by writing 1 (through EE context).
 /// The INTC is edge triggered (ie: only need to pulse line). See EE Users Manual page 28.
-/// STAT writes needs to be scope locked by the peripherals.
-class EeIntcRegister_Stat : public SizedWordRegister, public ScopeLock
+/// Peripherals raise IRQ bits with set_field() (atomic, no locking needed).
+class EeIntcRegister_Stat : public AtomicWordRegister
 {
 public:
     static constexpr Bitfield GS = Bitfield(0, 1);
@@ -58,7 +64,12 @@ public:
     static constexpr Bitfield VU_KEYS[Constants::EE::VPU::VU::NUMBER_VU_CORES] = {VU0, VU1};
     static constexpr Bitfield TIM_KEYS[Constants::EE::Timers::NUMBER_TIMERS] = {TIM0, TIM1, TIM2, TIM3};
 
-    /// (EE context) Clears any bits written to.
-    /// Scope locked.
+    EeIntcRegister_Stat();
+
+    /// (EE context) Clears any bits written to (atomically), and sets the write latch.
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
+
+    /// Bus write latch. Signifies the EE Core should check for interrupts, as an acknowledged interrupt may still be pending.
+    /// Only used within an EE Core time step (reset at the start of each), so not serialised.
+    bool write_latch;
 };
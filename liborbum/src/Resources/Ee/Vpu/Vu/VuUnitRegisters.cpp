@@ -85,6 +85,21 @@ void VuUnitRegister_Mac::clear_vector_field(const VuVectorField::Field field)
     update_vector_field(field, {false, false, false, false});
 }
 
+void VuUnitRegister_Mac::update_vector_fields(const FpuVectorFlags& flags)
+{
+    // The flag masks are already in the MAC field order (bit 3 = x).
+    write_uword((read_uword() & 0xFFFF0000) | (flags.OF << 12) | (flags.UF << 8) | (flags.SF << 4) | flags.ZF);
+
+    status->set_z_flag_sticky(flags.ZF ? 1 : 0);
+    status->set_s_flag_sticky(flags.SF ? 1 : 0);
+    status->set_u_flag_sticky(flags.UF ? 1 : 0);
+    status->set_o_flag_sticky(flags.OF ? 1 : 0);
+    status->insert_field(VuUnitRegister_Status::Z, flags.ZF & 1);
+    status->insert_field(VuUnitRegister_Status::S, flags.SF & 1);
+    status->insert_field(VuUnitRegister_Status::U, flags.UF & 1);
+    status->insert_field(VuUnitRegister_Status::O, flags.OF & 1);
+}
+
 void VuUnitRegister_Clipping::shift_judgement()
 {
     write_uword((read_uword() << 6) & 0x00FFFFFF);
@@ -70,6 +70,11 @@ public:
     void update_vector_field(const VuVectorField::Field field, const FpuFlags& flags);
     void clear_vector_field(const VuVectorField::Field field);
 
+    /// Updates the flags of all fields at once (from the vectorised float kernels).
+    /// Same result as running update_vector_field() for x, y, z then w, where fields without
+    /// any flag set are cleared: the status flags are from w, the sticky flags from any field.
+    void update_vector_fields(const FpuVectorFlags& flags);
+
     /// A reference to the VU status flags register, which fields are changed when various MAC register write conditions occur.
     /// See VU Users Manual page 39.
     VuUnitRegister_Status* status;
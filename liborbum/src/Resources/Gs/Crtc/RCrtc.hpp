@@ -1,11 +1,34 @@
 #pragma once
 
+#include <cereal/cereal.hpp>
+
 /// CRTC resources.
 class RCrtc
 {
+public:
+    RCrtc() :
+        column(0),
+        row(0),
+        hblank_scheduled(false)
+    {
+    }
+
+    /// Current beam position (pixel column and scanline), which run negative during the blanking periods.
+    /// TODO: based on guessed logic, see CCrtc.
+    int column;
+    int row;
+
+    /// Set once the HBlank events are being scheduled ahead of time (see CCrtc::time_step()).
+    bool hblank_scheduled;
+
 public:
     template<class Archive>
     void serialize(Archive & archive)
     {
+        archive(
+            CEREAL_NVP(column),
+            CEREAL_NVP(row),
+            CEREAL_NVP(hblank_scheduled)
+        );
     }
 };
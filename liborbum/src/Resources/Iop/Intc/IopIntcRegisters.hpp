@@ -1,8 +1,9 @@
 #pragma once
 
 #include "Common/Constants.hpp"
+#include "Common/Types/Bitfield.hpp"
+#include "Common/Types/Register/AtomicWordRegister.hpp"
 #include "Common/Types/Register/SizedWordRegister.hpp"
-#include "Common/Types/ScopeLock.hpp"
 
 /// IOP INTC I_CTRL register.
 /// Functionality is largely unknown, however upon reading (through IOP), the register value is set to 0.
@@ -52,8 +53,8 @@ public:
 /// When written to, AND's the previous value with the new value (see IopHwWrite.cpp in PCSX2).
 /// Names from here, not sure if accurate: https://github.com/kode54/Highly_Experimental/blob/master/Core/iop.c.
 /// (Assumed) The INTC is edge triggered (ie: only need to pulse line), see the EE INTC equivilant.
-/// STAT writes needs to be scope locked by the peripherals.
-class IopIntcRegister_Stat : public SizedWordRegister, public ScopeLock
+/// Peripherals raise IRQ bits with set_field() (atomic, no locking needed).
+class IopIntcRegister_Stat : public AtomicWordRegister
 {
 public:
     static constexpr Bitfield VBLANK = Bitfield(0, 1);
@@ -86,7 +87,6 @@ public:
     static constexpr Bitfield IRQ_KEYS[Constants::IOP::INTC::NUMBER_IRQ_LINES] = {VBLANK, GPU, CDROM, DMAC, TMR0, TMR1, TMR2, SIO0, SIO1, SPU, PIO, EVBLANK, DVD, PCMCIA, TMR3, TMR4, TMR5, SIO2, HTR0, HTR1, HTR2, HTR3, USB, EXTR, FWRE, FDMA};
     static constexpr Bitfield TMR_KEYS[Constants::IOP::Timers::NUMBER_TIMERS] = {TMR0, TMR1, TMR2, TMR3, TMR4, TMR5};
 
-    /// AND's the new value with old value (IOP context only).
-    /// Scope locked.
+    /// AND's the new value with old value (IOP context only, atomically).
     void byte_bus_write_uword(const BusContext context, const usize offset, const uword value) override;
 };
\ No newline at end of file
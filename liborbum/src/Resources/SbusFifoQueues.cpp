@@ -2,26 +2,24 @@
 
 #include "Resources/SbusRegisters.hpp"
 
-ubyte SbusFifoQueue_Sif2::read_ubyte()
+void SbusFifoQueue_Sif2::read(ubyte* buffer, const size_t length)
 {
     auto _lock = scope_lock();
 
-    ubyte data = DmaFifoQueue::read_ubyte();
+    DmaFifoQueue::read(buffer, length);
 
     // Check if the FIFO queue is empty.
     if (is_empty())
         sbus_f300->write_uword(sbus_f300->read_uword() | 0x04000000);
     else
         sbus_f300->write_uword(sbus_f300->read_uword() & (~0x04000000));
-
-    return data;
 }
 
-void SbusFifoQueue_Sif2::write_ubyte(const ubyte data)
+void SbusFifoQueue_Sif2::write(const ubyte* buffer, const size_t length)
 {
     auto _lock = scope_lock();
 
-    DmaFifoQueue::write_ubyte(data);
+    DmaFifoQueue::write(buffer, length);
 
     // Signal data is available.
     sbus_f300->write_uword(sbus_f300->read_uword() & (~0x04000000));
@@ -12,8 +12,8 @@ public:
     /// Trigger updates to the SBUS_F300 register (magic values).
     /// Scope locked for the entire duration as the F300 register is updated.
     /// Based upon PCSX2's "sif2.cpp".
-    ubyte read_ubyte() override;
-    void write_ubyte(const ubyte data) override;
+    void read(ubyte* buffer, const size_t length) override;
+    void write(const ubyte* buffer, const size_t length) override;
 
     /// Reference to the SBUS_F300 register.
     SbusRegister_F300* sbus_f300;
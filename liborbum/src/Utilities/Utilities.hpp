@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstring>
 #include <functional>
 #include <limits>
 
@@ -14,6 +15,21 @@ constexpr int size_bits()
     return static_cast<int>(sizeof(T) * CHAR_BIT);
 }
 
+/// Reinterprets the bits of a word as a float and vice versa (without breaking strict aliasing).
+inline f32 word_to_float(const uword value)
+{
+    f32 result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
+inline uword float_to_word(const f32 value)
+{
+    uword result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+}
+
 /// Formats an IEEE 754 float into a PS2 spec float, by clamping NaN's and +/-Infinity to +/-Fmax and rounding denormalised values towards +/-0.
 /// A PS2 spec float can be thought of as a subset of the IEEE 754 float.
 /// When converting, a set of flags will be filled in that can be used to set eg: the VU MAC flags.
@@ -0,0 +1,255 @@
+#include <stdexcept>
+
+#include "Common/Constants.hpp"
+#include "Utilities/Utilities.hpp"
+#include "Utilities/VectorFloat.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define VECTOR_FLOAT_SSE2
+#include <emmintrin.h>
+#endif
+
+void add_vector_field_flags(FpuVectorFlags& vector_flags, const FpuFlags& flags, const uword field_bit)
+{
+    vector_flags.ZF |= flags.ZF ? field_bit : 0;
+    vector_flags.SF |= flags.SF ? field_bit : 0;
+    vector_flags.UF |= flags.UF ? field_bit : 0;
+    vector_flags.OF |= flags.OF ? field_bit : 0;
+}
+
+uqword vector_float_op_scalar(const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c, const ubyte dest, FpuVectorFlags& product_flags, FpuVectorFlags& flags)
+{
+    product_flags = {0, 0, 0, 0};
+    flags = {0, 0, 0, 0};
+
+    uqword result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        const uword field_bit = 1 << (NUMBER_WORDS_IN_QWORD - 1 - i);
+        if (!(dest & field_bit))
+            continue;
+
+        const f32 fa = word_to_float(a.uw[i]);
+        const f32 fb = word_to_float(b.uw[i]);
+        const f32 fc = word_to_float(c.uw[i]);
+
+        FpuFlags field_flags;
+        f32 value;
+        switch (op)
+        {
+        case VectorFloatOp::ADD:
+            value = fa + fb;
+            break;
+        case VectorFloatOp::SUB:
+            value = fa - fb;
+            break;
+        case VectorFloatOp::MUL:
+            value = fa * fb;
+            break;
+        case VectorFloatOp::MADD:
+        case VectorFloatOp::MSUB:
+        {
+            const f32 product = to_ps2_float(fa * fb, field_flags);
+            add_vector_field_flags(product_flags, field_flags, field_bit);
+            value = (op == VectorFloatOp::MADD) ? (fc + product) : (fc - product);
+            break;
+        }
+        case VectorFloatOp::OPMSUB:
+            value = fc - fa * fb;
+            break;
+        default:
+            throw std::runtime_error("Unknown vector float op - please debug!");
+        }
+
+        const f32 formatted = to_ps2_float(value, field_flags);
+        add_vector_field_flags(flags, field_flags, field_bit);
+        result.uw[i] = float_to_word(formatted);
+    }
+
+    return result;
+}
+
+uqword vector_float_max_scalar(const uqword& a, const uqword& b)
+{
+    uqword result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        const f32 fa = word_to_float(a.uw[i]);
+        const f32 fb = word_to_float(b.uw[i]);
+        result.uw[i] = (fa < fb) ? b.uw[i] : a.uw[i];
+    }
+    return result;
+}
+
+uqword vector_float_min_scalar(const uqword& a, const uqword& b)
+{
+    uqword result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        const f32 fa = word_to_float(a.uw[i]);
+        const f32 fb = word_to_float(b.uw[i]);
+        result.uw[i] = (fb < fa) ? b.uw[i] : a.uw[i];
+    }
+    return result;
+}
+
+#if defined(VECTOR_FLOAT_SSE2)
+
+/// Maps a movemask result (bit 0 = x) to the dest field order (bit 3 = x).
+constexpr uword MOVEMASK_TO_DEST[16] = {0x0, 0x8, 0x4, 0xC, 0x2, 0xA, 0x6, 0xE, 0x1, 0x9, 0x5, 0xD, 0x3, 0xB, 0x7, 0xF};
+
+__m128i dest_to_field_mask_sse2(const ubyte dest)
+{
+    return _mm_set_epi32(-((dest >> 0) & 1), -((dest >> 1) & 1), -((dest >> 2) & 1), -((dest >> 3) & 1));
+}
+
+uword movemask_to_dest_sse2(const __m128i mask, const ubyte dest)
+{
+    return MOVEMASK_TO_DEST[_mm_movemask_ps(_mm_castsi128_ps(mask))] & dest;
+}
+
+/// Vectorised to_ps2_float(), using the same classification:
+/// SF is an ordered compare (so false for NaN and -0), then Inf/NaN is clamped to +/-Fmax (OF),
+/// denormals are rounded to +/-0 (UF), and +/-0 is left as is (ZF).
+__m128 to_ps2_float_sse2(const __m128 value, const ubyte dest, FpuVectorFlags& flags)
+{
+    const __m128i raw = _mm_castps_si128(value);
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i exponent_mask = _mm_set1_epi32(0x7F800000);
+    const __m128i exponent = _mm_and_si128(raw, exponent_mask);
+
+    const __m128i sf = _mm_castps_si128(_mm_cmplt_ps(value, _mm_setzero_ps()));
+    const __m128i zf = _mm_cmpeq_epi32(_mm_and_si128(raw, _mm_set1_epi32(0x7FFFFFFF)), zero);
+    const __m128i of = _mm_cmpeq_epi32(exponent, exponent_mask);
+    const __m128i uf = _mm_andnot_si128(zf, _mm_cmpeq_epi32(exponent, zero));
+
+    const __m128i clamped = _mm_or_si128(of, uf);
+    __m128i result = _mm_andnot_si128(clamped, raw);
+    result = _mm_or_si128(result, _mm_and_si128(of, _mm_set1_epi32(static_cast<int>(Constants::EE::EECore::FPU::FMAX_POS))));
+    result = _mm_or_si128(result, _mm_and_si128(_mm_and_si128(clamped, sf), _mm_set1_epi32(static_cast<int>(Constants::EE::EECore::FPU::ZERO_NEG))));
+
+    flags.ZF = movemask_to_dest_sse2(zf, dest);
+    flags.SF = movemask_to_dest_sse2(sf, dest);
+    flags.UF = movemask_to_dest_sse2(uf, dest);
+    flags.OF = movemask_to_dest_sse2(of, dest);
+
+    return _mm_castsi128_ps(result);
+}
+
+#endif
+
+uqword vector_float_op(const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c, const ubyte dest, FpuVectorFlags& product_flags, FpuVectorFlags& flags)
+{
+#if defined(VECTOR_FLOAT_SSE2)
+    const __m128 va = _mm_loadu_ps(reinterpret_cast<const f32*>(&a));
+    const __m128 vb = _mm_loadu_ps(reinterpret_cast<const f32*>(&b));
+    const __m128 vc = _mm_loadu_ps(reinterpret_cast<const f32*>(&c));
+
+    product_flags = {0, 0, 0, 0};
+
+    __m128 value;
+    switch (op)
+    {
+    case VectorFloatOp::ADD:
+        value = _mm_add_ps(va, vb);
+        break;
+    case VectorFloatOp::SUB:
+        value = _mm_sub_ps(va, vb);
+        break;
+    case VectorFloatOp::MUL:
+        value = _mm_mul_ps(va, vb);
+        break;
+    case VectorFloatOp::MADD:
+    case VectorFloatOp::MSUB:
+    {
+        const __m128 product = to_ps2_float_sse2(_mm_mul_ps(va, vb), dest, product_flags);
+        value = (op == VectorFloatOp::MADD) ? _mm_add_ps(vc, product) : _mm_sub_ps(vc, product);
+        break;
+    }
+    case VectorFloatOp::OPMSUB:
+        value = _mm_sub_ps(vc, _mm_mul_ps(va, vb));
+        break;
+    default:
+        throw std::runtime_error("Unknown vector float op - please debug!");
+    }
+
+    uqword result;
+    _mm_storeu_ps(reinterpret_cast<f32*>(&result), to_ps2_float_sse2(value, dest, flags));
+    return result;
+#else
+    return vector_float_op_scalar(op, a, b, c, dest, product_flags, flags);
+#endif
+}
+
+uqword vector_float_max(const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_FLOAT_SSE2)
+    const __m128 va = _mm_loadu_ps(reinterpret_cast<const f32*>(&a));
+    const __m128 vb = _mm_loadu_ps(reinterpret_cast<const f32*>(&b));
+
+    // Not _mm_max_ps, which differs from std::max for NaN's and +/- 0.
+    const __m128 take_b = _mm_cmplt_ps(va, vb);
+
+    uqword result;
+    _mm_storeu_ps(reinterpret_cast<f32*>(&result), _mm_or_ps(_mm_and_ps(take_b, vb), _mm_andnot_ps(take_b, va)));
+    return result;
+#else
+    return vector_float_max_scalar(a, b);
+#endif
+}
+
+uqword vector_float_min(const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_FLOAT_SSE2)
+    const __m128 va = _mm_loadu_ps(reinterpret_cast<const f32*>(&a));
+    const __m128 vb = _mm_loadu_ps(reinterpret_cast<const f32*>(&b));
+
+    // Not _mm_min_ps, which differs from std::min for NaN's and +/- 0.
+    const __m128 take_b = _mm_cmplt_ps(vb, va);
+
+    uqword result;
+    _mm_storeu_ps(reinterpret_cast<f32*>(&result), _mm_or_ps(_mm_and_ps(take_b, vb), _mm_andnot_ps(take_b, va)));
+    return result;
+#else
+    return vector_float_min_scalar(a, b);
+#endif
+}
+
+uqword vector_float_abs(const uqword& a)
+{
+#if defined(VECTOR_FLOAT_SSE2)
+    const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a));
+
+    uqword result;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&result), _mm_and_si128(va, _mm_set1_epi32(0x7FFFFFFF)));
+    return result;
+#else
+    uqword result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.uw[i] = a.uw[i] & 0x7FFFFFFF;
+    return result;
+#endif
+}
+
+uqword vector_float_merge(const uqword& old_value, const uqword& value, const ubyte dest)
+{
+#if defined(VECTOR_FLOAT_SSE2)
+    const __m128i vold = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&old_value));
+    const __m128i vnew = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&value));
+    const __m128i field_mask = dest_to_field_mask_sse2(dest);
+
+    uqword result;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&result), _mm_or_si128(_mm_and_si128(field_mask, vnew), _mm_andnot_si128(field_mask, vold)));
+    return result;
+#else
+    uqword result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        result.uw[i] = (dest & (1 << (NUMBER_WORDS_IN_QWORD - 1 - i))) ? value.uw[i] : old_value.uw[i];
+    return result;
+#endif
+}
+
+uqword vector_float_broadcast(const uword value)
+{
+    return uqword(value, value, value, value);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Common/Types/FpuFlags.hpp"
+#include "Common/Types/Primitive.hpp"
+
+/// Vectorised float kernels, which operate on all 4 fields (x, y, z, w = words 0 -> 3) of a qword at once.
+/// Used by the VU FMAC instructions. SSE2 is used when available (always on x86-64), otherwise the
+/// scalar versions below are used, which are also the bit-exact reference for the SSE2 versions.
+/// The dest parameter selects the fields to generate flags for, in the VU dest field order
+/// (bit 3 = x, bit 0 = w). Fields not in dest have an undefined result, see vector_float_merge().
+
+/// Float operations for vector_float_op().
+enum class VectorFloatOp
+{
+    ADD,   // a + b.
+    SUB,   // a - b.
+    MUL,   // a * b.
+    MADD,  // c + a * b, with the product formatted first.
+    MSUB,  // c - a * b, with the product formatted first.
+    OPMSUB // c - a * b, with the product left unformatted.
+};
+
+/// Performs the float operation, formatting each result field into a PS2 float (see to_ps2_float()).
+/// For MADD and MSUB, the flags from formatting the product are returned through product_flags (cleared otherwise).
+uqword vector_float_op(const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c, const ubyte dest, FpuVectorFlags& product_flags, FpuVectorFlags& flags);
+uqword vector_float_op_scalar(const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c, const ubyte dest, FpuVectorFlags& product_flags, FpuVectorFlags& flags);
+
+/// Field-wise std::max(a, b) and std::min(a, b), including the results for NaN's and +/- 0.
+uqword vector_float_max(const uqword& a, const uqword& b);
+uqword vector_float_max_scalar(const uqword& a, const uqword& b);
+uqword vector_float_min(const uqword& a, const uqword& b);
+uqword vector_float_min_scalar(const uqword& a, const uqword& b);
+
+/// Field-wise absolute value (clears the sign bit).
+uqword vector_float_abs(const uqword& a);
+
+/// Returns old_value with the fields in dest replaced by those from value.
+uqword vector_float_merge(const uqword& old_value, const uqword& value, const ubyte dest);
+
+/// Returns a qword with all fields set to value (ie: for the I, Q and bc field operands).
+uqword vector_float_broadcast(const uword value);
@@ -0,0 +1,454 @@
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+#include "Utilities/VectorInteger.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64)
+#define VECTOR_INTEGER_SSE2
+#include <emmintrin.h>
+#endif
+
+/// Scalar operation on each field of type U (with signed equivalent S).
+template<typename U, typename S>
+uqword vector_integer_op_fields(const VectorIntegerOp op, const uqword& a, const uqword& b)
+{
+    constexpr int number_fields = NUMBER_BYTES_IN_QWORD / sizeof(U);
+    constexpr sdword signed_max = std::numeric_limits<S>::max();
+    constexpr sdword signed_min = std::numeric_limits<S>::min();
+    constexpr udword unsigned_max = std::numeric_limits<U>::max();
+
+    const U* fields_a = reinterpret_cast<const U*>(&a);
+    const U* fields_b = reinterpret_cast<const U*>(&b);
+
+    uqword result;
+    U* fields_result = reinterpret_cast<U*>(&result);
+
+    for (int i = 0; i < number_fields; i++)
+    {
+        const U ua = fields_a[i];
+        const U ub = fields_b[i];
+        const sdword sa = static_cast<S>(ua);
+        const sdword sb = static_cast<S>(ub);
+
+        switch (op)
+        {
+        case VectorIntegerOp::ADD:
+            fields_result[i] = static_cast<U>(ua + ub);
+            break;
+        case VectorIntegerOp::ADDS:
+            fields_result[i] = static_cast<U>(std::clamp(sa + sb, signed_min, signed_max));
+            break;
+        case VectorIntegerOp::ADDU:
+            fields_result[i] = static_cast<U>(std::min(static_cast<udword>(ua) + ub, unsigned_max));
+            break;
+        case VectorIntegerOp::SUB:
+            fields_result[i] = static_cast<U>(ua - ub);
+            break;
+        case VectorIntegerOp::SUBS:
+            fields_result[i] = static_cast<U>(std::clamp(sa - sb, signed_min, signed_max));
+            break;
+        case VectorIntegerOp::SUBU:
+            fields_result[i] = (ua > ub) ? static_cast<U>(ua - ub) : 0;
+            break;
+        case VectorIntegerOp::MAX:
+            fields_result[i] = static_cast<U>(std::max(sa, sb));
+            break;
+        case VectorIntegerOp::MIN:
+            fields_result[i] = static_cast<U>(std::min(sa, sb));
+            break;
+        case VectorIntegerOp::CEQ:
+            fields_result[i] = (ua == ub) ? static_cast<U>(unsigned_max) : 0;
+            break;
+        case VectorIntegerOp::CGT:
+            fields_result[i] = (sa > sb) ? static_cast<U>(unsigned_max) : 0;
+            break;
+        default:
+            throw std::runtime_error("Unknown vector integer op - please debug!");
+        }
+    }
+
+    return result;
+}
+
+uqword vector_integer_op_scalar(const VectorIntegerOp op, const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return vector_integer_op_fields<ubyte, sbyte>(op, a, b);
+    case VectorIntegerWidth::HWORD:
+        return vector_integer_op_fields<uhword, shword>(op, a, b);
+    case VectorIntegerWidth::WORD:
+        return vector_integer_op_fields<uword, sword>(op, a, b);
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+#if defined(VECTOR_INTEGER_SSE2)
+
+__m128i load_uqword_sse2(const uqword& value)
+{
+    return _mm_loadu_si128(reinterpret_cast<const __m128i*>(&value));
+}
+
+uqword store_uqword_sse2(const __m128i value)
+{
+    uqword result;
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&result), value);
+    return result;
+}
+
+__m128i select_mask_sse2(const __m128i mask, const __m128i a, const __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/// SSE2 has no 32-bit saturating, byte/word max/min or unsigned compare instructions,
+/// so these are built from the sign bits and signed compares below.
+__m128i integer_op_byte_sse2(const VectorIntegerOp op, const __m128i a, const __m128i b)
+{
+    switch (op)
+    {
+    case VectorIntegerOp::ADD:
+        return _mm_add_epi8(a, b);
+    case VectorIntegerOp::ADDS:
+        return _mm_adds_epi8(a, b);
+    case VectorIntegerOp::ADDU:
+        return _mm_adds_epu8(a, b);
+    case VectorIntegerOp::SUB:
+        return _mm_sub_epi8(a, b);
+    case VectorIntegerOp::SUBS:
+        return _mm_subs_epi8(a, b);
+    case VectorIntegerOp::SUBU:
+        return _mm_subs_epu8(a, b);
+    case VectorIntegerOp::MAX:
+        return select_mask_sse2(_mm_cmpgt_epi8(a, b), a, b);
+    case VectorIntegerOp::MIN:
+        return select_mask_sse2(_mm_cmpgt_epi8(a, b), b, a);
+    case VectorIntegerOp::CEQ:
+        return _mm_cmpeq_epi8(a, b);
+    case VectorIntegerOp::CGT:
+        return _mm_cmpgt_epi8(a, b);
+    default:
+        throw std::runtime_error("Unknown vector integer op - please debug!");
+    }
+}
+
+__m128i integer_op_hword_sse2(const VectorIntegerOp op, const __m128i a, const __m128i b)
+{
+    switch (op)
+    {
+    case VectorIntegerOp::ADD:
+        return _mm_add_epi16(a, b);
+    case VectorIntegerOp::ADDS:
+        return _mm_adds_epi16(a, b);
+    case VectorIntegerOp::ADDU:
+        return _mm_adds_epu16(a, b);
+    case VectorIntegerOp::SUB:
+        return _mm_sub_epi16(a, b);
+    case VectorIntegerOp::SUBS:
+        return _mm_subs_epi16(a, b);
+    case VectorIntegerOp::SUBU:
+        return _mm_subs_epu16(a, b);
+    case VectorIntegerOp::MAX:
+        return _mm_max_epi16(a, b);
+    case VectorIntegerOp::MIN:
+        return _mm_min_epi16(a, b);
+    case VectorIntegerOp::CEQ:
+        return _mm_cmpeq_epi16(a, b);
+    case VectorIntegerOp::CGT:
+        return _mm_cmpgt_epi16(a, b);
+    default:
+        throw std::runtime_error("Unknown vector integer op - please debug!");
+    }
+}
+
+__m128i integer_op_word_sse2(const VectorIntegerOp op, const __m128i a, const __m128i b)
+{
+    const __m128i sign_bit = _mm_set1_epi32(static_cast<int>(0x80000000));
+
+    switch (op)
+    {
+    case VectorIntegerOp::ADD:
+        return _mm_add_epi32(a, b);
+    case VectorIntegerOp::ADDS:
+    {
+        // Overflowed if the operands have the same sign, and the result sign differs.
+        // The saturated value is then MAX or MIN, depending on the sign of a.
+        const __m128i sum = _mm_add_epi32(a, b);
+        const __m128i overflow = _mm_srai_epi32(_mm_andnot_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, sum)), 31);
+        const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(VALUE_SWORD_MAX));
+        return select_mask_sse2(overflow, saturated, sum);
+    }
+    case VectorIntegerOp::ADDU:
+    {
+        // Carry if sum < a (unsigned).
+        const __m128i sum = _mm_add_epi32(a, b);
+        const __m128i carry = _mm_cmpgt_epi32(_mm_xor_si128(a, sign_bit), _mm_xor_si128(sum, sign_bit));
+        return _mm_or_si128(sum, carry);
+    }
+    case VectorIntegerOp::SUB:
+        return _mm_sub_epi32(a, b);
+    case VectorIntegerOp::SUBS:
+    {
+        // Overflowed if the operands have different signs, and the result sign differs from a.
+        const __m128i difference = _mm_sub_epi32(a, b);
+        const __m128i overflow = _mm_srai_epi32(_mm_and_si128(_mm_xor_si128(a, b), _mm_xor_si128(a, difference)), 31);
+        const __m128i saturated = _mm_xor_si128(_mm_srai_epi32(a, 31), _mm_set1_epi32(VALUE_SWORD_MAX));
+        return select_mask_sse2(overflow, saturated, difference);
+    }
+    case VectorIntegerOp::SUBU:
+    {
+        // Borrow if b > a (unsigned).
+        const __m128i borrow = _mm_cmpgt_epi32(_mm_xor_si128(b, sign_bit), _mm_xor_si128(a, sign_bit));
+        return _mm_andnot_si128(borrow, _mm_sub_epi32(a, b));
+    }
+    case VectorIntegerOp::MAX:
+        return select_mask_sse2(_mm_cmpgt_epi32(a, b), a, b);
+    case VectorIntegerOp::MIN:
+        return select_mask_sse2(_mm_cmpgt_epi32(a, b), b, a);
+    case VectorIntegerOp::CEQ:
+        return _mm_cmpeq_epi32(a, b);
+    case VectorIntegerOp::CGT:
+        return _mm_cmpgt_epi32(a, b);
+    default:
+        throw std::runtime_error("Unknown vector integer op - please debug!");
+    }
+}
+
+#endif
+
+uqword vector_integer_op(const VectorIntegerOp op, const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_INTEGER_SSE2)
+    const __m128i va = load_uqword_sse2(a);
+    const __m128i vb = load_uqword_sse2(b);
+
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return store_uqword_sse2(integer_op_byte_sse2(op, va, vb));
+    case VectorIntegerWidth::HWORD:
+        return store_uqword_sse2(integer_op_hword_sse2(op, va, vb));
+    case VectorIntegerWidth::WORD:
+        return store_uqword_sse2(integer_op_word_sse2(op, va, vb));
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+#else
+    return vector_integer_op_scalar(op, width, a, b);
+#endif
+}
+
+/// Scalar interleave of the fields of type U, starting from field offset.
+template<typename U>
+uqword vector_integer_interleave_fields(const uqword& a, const uqword& b, const int offset)
+{
+    constexpr int number_fields = NUMBER_BYTES_IN_QWORD / sizeof(U);
+
+    const U* fields_a = reinterpret_cast<const U*>(&a);
+    const U* fields_b = reinterpret_cast<const U*>(&b);
+
+    uqword result;
+    U* fields_result = reinterpret_cast<U*>(&result);
+
+    for (int i = 0; i < number_fields / 2; i++)
+    {
+        fields_result[i * 2] = fields_a[offset + i];
+        fields_result[i * 2 + 1] = fields_b[offset + i];
+    }
+
+    return result;
+}
+
+uqword vector_integer_interleave_lower_scalar(const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return vector_integer_interleave_fields<ubyte>(a, b, 0);
+    case VectorIntegerWidth::HWORD:
+        return vector_integer_interleave_fields<uhword>(a, b, 0);
+    case VectorIntegerWidth::WORD:
+        return vector_integer_interleave_fields<uword>(a, b, 0);
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+uqword vector_integer_interleave_upper_scalar(const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return vector_integer_interleave_fields<ubyte>(a, b, NUMBER_BYTES_IN_QWORD / 2);
+    case VectorIntegerWidth::HWORD:
+        return vector_integer_interleave_fields<uhword>(a, b, NUMBER_HWORDS_IN_QWORD / 2);
+    case VectorIntegerWidth::WORD:
+        return vector_integer_interleave_fields<uword>(a, b, NUMBER_WORDS_IN_QWORD / 2);
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+uqword vector_integer_interleave_lower(const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_INTEGER_SSE2)
+    const __m128i va = load_uqword_sse2(a);
+    const __m128i vb = load_uqword_sse2(b);
+
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return store_uqword_sse2(_mm_unpacklo_epi8(va, vb));
+    case VectorIntegerWidth::HWORD:
+        return store_uqword_sse2(_mm_unpacklo_epi16(va, vb));
+    case VectorIntegerWidth::WORD:
+        return store_uqword_sse2(_mm_unpacklo_epi32(va, vb));
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+#else
+    return vector_integer_interleave_lower_scalar(width, a, b);
+#endif
+}
+
+uqword vector_integer_interleave_upper(const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_INTEGER_SSE2)
+    const __m128i va = load_uqword_sse2(a);
+    const __m128i vb = load_uqword_sse2(b);
+
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return store_uqword_sse2(_mm_unpackhi_epi8(va, vb));
+    case VectorIntegerWidth::HWORD:
+        return store_uqword_sse2(_mm_unpackhi_epi16(va, vb));
+    case VectorIntegerWidth::WORD:
+        return store_uqword_sse2(_mm_unpackhi_epi32(va, vb));
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+#else
+    return vector_integer_interleave_upper_scalar(width, a, b);
+#endif
+}
+
+/// Scalar pack of the even fields of type U.
+template<typename U>
+uqword vector_integer_pack_fields(const uqword& a, const uqword& b)
+{
+    constexpr int number_fields = NUMBER_BYTES_IN_QWORD / sizeof(U);
+
+    const U* fields_a = reinterpret_cast<const U*>(&a);
+    const U* fields_b = reinterpret_cast<const U*>(&b);
+
+    uqword result;
+    U* fields_result = reinterpret_cast<U*>(&result);
+
+    for (int i = 0; i < number_fields / 2; i++)
+    {
+        fields_result[i] = fields_a[i * 2];
+        fields_result[number_fields / 2 + i] = fields_b[i * 2];
+    }
+
+    return result;
+}
+
+uqword vector_integer_pack_scalar(const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return vector_integer_pack_fields<ubyte>(a, b);
+    case VectorIntegerWidth::HWORD:
+        return vector_integer_pack_fields<uhword>(a, b);
+    case VectorIntegerWidth::WORD:
+        return vector_integer_pack_fields<uword>(a, b);
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+uqword vector_integer_pack(const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_INTEGER_SSE2)
+    const __m128i va = load_uqword_sse2(a);
+    const __m128i vb = load_uqword_sse2(b);
+
+    // The even fields are sign extended into the odd field positions first, so the
+    // signed saturating packs never actually saturate.
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return store_uqword_sse2(_mm_packs_epi16(_mm_srai_epi16(_mm_slli_epi16(va, 8), 8), _mm_srai_epi16(_mm_slli_epi16(vb, 8), 8)));
+    case VectorIntegerWidth::HWORD:
+        return store_uqword_sse2(_mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(va, 16), 16), _mm_srai_epi32(_mm_slli_epi32(vb, 16), 16)));
+    case VectorIntegerWidth::WORD:
+        return store_uqword_sse2(_mm_castps_si128(_mm_shuffle_ps(_mm_castsi128_ps(va), _mm_castsi128_ps(vb), _MM_SHUFFLE(2, 0, 2, 0))));
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+#else
+    return vector_integer_pack_scalar(width, a, b);
+#endif
+}
+
+void vector_integer_multiply_hword_scalar(const uqword& a, const uqword& b, uqword& lower, uqword& upper)
+{
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        lower.uw[i] = static_cast<uword>(static_cast<sword>(static_cast<shword>(a.uh[i])) * static_cast<shword>(b.uh[i]));
+        upper.uw[i] = static_cast<uword>(static_cast<sword>(static_cast<shword>(a.uh[i + 4])) * static_cast<shword>(b.uh[i + 4]));
+    }
+}
+
+void vector_integer_multiply_hword(const uqword& a, const uqword& b, uqword& lower, uqword& upper)
+{
+#if defined(VECTOR_INTEGER_SSE2)
+    const __m128i va = load_uqword_sse2(a);
+    const __m128i vb = load_uqword_sse2(b);
+    const __m128i product_lo = _mm_mullo_epi16(va, vb);
+    const __m128i product_hi = _mm_mulhi_epi16(va, vb);
+
+    lower = store_uqword_sse2(_mm_unpacklo_epi16(product_lo, product_hi));
+    upper = store_uqword_sse2(_mm_unpackhi_epi16(product_lo, product_hi));
+#else
+    vector_integer_multiply_hword_scalar(a, b, lower, upper);
+#endif
+}
+
+uqword vector_integer_multiply_pairs_hword_scalar(const bool subtract, const uqword& a, const uqword& b)
+{
+    uqword result;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        const uword even = static_cast<uword>(static_cast<sword>(static_cast<shword>(a.uh[i * 2])) * static_cast<shword>(b.uh[i * 2]));
+        const uword odd = static_cast<uword>(static_cast<sword>(static_cast<shword>(a.uh[i * 2 + 1])) * static_cast<shword>(b.uh[i * 2 + 1]));
+        result.uw[i] = subtract ? (odd - even) : (odd + even);
+    }
+    return result;
+}
+
+uqword vector_integer_multiply_pairs_hword(const bool subtract, const uqword& a, const uqword& b)
+{
+#if defined(VECTOR_INTEGER_SSE2)
+    const __m128i va = load_uqword_sse2(a);
+    const __m128i vb = load_uqword_sse2(b);
+
+    if (!subtract)
+        return store_uqword_sse2(_mm_madd_epi16(va, vb));
+
+    // Reassemble the 32-bit products of the even and odd hwords in place from the low and high product halves.
+    const __m128i product_lo = _mm_mullo_epi16(va, vb);
+    const __m128i product_hi = _mm_mulhi_epi16(va, vb);
+    const __m128i even = _mm_or_si128(_mm_slli_epi32(product_hi, 16), _mm_srli_epi32(_mm_slli_epi32(product_lo, 16), 16));
+    const __m128i odd = _mm_or_si128(_mm_slli_epi32(_mm_srli_epi32(product_hi, 16), 16), _mm_srli_epi32(product_lo, 16));
+    return store_uqword_sse2(_mm_sub_epi32(odd, even));
+#else
+    return vector_integer_multiply_pairs_hword_scalar(subtract, a, b);
+#endif
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "Common/Types/Primitive.hpp"
+
+/// Vectorised integer kernels, which operate on all byte/hword/word fields of a qword at once.
+/// Used by the EE Core MMI (parallel) instructions. SSE2 is used when available (always on x86-64),
+/// otherwise the scalar versions below are used. The scalar versions are always built, and are the
+/// bit-exact reference the SSE2 versions are tested against (see orbumtest).
+
+/// Field width for the vector integer operations.
+enum class VectorIntegerWidth
+{
+    BYTE,
+    HWORD,
+    WORD
+};
+
+/// Integer operations for vector_integer_op().
+/// Signed and unsigned saturating operations clamp to the field range instead of wrapping.
+enum class VectorIntegerOp
+{
+    ADD,  // a + b.
+    ADDS, // a + b, signed saturated.
+    ADDU, // a + b, unsigned saturated.
+    SUB,  // a - b.
+    SUBS, // a - b, signed saturated.
+    SUBU, // a - b, unsigned saturated (clamped to 0).
+    MAX,  // Signed max(a, b).
+    MIN,  // Signed min(a, b).
+    CEQ,  // (a == b) ? all 1's : 0.
+    CGT   // (a > b) ? all 1's : 0, signed.
+};
+
+/// Performs the integer operation on each field.
+uqword vector_integer_op(const VectorIntegerOp op, const VectorIntegerWidth width, const uqword& a, const uqword& b);
+uqword vector_integer_op_scalar(const VectorIntegerOp op, const VectorIntegerWidth width, const uqword& a, const uqword& b);
+
+/// Interleaves the lower (fields 0 -> N/2 - 1) or upper half fields of a and b, starting with a's (ie: a0, b0, a1, b1, ...).
+uqword vector_integer_interleave_lower(const VectorIntegerWidth width, const uqword& a, const uqword& b);
+uqword vector_integer_interleave_lower_scalar(const VectorIntegerWidth width, const uqword& a, const uqword& b);
+uqword vector_integer_interleave_upper(const VectorIntegerWidth width, const uqword& a, const uqword& b);
+uqword vector_integer_interleave_upper_scalar(const VectorIntegerWidth width, const uqword& a, const uqword& b);
+
+/// Packs the even fields of a into the lower half, and the even fields of b into the upper half (ie: a0, a2, ..., b0, b2, ...).
+uqword vector_integer_pack(const VectorIntegerWidth width, const uqword& a, const uqword& b);
+uqword vector_integer_pack_scalar(const VectorIntegerWidth width, const uqword& a, const uqword& b);
+
+/// Signed hword multiply, returning the 32-bit products of hword fields 0 -> 3 through lower and 4 -> 7 through upper.
+void vector_integer_multiply_hword(const uqword& a, const uqword& b, uqword& lower, uqword& upper);
+void vector_integer_multiply_hword_scalar(const uqword& a, const uqword& b, uqword& lower, uqword& upper);
+
+/// Signed hword multiply, with each 32-bit result field i = (a[2i + 1] * b[2i + 1]) +/- (a[2i] * b[2i]).
+uqword vector_integer_multiply_pairs_hword(const bool subtract, const uqword& a, const uqword& b);
+uqword vector_integer_multiply_pairs_hword_scalar(const bool subtract, const uqword& a, const uqword& b);
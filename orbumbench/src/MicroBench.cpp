@@ -0,0 +1,33 @@
+#include <algorithm>
+
+#include <benchmark/benchmark.h>
+
+#include "MicroBench.hpp"
+
+std::vector<std::uint32_t> make_address_stream(const std::uint32_t base, const std::uint32_t range, const std::uint32_t alignment,
+                                               const size_t hot_pages, const std::uint32_t hot_percent, const std::uint32_t seed)
+{
+    constexpr std::uint32_t PAGE_SIZE = 0x1000;
+    const std::uint32_t number_pages = (range + PAGE_SIZE - 1) / PAGE_SIZE;
+
+    BenchRandom random(seed);
+    std::vector<std::uint32_t> hot(hot_pages);
+    for (auto& page : hot)
+        page = random.next() % number_pages;
+
+    std::vector<std::uint32_t> stream(BENCH_STREAM_LENGTH);
+    for (auto& address : stream)
+    {
+        std::uint32_t offset;
+        if (!hot.empty() && (random.next() % 100) < hot_percent)
+            offset = hot[random.next() % hot.size()] * PAGE_SIZE + (random.next() % PAGE_SIZE);
+        else
+            offset = random.next() % range;
+
+        address = base + (std::min(offset, range - alignment) & ~(alignment - 1));
+    }
+
+    return stream;
+}
+
+BENCHMARK_MAIN();
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/// Shared helpers for the microbenchmarks (orbummicrobench).
+/// All inputs are generated from a fixed seed, so every run measures the same streams.
+
+/// Xorshift pseudo random number generator.
+class BenchRandom
+{
+public:
+    BenchRandom(const std::uint32_t seed = 0x9E3779B9) :
+        state(seed)
+    {
+    }
+
+    std::uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+private:
+    std::uint32_t state;
+};
+
+/// Number of entries in each generated stream, a power of 2 so it can be indexed with a mask.
+constexpr size_t BENCH_STREAM_LENGTH = 4096;
+constexpr size_t BENCH_STREAM_MASK = BENCH_STREAM_LENGTH - 1;
+
+/// Generates a stream of addresses within [base, base + range) aligned to the alignment given, with locality:
+/// hot_percent of the accesses go to a small set of hot_pages (4KB) pages, the rest are spread over the whole range.
+std::vector<std::uint32_t> make_address_stream(const std::uint32_t base, const std::uint32_t range, const std::uint32_t alignment,
+                                               const size_t hot_pages, const std::uint32_t hot_percent, const std::uint32_t seed = 1);
@@ -0,0 +1,145 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Bus/ByteBus.hpp"
+#include "Common/Types/Memory/ArrayByteMemory.hpp"
+#include "Resources/RResources.hpp"
+
+#include "MicroBench.hpp"
+
+/// ByteBus microbenchmarks, over the real EE and IOP bus maps.
+/// The first argument selects fastmem (1) or the page table path only (0).
+
+/// Shared resources, created once for each fastmem setting (the initialisation is expensive).
+struct BusBenchResources
+{
+    static RResources& get(const bool fastmem)
+    {
+        static std::unique_ptr<RResources> resources[2];
+
+        auto& r = resources[fastmem ? 1 : 0];
+        if (!r)
+        {
+            r = std::make_unique<RResources>();
+            initialise_resources(r);
+
+            // Same as the Core setup.
+            if (fastmem)
+                r->ee.bus.enable_fastmem({&r->ee.main_memory, &r->ee.core.scratchpad_memory, &r->boot_rom, &r->rom1, &r->erom, &r->rom2});
+        }
+
+        return *r;
+    }
+
+    /// Returns a mixed address stream, mostly main memory with some ROM and register accesses,
+    /// similar to a running BIOS.
+    static std::vector<std::uint32_t> make_mixed_stream(const std::uint32_t main_memory_size, const std::vector<std::uint32_t>& registers)
+    {
+        auto stream = make_address_stream(0x00000000, main_memory_size, NUMBER_BYTES_IN_WORD, 16, 90);
+        const auto rom_stream = make_address_stream(0x1FC00000, 0x400000, NUMBER_BYTES_IN_WORD, 4, 90, 2);
+
+        BenchRandom random(3);
+        for (size_t i = 0; i < stream.size(); i++)
+        {
+            const std::uint32_t select = random.next() % 100;
+            if (select < 20)
+                stream[i] = rom_stream[i];
+            else if (select < 30)
+                stream[i] = registers[random.next() % registers.size()];
+        }
+
+        return stream;
+    }
+};
+
+template <typename T, T (ByteBus<uptr>::*Read)(const BusContext, const uptr) const>
+void BM_EeBusRead(benchmark::State& state)
+{
+    auto& r = BusBenchResources::get(state.range(0) != 0);
+    const auto stream = make_address_stream(0x00000000, Constants::EE::MainMemory::SIZE_MAIN_MEMORY, sizeof(T), 16, 90);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize((r.ee.bus.*Read)(BusContext::Ee, stream[i++ & BENCH_STREAM_MASK]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(T));
+}
+
+template <typename T, void (ByteBus<uptr>::*Write)(const BusContext, const uptr, const T) const>
+void BM_EeBusWrite(benchmark::State& state)
+{
+    auto& r = BusBenchResources::get(state.range(0) != 0);
+    const auto stream = make_address_stream(0x00000000, Constants::EE::MainMemory::SIZE_MAIN_MEMORY, sizeof(T), 16, 90);
+    const T value = T();
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        (r.ee.bus.*Write)(BusContext::Ee, stream[i++ & BENCH_STREAM_MASK], value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * sizeof(T));
+}
+
+void BM_EeBusReadMixed(benchmark::State& state)
+{
+    auto& r = BusBenchResources::get(state.range(0) != 0);
+    const auto stream = BusBenchResources::make_mixed_stream(Constants::EE::MainMemory::SIZE_MAIN_MEMORY, {0x1000F000, 0x10000000, 0x10000800});
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(r.ee.bus.read_uword(BusContext::Ee, stream[i++ & BENCH_STREAM_MASK]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_IopBusRead(benchmark::State& state)
+{
+    auto& r = BusBenchResources::get(state.range(0) != 0);
+    const auto stream = make_address_stream(0x00000000, Constants::IOP::IOPMemory::SIZE_IOP_MEMORY, NUMBER_BYTES_IN_WORD, 16, 90);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(r.iop.bus.read_uword(BusContext::Iop, stream[i++ & BENCH_STREAM_MASK]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_IopBusReadMixed(benchmark::State& state)
+{
+    auto& r = BusBenchResources::get(state.range(0) != 0);
+    const auto stream = BusBenchResources::make_mixed_stream(Constants::IOP::IOPMemory::SIZE_IOP_MEMORY, {0x1F801070, 0x1F801074, 0x1F801100});
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(r.iop.bus.read_uword(BusContext::Iop, stream[i++ & BENCH_STREAM_MASK]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_EeBusRead, ubyte, &ByteBus<uptr>::read_ubyte)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusRead, uhword, &ByteBus<uptr>::read_uhword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusRead, uword, &ByteBus<uptr>::read_uword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusRead, udword, &ByteBus<uptr>::read_udword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusRead, uqword, &ByteBus<uptr>::read_uqword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusWrite, ubyte, &ByteBus<uptr>::write_ubyte)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusWrite, uhword, &ByteBus<uptr>::write_uhword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusWrite, uword, &ByteBus<uptr>::write_uword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusWrite, udword, &ByteBus<uptr>::write_udword)->Arg(0)->Arg(1);
+BENCHMARK_TEMPLATE(BM_EeBusWrite, uqword, &ByteBus<uptr>::write_uqword)->Arg(0)->Arg(1);
+BENCHMARK(BM_EeBusReadMixed)->Arg(0)->Arg(1);
+BENCHMARK(BM_IopBusRead)->Arg(0)->Arg(1);
+BENCHMARK(BM_IopBusReadMixed)->Arg(0)->Arg(1);
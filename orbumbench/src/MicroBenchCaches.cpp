@@ -0,0 +1,73 @@
+#include <optional>
+
+#include <benchmark/benchmark.h>
+
+#include <Caches.hpp>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Mips/MmuAccess.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Common/Types/TranslationCache/TranslationCache.hpp"
+
+#include "MicroBench.hpp"
+
+/// Cache microbenchmarks, keyed by 4KB page like the translation caches.
+/// The argument is the number of hot pages the address stream mostly (90%) accesses,
+/// the hit_ratio counter reports how well the cache type copes with it.
+
+template <template <int, typename, typename> class CacheTy, int Size>
+void BM_Cache(benchmark::State& state)
+{
+    const auto stream = make_address_stream(0x00000000, Constants::SIZE_32MB, Constants::SIZE_4KB, state.range(0), 90);
+    CacheTy<Size, uptr, uptr> cache;
+
+    size_t i = 0;
+    size_t hits = 0;
+    for (auto _ : state)
+    {
+        const uptr key = stream[i++ & BENCH_STREAM_MASK];
+        if (auto value = cache.get(key))
+        {
+            benchmark::DoNotOptimize(*value);
+            hits++;
+        }
+        else
+        {
+            cache.insert(key, key);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    state.counters["hit_ratio"] = benchmark::Counter(static_cast<double>(hits), benchmark::Counter::kAvgIterations);
+}
+
+template <template <int, typename, typename> class CacheTy>
+void BM_TranslationCacheLookup(benchmark::State& state)
+{
+    const auto stream = make_address_stream(0x80000000, Constants::SIZE_32MB, NUMBER_BYTES_IN_WORD, state.range(0), 90);
+    TranslationCache<6, uptr, 0xFFF, CacheTy> cache;
+    cache.set_fallback_lookup([](const uptr address, const MmuRwAccess) -> std::optional<uptr> {
+        return address & 0x1FFFFFFF;
+    });
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(cache.lookup(stream[i++ & BENCH_STREAM_MASK], READ));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Cache, CounterLfuCache, 6)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Cache, TimestampLruCache, 6)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Cache, HashedLruCache, 6)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Cache, OrderedLruCache, 6)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Cache, ClockCache, 6)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_Cache, CounterLfuCache, 32)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_Cache, TimestampLruCache, 32)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_Cache, HashedLruCache, 32)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_Cache, OrderedLruCache, 32)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_Cache, ClockCache, 32)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_TranslationCacheLookup, TimestampLruCache)->Arg(4)->Arg(16);
+BENCHMARK_TEMPLATE(BM_TranslationCacheLookup, ClockCache)->Arg(4)->Arg(16);
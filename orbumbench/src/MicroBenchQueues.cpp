@@ -0,0 +1,108 @@
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <Queues.hpp>
+
+#include "Common/Types/FifoQueue/DmaFifoQueue.hpp"
+#include "Common/Types/Primitive.hpp"
+
+#include "MicroBench.hpp"
+
+/// Queue microbenchmarks: the controller event queue (MpmcQueue) and the DMA FIFOs (DmaFifoQueue).
+
+using BenchEventQueue = MpmcQueue<std::uint64_t, 128>;
+
+void BM_MpmcQueuePushPop(benchmark::State& state)
+{
+    BenchEventQueue queue;
+    std::uint64_t item = 0;
+
+    for (auto _ : state)
+    {
+        queue.push(item);
+        queue.try_pop(item);
+    }
+
+    benchmark::DoNotOptimize(item);
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Pushes and then pops a batch of items (the argument), as the controllers queue several events before running.
+void BM_MpmcQueueBatch(benchmark::State& state)
+{
+    BenchEventQueue queue;
+    const auto batch = state.range(0);
+    std::uint64_t item = 0;
+
+    for (auto _ : state)
+    {
+        for (auto i = 0; i < batch; i++)
+            queue.push(item);
+        for (auto i = 0; i < batch; i++)
+            queue.try_pop(item);
+    }
+
+    benchmark::DoNotOptimize(item);
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+/// One producer thread and one consumer thread sharing the queue (blocking push/pop).
+void BM_MpmcQueueThreaded(benchmark::State& state)
+{
+    static BenchEventQueue queue;
+    std::uint64_t item = 0;
+
+    for (auto _ : state)
+    {
+        if (state.thread_index() == 0)
+            queue.push(item);
+        else
+            queue.pop(item);
+    }
+
+    benchmark::DoNotOptimize(item);
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Writes then reads a burst of qwords (the argument) through the FIFO, as a DMA channel and peripheral would.
+void BM_DmaFifoQueueQwords(benchmark::State& state)
+{
+    auto fifo = std::make_unique<DmaFifoQueue<>>();
+    const auto count = static_cast<size_t>(state.range(0));
+    std::vector<uqword> data(count);
+
+    for (auto _ : state)
+    {
+        fifo->write_uqwords(data.data(), count);
+        fifo->read_uqwords(data.data(), count);
+    }
+
+    benchmark::DoNotOptimize(data.data());
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetBytesProcessed(state.iterations() * count * NUMBER_BYTES_IN_QWORD);
+}
+
+/// Single qword transfers, through the virtual FifoQueue interface used by the DMAC.
+void BM_DmaFifoQueueSingle(benchmark::State& state)
+{
+    std::unique_ptr<FifoQueue> fifo = std::make_unique<DmaFifoQueue<>>();
+    uqword data;
+
+    for (auto _ : state)
+    {
+        fifo->write_uqwords(&data, 1);
+        fifo->read_uqwords(&data, 1);
+    }
+
+    benchmark::DoNotOptimize(data);
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * NUMBER_BYTES_IN_QWORD);
+}
+
+BENCHMARK(BM_MpmcQueuePushPop);
+BENCHMARK(BM_MpmcQueueBatch)->Arg(8)->Arg(64);
+BENCHMARK(BM_MpmcQueueThreaded)->Threads(2)->UseRealTime();
+BENCHMARK(BM_DmaFifoQueueQwords)->Arg(8)->Arg(32);
+BENCHMARK(BM_DmaFifoQueueSingle);
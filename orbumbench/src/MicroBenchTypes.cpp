@@ -0,0 +1,163 @@
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "Common/Types/Bitfield.hpp"
+#include "Common/Types/FpuFlags.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Resources/Ee/Core/EeCoreInstruction.hpp"
+#include "Utilities/Utilities.hpp"
+
+#include "MicroBench.hpp"
+
+/// Microbenchmarks of the primitives used by every instruction: bitfields, float conversion and decoding.
+
+/// Random values, shared by the benchmarks below.
+struct TypesBenchData
+{
+    static std::vector<uword> make_words(const std::uint32_t seed)
+    {
+        BenchRandom random(seed);
+        std::vector<uword> words(BENCH_STREAM_LENGTH);
+        for (auto& word : words)
+            word = random.next();
+        return words;
+    }
+
+    /// Floats in the proportions the VU/FPU tends to see: mostly normal values, with some zero,
+    /// denormal, infinite and NaN values (which need the PS2 clamping).
+    static std::vector<f32> make_floats()
+    {
+        const uword specials[] = {0x00000000, 0x80000000, 0x00000001, 0x807FFFFF, 0x7F800000, 0xFF800000, 0x7FC00000, 0xFFFFFFFF};
+
+        BenchRandom random(4);
+        std::vector<f32> floats(BENCH_STREAM_LENGTH);
+        for (auto& value : floats)
+        {
+            uword bits = random.next();
+            if ((random.next() % 100) < 10)
+                bits = specials[random.next() % (sizeof(specials) / sizeof(specials[0]))];
+            else if (((bits >> 23) & 0xFF) == 0xFF || ((bits >> 23) & 0xFF) == 0x00)
+                bits ^= 0x40000000; // Keep the rest normal.
+            std::memcpy(&value, &bits, sizeof(value));
+        }
+
+        return floats;
+    }
+
+    /// Instruction words, either a common instruction mix (as seen in the BIOS) or random words
+    /// that decode to a valid instruction (exercising the whole lookup table).
+    static std::vector<uword> make_instructions(const bool common)
+    {
+        const uword common_words[] = {
+            0x00000000, // SLL (NOP)
+            0x24420001, // ADDIU
+            0x8C820000, // LW
+            0xAC820000, // SW
+            0x14400003, // BNE
+            0x10000003, // BEQ
+            0x0C000000, // JAL
+            0x03E00008, // JR
+            0x00851021, // ADDU
+            0x3C021000, // LUI
+            0x34420001, // ORI
+            0x0044102B, // SLTU
+            0x40026000, // MFC0
+            0x7C820000, // SQ
+            0x70851089, // MMI2
+        };
+
+        BenchRandom random(5);
+        std::vector<uword> words;
+        words.reserve(BENCH_STREAM_LENGTH);
+        while (words.size() < BENCH_STREAM_LENGTH)
+        {
+            if (common)
+            {
+                words.push_back(common_words[random.next() % (sizeof(common_words) / sizeof(common_words[0]))]);
+                continue;
+            }
+
+            const uword word = random.next();
+            try
+            {
+                EeCoreInstruction(word).get_info();
+                words.push_back(word);
+            }
+            catch (const std::runtime_error&)
+            {
+                // Not a valid instruction.
+            }
+        }
+
+        return words;
+    }
+};
+
+void BM_BitfieldExtract(benchmark::State& state)
+{
+    const auto words = TypesBenchData::make_words(6);
+    constexpr Bitfield FIELD = Bitfield(11, 5);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(FIELD.extract_from(words[i++ & BENCH_STREAM_MASK]));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_BitfieldInsert(benchmark::State& state)
+{
+    const auto words = TypesBenchData::make_words(7);
+    constexpr Bitfield FIELD = Bitfield(11, 5);
+
+    size_t i = 0;
+    uword value = 0;
+    for (auto _ : state)
+    {
+        value = FIELD.insert_into(value, words[i++ & BENCH_STREAM_MASK]);
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+void BM_ToPs2Float(benchmark::State& state)
+{
+    const auto floats = TypesBenchData::make_floats();
+
+    size_t i = 0;
+    FpuFlags flags;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(to_ps2_float(floats[i++ & BENCH_STREAM_MASK], flags));
+    }
+
+    benchmark::DoNotOptimize(flags);
+    state.SetItemsProcessed(state.iterations());
+}
+
+/// Decodes a fresh instruction each iteration (the interpreter caches get_info() per instruction).
+/// The argument selects the common instruction mix (1) or valid random words (0).
+void BM_EeCoreInstructionLookup(benchmark::State& state)
+{
+    const auto words = TypesBenchData::make_instructions(state.range(0) != 0);
+
+    size_t i = 0;
+    for (auto _ : state)
+    {
+        EeCoreInstruction inst(words[i++ & BENCH_STREAM_MASK]);
+        benchmark::DoNotOptimize(inst.get_info());
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_BitfieldExtract);
+BENCHMARK(BM_BitfieldInsert);
+BENCHMARK(BM_ToPs2Float);
+BENCHMARK(BM_EeCoreInstructionLookup)->Arg(0)->Arg(1);
@@ -0,0 +1,286 @@
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include <boost/filesystem.hpp>
+
+#include <Core.hpp>
+
+#include "Workloads.hpp"
+
+/// Benchmark options, see print_usage().
+struct BenchOptions
+{
+    std::string workload = "bios";
+    double seconds = 1.0;
+    bool until_pc_enabled = false;
+    std::uint32_t until_pc = 0;
+    size_t until_cycles = 0;
+    double timeout_seconds = 0.0;
+    bool eecore_recompiler = false;
+    bool fastmem = true;
+    bool controller_affinity = false;
+    bool adaptive_time_slice = false;
+    size_t number_workers = 1;
+    std::string bios_dir = "./bios/";
+    std::string bios_file = "scph10000.bin";
+    std::string output_path;
+    std::string trace_path;
+};
+
+void print_usage()
+{
+    std::cerr << "Usage: orbumbench [options]\n"
+              << "Runs the core headlessly and prints the run statistics as JSON to stdout (core logging goes to stderr).\n"
+              << "  --workload <name>        bios (default), or a synthetic program: alu, memory, branch, mmi\n"
+              << "  --seconds <s>            emulated seconds to run for (default 1)\n"
+              << "  --until-pc <hex>         stop once the EE Core PC is at the address (checked between runs, use an idle loop)\n"
+              << "  --until-cycles <n>       stop once the EE Core has run n cycles\n"
+              << "  --timeout <s>            stop after this many host seconds\n"
+              << "  --recompiler             use the EE Core recompiler\n"
+              << "  --no-fastmem             disable fastmem\n"
+              << "  --affinity               run the controllers on dedicated threads\n"
+              << "  --adaptive-slice         adapt the time slice of each run to the interrupt/DMA activity\n"
+              << "  --workers <n>            number of worker threads (default 1)\n"
+              << "  --bios-dir <path>        bios directory (default ./bios/)\n"
+              << "  --bios <file>            bios file name (default scph10000.bin)\n"
+              << "  --output <path>          also write the JSON to a file\n"
+              << "  --trace <path>           record a timeline and write it as a Chrome trace JSON (chrome://tracing, Perfetto)\n"
+              << "  --help                   show this help\n"
+              << std::flush;
+}
+
+BenchOptions parse_options(int argc, char* argv[])
+{
+    BenchOptions options;
+    for (int i = 1; i < argc; i++)
+    {
+        const std::string arg = argv[i];
+        auto value = [&]() -> std::string {
+            if (i + 1 >= argc)
+                throw std::runtime_error("Missing value for " + arg);
+            return argv[++i];
+        };
+
+        if (arg == "--workload")
+            options.workload = value();
+        else if (arg == "--seconds")
+            options.seconds = std::stod(value());
+        else if (arg == "--until-pc")
+        {
+            options.until_pc_enabled = true;
+            options.until_pc = static_cast<std::uint32_t>(std::stoul(value(), nullptr, 16));
+        }
+        else if (arg == "--until-cycles")
+            options.until_cycles = std::stoull(value());
+        else if (arg == "--timeout")
+            options.timeout_seconds = std::stod(value());
+        else if (arg == "--recompiler")
+            options.eecore_recompiler = true;
+        else if (arg == "--no-fastmem")
+            options.fastmem = false;
+        else if (arg == "--affinity")
+            options.controller_affinity = true;
+        else if (arg == "--adaptive-slice")
+            options.adaptive_time_slice = true;
+        else if (arg == "--workers")
+            options.number_workers = std::stoul(value());
+        else if (arg == "--bios-dir")
+            options.bios_dir = value();
+        else if (arg == "--bios")
+            options.bios_file = value();
+        else if (arg == "--output")
+            options.output_path = value();
+        else if (arg == "--trace")
+            options.trace_path = value();
+        else
+            throw std::runtime_error("Unknown option " + arg);
+    }
+
+    if (options.workload != "bios" && !Workloads::is_synthetic(options.workload))
+        throw std::runtime_error("Unknown workload " + options.workload);
+
+    return options;
+}
+
+/// Formats the run statistics as JSON.
+/// Rates are per host second, speed is emulated time / host time (1.0 is real time).
+std::string format_results(const BenchOptions& options, const std::string& stop_reason, const CoreStats& stats, const double host_time_s)
+{
+    const double emulated_time_s = stats.time_us / 1e6;
+    auto rate = [host_time_s](const double count) {
+        return (host_time_s > 0.0) ? (count / host_time_s) : 0.0;
+    };
+    auto hex = [](const std::uint32_t value) {
+        std::ostringstream ss;
+        ss << "\"0x" << std::hex << std::setw(8) << std::setfill('0') << value << "\"";
+        return ss.str();
+    };
+
+    const auto& eecore = stats.controllers[static_cast<size_t>(ControllerType::Type::EeCore)];
+    const auto& iopcore = stats.controllers[static_cast<size_t>(ControllerType::Type::IopCore)];
+
+    std::ostringstream json;
+    json << std::setprecision(6) << std::fixed;
+    json << "{\n"
+         << "  \"workload\": \"" << options.workload << "\",\n"
+         << "  \"eecore_recompiler\": " << (options.eecore_recompiler ? "true" : "false") << ",\n"
+         << "  \"fastmem\": " << (options.fastmem ? "true" : "false") << ",\n"
+         << "  \"controller_affinity\": " << (options.controller_affinity ? "true" : "false") << ",\n"
+         << "  \"adaptive_time_slice\": " << (options.adaptive_time_slice ? "true" : "false") << ",\n"
+         << "  \"number_workers\": " << options.number_workers << ",\n"
+         << "  \"stop_reason\": \"" << stop_reason << "\",\n"
+         << "  \"emulated_time_s\": " << emulated_time_s << ",\n"
+         << "  \"host_time_s\": " << host_time_s << ",\n"
+         << "  \"speed\": " << rate(emulated_time_s) << ",\n"
+         << "  \"runs\": " << stats.runs << ",\n"
+         << "  \"runs_per_s\": " << rate(static_cast<double>(stats.runs)) << ",\n"
+         << "  \"time_slice_us\": " << stats.time_slice_us << ",\n"
+         << "  \"average_time_slice_us\": " << (stats.runs ? (stats.time_us / stats.runs) : 0.0) << ",\n"
+         << "  \"eecore_pc\": " << hex(stats.eecore_pc) << ",\n"
+         << "  \"iopcore_pc\": " << hex(stats.iopcore_pc) << ",\n"
+         << "  \"eecore_cycles\": " << eecore.ticks << ",\n"
+         << "  \"eecore_instructions\": " << eecore.instructions << ",\n"
+         << "  \"eecore_instructions_per_s\": " << rate(static_cast<double>(eecore.instructions)) << ",\n"
+         << "  \"iopcore_instructions\": " << iopcore.instructions << ",\n"
+         << "  \"iopcore_instructions_per_s\": " << rate(static_cast<double>(iopcore.instructions)) << ",\n"
+         << "  \"controllers\": {\n";
+
+    constexpr size_t count = static_cast<size_t>(ControllerType::Type::COUNT);
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto& controller = stats.controllers[i];
+        const double controller_time_s = controller.host_time_us / 1e6;
+        json << "    \"" << ControllerType::TYPE_STRINGS[i] << "\": {"
+             << "\"events\": " << controller.events << ", "
+             << "\"host_time_s\": " << controller_time_s << ", "
+             << "\"host_time_fraction\": " << ((host_time_s > 0.0) ? (controller_time_s / host_time_s) : 0.0) << ", "
+             << "\"ticks\": " << controller.ticks << ", "
+             << "\"instructions\": " << controller.instructions << ", "
+             << "\"instructions_per_s\": " << rate(static_cast<double>(controller.instructions)) << "}"
+             << ((i + 1 < count) ? "," : "") << "\n";
+    }
+
+    json << "  }\n"
+         << "}\n";
+
+    return json.str();
+}
+
+int main(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::string(argv[i]) == "--help")
+        {
+            print_usage();
+            return 0;
+        }
+    }
+
+    BenchOptions options;
+    try
+    {
+        options = parse_options(argc, argv);
+    }
+    catch (const std::exception& e)
+    {
+        std::cerr << "Invalid arguments: " << e.what() << std::endl;
+        print_usage();
+        return 1;
+    }
+
+    // The core logs (and prints its debug title) to stdout, keep stdout for the results only.
+    std::streambuf* stdout_buffer = std::cout.rdbuf(std::cerr.rdbuf());
+
+    boost::filesystem::path synthetic_dir;
+    try
+    {
+        CoreOptions core_options = CoreOptions::make_default();
+        core_options.eecore_recompiler = options.eecore_recompiler;
+        core_options.fastmem = options.fastmem;
+        core_options.controller_affinity = options.controller_affinity;
+        core_options.adaptive_time_slice = options.adaptive_time_slice;
+        core_options.number_workers = options.number_workers;
+        core_options.tracing = !options.trace_path.empty();
+
+        // Synthetic workloads are written out as a boot ROM image into a temporary directory.
+        std::string roms_dir = options.bios_dir;
+        std::string boot_rom_file = options.bios_file;
+        if (Workloads::is_synthetic(options.workload))
+        {
+            synthetic_dir = boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("orbumbench-%%%%-%%%%");
+            boost::filesystem::create_directories(synthetic_dir);
+
+            const auto image = Workloads::make_boot_rom(options.workload);
+            roms_dir = synthetic_dir.string() + "/";
+            boot_rom_file = options.workload + ".bin";
+            std::ofstream file(roms_dir + boot_rom_file, std::ios_base::binary);
+            file.write(reinterpret_cast<const char*>(image.data()), image.size());
+            if (!file)
+                throw std::runtime_error("Unable to write the synthetic boot ROM");
+        }
+        core_options.roms_dir_path = roms_dir.c_str();
+        core_options.boot_rom_file_name = boot_rom_file.c_str();
+        core_options.rom1_file_name = "";
+        core_options.rom2_file_name = "";
+        core_options.erom_file_name = "";
+
+        CoreApi core(core_options);
+
+        // Run until a stop condition is met.
+        std::string stop_reason;
+        const auto host_t1 = std::chrono::steady_clock::now();
+        double host_time_s = 0.0;
+        while (true)
+        {
+            core.run();
+
+            const CoreStats stats = core.get_stats();
+            host_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - host_t1).count();
+            if (stats.time_us >= options.seconds * 1e6)
+                stop_reason = "time";
+            else if (options.until_pc_enabled && stats.eecore_pc == options.until_pc)
+                stop_reason = "pc";
+            else if (options.until_cycles && stats.controllers[static_cast<size_t>(ControllerType::Type::EeCore)].ticks >= options.until_cycles)
+                stop_reason = "cycles";
+            else if (options.timeout_seconds > 0.0 && host_time_s >= options.timeout_seconds)
+                stop_reason = "timeout";
+
+            if (!stop_reason.empty())
+                break;
+        }
+
+        const std::string results = format_results(options, stop_reason, core.get_stats(), host_time_s);
+        if (!options.trace_path.empty())
+            core.save_trace(options.trace_path);
+
+        std::cout.rdbuf(stdout_buffer);
+        std::cout << results << std::flush;
+        if (!options.output_path.empty())
+        {
+            std::ofstream file(options.output_path);
+            file << results;
+            if (!file)
+                throw std::runtime_error("Unable to write the results to " + options.output_path);
+        }
+    }
+    catch (const std::exception& e)
+    {
+        std::cout.rdbuf(stdout_buffer);
+        std::cerr << "Benchmark error: " << e.what() << std::endl;
+        if (!synthetic_dir.empty())
+            boost::filesystem::remove_all(synthetic_dir);
+        return 1;
+    }
+
+    if (!synthetic_dir.empty())
+        boost::filesystem::remove_all(synthetic_dir);
+
+    return 0;
+}
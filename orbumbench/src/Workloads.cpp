@@ -0,0 +1,292 @@
+#include <algorithm>
+#include <stdexcept>
+
+#include "Workloads.hpp"
+
+/// Register numbers used.
+constexpr int ZERO = 0, AT = 1, T0 = 8, T1 = 9, T2 = 10, T3 = 11, T4 = 12, T5 = 13, T6 = 14, T7 = 15,
+              S0 = 16, S1 = 17, S2 = 18, S3 = 19, K0 = 26, RA = 31;
+
+/// Opcodes and function codes used.
+constexpr std::uint32_t OP_JAL = 0x03, OP_BEQ = 0x04, OP_BNE = 0x05, OP_ADDIU = 0x09, OP_SLTIU = 0x0B,
+                        OP_ANDI = 0x0C, OP_ORI = 0x0D, OP_XORI = 0x0E, OP_LUI = 0x0F, OP_DADDIU = 0x19,
+                        OP_LQ = 0x1E, OP_SQ = 0x1F, OP_LW = 0x23, OP_SW = 0x2B, OP_LD = 0x37, OP_SD = 0x3F;
+constexpr std::uint32_t FN_SLL = 0x00, FN_SRL = 0x02, FN_SRA = 0x03, FN_SLLV = 0x04, FN_JR = 0x08,
+                        FN_ADDU = 0x21, FN_SUBU = 0x23, FN_AND = 0x24, FN_OR = 0x25, FN_XOR = 0x26,
+                        FN_NOR = 0x27, FN_SLT = 0x2A, FN_SLTU = 0x2B, FN_DADDU = 0x2D, FN_DSUBU = 0x2F,
+                        FN_DSLL = 0x38, FN_DSRL = 0x3A, FN_DSLL32 = 0x3C;
+constexpr std::uint32_t MMI_PADDW = 0x00, MMI_PSUBW = 0x01, MMI_PCGTW = 0x02, MMI_PMAXW = 0x03,
+                        MMI_PADDH = 0x04, MMI_PSUBH = 0x05, MMI_PCGTH = 0x06, MMI_PADDB = 0x08,
+                        MMI_PSUBB = 0x09, MMI_PADDSW = 0x10, MMI_PEXTLW = 0x12, MMI_PPACW = 0x13,
+                        MMI_PADDSB = 0x18, MMI_PEXTLB = 0x1A, MMI_PPACB = 0x1B;
+
+/// KSEG0 (cached, unmapped) and KSEG1 (uncached, unmapped) segment bases.
+constexpr std::uint32_t KSEG0 = 0x80000000;
+constexpr std::uint32_t KSEG1 = 0xA0000000;
+
+/// Physical address of the boot ROM.
+constexpr std::uint32_t BOOT_ROM_ADDRESS = 0x1FC00000;
+
+MipsProgram::MipsProgram(const std::uint32_t base_address) :
+    base_address(base_address)
+{
+}
+
+size_t MipsProgram::here() const
+{
+    return code.size();
+}
+
+void MipsProgram::special(const std::uint32_t funct, const int rd, const int rs, const int rt, const int sa)
+{
+    code.push_back((rs << 21) | (rt << 16) | (rd << 11) | (sa << 6) | funct);
+}
+
+void MipsProgram::immediate(const std::uint32_t opcode, const int rt, const int rs, const std::uint16_t imm)
+{
+    code.push_back((opcode << 26) | (rs << 21) | (rt << 16) | imm);
+}
+
+size_t MipsProgram::branch(const std::uint32_t opcode, const int rs, const int rt, const size_t target)
+{
+    const size_t index = here();
+    code.push_back((opcode << 26) | (rs << 21) | (rt << 16));
+    patch(index, target);
+    return index;
+}
+
+size_t MipsProgram::jal(const size_t target)
+{
+    const size_t index = here();
+    code.push_back(OP_JAL << 26);
+    patch(index, target);
+    return index;
+}
+
+void MipsProgram::mfc0(const int rt, const int rd)
+{
+    code.push_back((0x10 << 26) | (rt << 16) | (rd << 11));
+}
+
+void MipsProgram::mmi0(const std::uint32_t subop, const int rd, const int rs, const int rt)
+{
+    code.push_back((0x1C << 26) | (rs << 21) | (rt << 16) | (rd << 11) | (subop << 6) | 0x08);
+}
+
+void MipsProgram::nop()
+{
+    code.push_back(0);
+}
+
+void MipsProgram::patch(const size_t index, const size_t target)
+{
+    std::uint32_t& inst = code.at(index);
+    if ((inst >> 26) == OP_JAL)
+    {
+        const std::uint32_t address = base_address + static_cast<std::uint32_t>(target * 4);
+        inst = (OP_JAL << 26) | ((address >> 2) & 0x03FFFFFF);
+    }
+    else
+    {
+        const std::int32_t offset = static_cast<std::int32_t>(target) - static_cast<std::int32_t>(index + 1);
+        inst = (inst & 0xFFFF0000) | (offset & 0xFFFF);
+    }
+}
+
+const std::vector<std::uint32_t>& MipsProgram::get_code() const
+{
+    return code;
+}
+
+const std::vector<std::string> Workloads::NAMES = {"alu", "memory", "branch", "mmi"};
+
+bool Workloads::is_synthetic(const std::string& name)
+{
+    return std::find(NAMES.begin(), NAMES.end(), name) != NAMES.end();
+}
+
+std::vector<std::uint8_t> Workloads::make_boot_rom(const std::string& name)
+{
+    const MipsProgram kernel = make_kernel(name);
+    const MipsProgram loader = make_loader(kernel.get_code().size());
+
+    std::vector<std::uint8_t> image(BOOT_ROM_SIZE, 0);
+    auto write = [&image](size_t offset, const std::vector<std::uint32_t>& code) {
+        for (auto inst : code)
+        {
+            for (int i = 0; i < 4; i++)
+                image[offset++] = static_cast<std::uint8_t>(inst >> (i * 8));
+        }
+    };
+
+    write(0, loader.get_code());
+    write(KERNEL_ROM_OFFSET, kernel.get_code());
+    return image;
+}
+
+MipsProgram Workloads::make_loader(const size_t kernel_length)
+{
+    if (kernel_length > 0xFFFF)
+        throw std::runtime_error("Kernel is too long.");
+
+    // Both cores start at the reset vector, tell them apart by the PRId register
+    // (same as the BIOS): the EE Core's is >= 0x59, the IOP Core's is below.
+    MipsProgram p(KSEG1 | BOOT_ROM_ADDRESS);
+    p.mfc0(K0, 15);
+    p.nop();
+    p.immediate(OP_SLTIU, AT, K0, 0x59);
+    const size_t to_iop_idle = p.branch(OP_BNE, AT, ZERO);
+    p.nop();
+
+    // EE Core: copy the kernel into main memory and jump to it.
+    const std::uint32_t source = KSEG1 | BOOT_ROM_ADDRESS | KERNEL_ROM_OFFSET;
+    const std::uint32_t destination = KSEG0 | KERNEL_ADDRESS;
+    p.immediate(OP_LUI, T0, ZERO, source >> 16);
+    p.immediate(OP_ORI, T0, T0, source & 0xFFFF);
+    p.immediate(OP_LUI, T1, ZERO, destination >> 16);
+    p.immediate(OP_ORI, T1, T1, destination & 0xFFFF);
+    p.immediate(OP_ORI, T2, ZERO, static_cast<std::uint16_t>(kernel_length));
+    const size_t copy = p.here();
+    p.immediate(OP_LW, T3, T0, 0);
+    p.immediate(OP_ADDIU, T0, T0, 4);
+    p.immediate(OP_SW, T3, T1, 0);
+    p.immediate(OP_ADDIU, T2, T2, 0xFFFF);
+    p.branch(OP_BNE, T2, ZERO, copy);
+    p.immediate(OP_ADDIU, T1, T1, 4);
+    p.immediate(OP_LUI, T0, ZERO, destination >> 16);
+    p.immediate(OP_ORI, T0, T0, destination & 0xFFFF);
+    p.special(FN_JR, 0, T0, 0);
+    p.nop();
+
+    // IOP Core: idle.
+    p.patch(to_iop_idle, p.here());
+    p.branch(OP_BEQ, ZERO, ZERO, p.here());
+    p.nop();
+
+    return p;
+}
+
+MipsProgram Workloads::make_kernel(const std::string& name)
+{
+    MipsProgram p(KSEG0 | KERNEL_ADDRESS);
+
+    if (name == "alu")
+    {
+        for (int reg = T0; reg <= S3; reg++)
+            p.immediate(OP_ORI, reg, ZERO, static_cast<std::uint16_t>(0x1234 * reg + 1));
+
+        const size_t loop = p.here();
+        for (int i = 0; i < 4; i++)
+        {
+            p.special(FN_ADDU, T0, T0, T1);
+            p.special(FN_XOR, T2, T2, T0);
+            p.special(FN_SLL, T3, 0, T0, 3);
+            p.special(FN_SUBU, T1, T1, T3);
+            p.special(FN_OR, T4, T4, T2);
+            p.special(FN_SLT, T5, T1, T0);
+            p.immediate(OP_ADDIU, T6, T6, 1);
+            p.special(FN_SRL, T7, 0, T2, 5);
+            p.special(FN_AND, S0, T7, T4);
+            p.special(FN_NOR, S1, S0, T5);
+            p.special(FN_DADDU, S2, S2, T0);
+            p.special(FN_DSLL32, S3, 0, S2, 4);
+            p.special(FN_DSUBU, S3, S3, T4);
+            p.special(FN_SLTU, T5, S3, T2);
+            p.immediate(OP_XORI, T7, T7, 0x5A5A);
+            p.special(FN_SRA, T3, 0, T1, 7);
+            p.special(FN_SLLV, T4, T4, T6);
+            p.special(FN_DSRL, S1, 0, S2, 9);
+            p.immediate(OP_DADDIU, S0, S0, 0x0FFF);
+        }
+        p.branch(OP_BEQ, ZERO, ZERO, loop);
+        p.nop();
+    }
+    else if (name == "memory")
+    {
+        // Buffer at 1MB -> 2MB of main memory, clear of the kernel.
+        p.immediate(OP_LUI, S0, ZERO, (KSEG0 | 0x00100000) >> 16);
+        p.immediate(OP_LUI, S1, ZERO, (KSEG0 | 0x00200000) >> 16);
+
+        const size_t outer = p.here();
+        p.special(FN_OR, T0, S0, ZERO);
+        const size_t inner = p.here();
+        p.immediate(OP_LW, T2, T0, 0);
+        p.immediate(OP_LD, T3, T0, 8);
+        p.immediate(OP_LQ, T4, T0, 16);
+        p.special(FN_ADDU, T2, T2, T0);
+        p.special(FN_DADDU, T3, T3, T2);
+        p.immediate(OP_SW, T2, T0, 32);
+        p.immediate(OP_SD, T3, T0, 40);
+        p.immediate(OP_SQ, T4, T0, 48);
+        p.immediate(OP_ADDIU, T0, T0, 64);
+        p.branch(OP_BNE, T0, S1, inner);
+        p.nop();
+        p.branch(OP_BEQ, ZERO, ZERO, outer);
+        p.nop();
+    }
+    else if (name == "branch")
+    {
+        const size_t loop = p.here();
+        p.immediate(OP_ADDIU, S0, S0, 1);
+        p.immediate(OP_ANDI, T0, S0, 1);
+        const size_t to_even = p.branch(OP_BEQ, T0, ZERO);
+        p.nop();
+        p.immediate(OP_ADDIU, T1, T1, 3);
+        const size_t to_join = p.branch(OP_BEQ, ZERO, ZERO);
+        p.nop();
+
+        p.patch(to_even, p.here());
+        const size_t to_function = p.jal();
+        p.nop();
+
+        p.patch(to_join, p.here());
+        p.immediate(OP_ANDI, T2, S0, 7);
+        p.branch(OP_BNE, T2, ZERO, loop);
+        p.immediate(OP_ADDIU, T3, T3, 1);
+        p.branch(OP_BEQ, ZERO, ZERO, loop);
+        p.nop();
+
+        p.patch(to_function, p.here());
+        p.special(FN_XOR, T4, T4, S0);
+        p.special(FN_JR, 0, RA, 0);
+        p.nop();
+    }
+    else if (name == "mmi")
+    {
+        for (int reg = T0; reg <= T7; reg++)
+        {
+            p.immediate(OP_LUI, reg, ZERO, static_cast<std::uint16_t>(0x9E37 * reg));
+            p.immediate(OP_ORI, reg, reg, static_cast<std::uint16_t>(0x7F4A * reg + 1));
+            p.special(FN_DSLL32, reg, 0, reg, 0);
+            p.immediate(OP_ORI, reg, reg, static_cast<std::uint16_t>(0x2545 * reg));
+        }
+
+        const size_t loop = p.here();
+        for (int i = 0; i < 4; i++)
+        {
+            p.mmi0(MMI_PADDW, T0, T0, T1);
+            p.mmi0(MMI_PSUBB, T2, T2, T0);
+            p.mmi0(MMI_PCGTW, T3, T0, T2);
+            p.mmi0(MMI_PMAXW, T4, T4, T3);
+            p.mmi0(MMI_PEXTLW, T5, T0, T2);
+            p.mmi0(MMI_PPACB, T6, T5, T4);
+            p.mmi0(MMI_PADDSB, T7, T7, T6);
+            p.mmi0(MMI_PSUBW, T1, T1, T7);
+            p.mmi0(MMI_PADDH, T2, T2, T5);
+            p.mmi0(MMI_PSUBH, T3, T3, T1);
+            p.mmi0(MMI_PCGTH, T4, T2, T3);
+            p.mmi0(MMI_PADDB, T5, T5, T4);
+            p.mmi0(MMI_PADDSW, T6, T6, T0);
+            p.mmi0(MMI_PEXTLB, T7, T6, T5);
+            p.mmi0(MMI_PPACW, T0, T7, T1);
+        }
+        p.branch(OP_BEQ, ZERO, ZERO, loop);
+        p.nop();
+    }
+    else
+    {
+        throw std::runtime_error("Unknown workload: " + name);
+    }
+
+    return p;
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// Minimal MIPS (R5900/R3000) assembler used to build the synthetic workloads.
+/// Instructions are appended in order, branches and jumps target instruction indexes.
+/// Forward targets are emitted first and patched once the target is known (see patch()).
+class MipsProgram
+{
+public:
+    MipsProgram(const std::uint32_t base_address);
+
+    /// Returns the index of the next instruction.
+    size_t here() const;
+
+    /// SPECIAL (R-type) instruction: op rd, rs, rt (or rd, rt, sa for the shifts).
+    void special(const std::uint32_t funct, const int rd, const int rs, const int rt, const int sa = 0);
+
+    /// I-type instruction: op rt, rs, imm (or rt, imm(rs) for loads/stores).
+    void immediate(const std::uint32_t opcode, const int rt, const int rs, const std::uint16_t imm);
+
+    /// Branch (BEQ/BNE) comparing rs and rt. Returns the index of the branch, for forward targets.
+    size_t branch(const std::uint32_t opcode, const int rs, const int rt, const size_t target = 0);
+
+    /// JAL to the target. Returns the index of the jump, for forward targets.
+    size_t jal(const size_t target = 0);
+
+    /// MFC0 rt, rd.
+    void mfc0(const int rt, const int rd);
+
+    /// MMI0 (parallel) instruction: op rd, rs, rt.
+    void mmi0(const std::uint32_t subop, const int rd, const int rs, const int rt);
+
+    void nop();
+
+    /// Sets the target of the branch or jump at the index given.
+    void patch(const size_t index, const size_t target);
+
+    const std::vector<std::uint32_t>& get_code() const;
+
+private:
+    std::uint32_t base_address;
+    std::vector<std::uint32_t> code;
+};
+
+/// Synthetic benchmark workloads.
+/// Each one is a boot ROM image holding a small loader and a kernel. The EE Core copies the kernel
+/// into main memory and runs it from there forever (ie: like a real program, it is memory-resident
+/// and goes through the instruction/block caches). The IOP Core idles in a loop in the ROM.
+/// The images are deterministic, so the numbers are comparable across builds.
+struct Workloads
+{
+    /// Names of the synthetic workloads.
+    ///  - alu: a straight line block of integer ALU instructions.
+    ///  - memory: loads and stores (word to qword) streaming over a 1MB buffer.
+    ///  - branch: a mix of taken/not taken branches and subroutine calls.
+    ///  - mmi: the parallel (MMI) integer instructions.
+    static const std::vector<std::string> NAMES;
+
+    /// Physical address the kernels are copied to and run from (through KSEG0).
+    static constexpr std::uint32_t KERNEL_ADDRESS = 0x00010000;
+
+    /// Offset of the kernel within the boot ROM image.
+    static constexpr std::uint32_t KERNEL_ROM_OFFSET = 0x1000;
+
+    static constexpr size_t BOOT_ROM_SIZE = 0x400000;
+
+    /// Returns if the name is a synthetic workload.
+    static bool is_synthetic(const std::string& name);
+
+    /// Builds the boot ROM image for the synthetic workload, padded to the boot ROM size.
+    static std::vector<std::uint8_t> make_boot_rom(const std::string& name);
+
+private:
+    static MipsProgram make_loader(const size_t kernel_length);
+    static MipsProgram make_kernel(const std::string& name);
+};
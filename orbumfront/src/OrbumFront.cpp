@@ -1,4 +1,5 @@
 #include <csignal>
+#include <iomanip>
 #include <iostream>
 #include <string>
 
@@ -28,6 +29,7 @@ void signal_handler(int signal)
 #endif
 
 void main_menu(CoreApi& core);
+void print_perf_stats(const CoreStats& stats);
 
 int main(int argc, char* argv[])
 {
@@ -80,10 +82,12 @@ void main_menu(CoreApi& core)
     while (true)
     {
         std::cout << "\nOrbum main menu\n"
-                  << "  1. (s)ave state (json)\n"
-                  << "  2. (d)ump all memory (binary)\n"
-                  << "  3. (c)ontinue\n"
-                  << "  4. (q)uit\n"
+                  << "  1. (s)ave state\n"
+                  << "  2. (l)oad state\n"
+                  << "  3. (d)ump all memory (binary)\n"
+                  << "  4. (p)rofiling counters\n"
+                  << "  5. (c)ontinue\n"
+                  << "  6. (q)uit\n"
                   << "\nSelect an option: "
                   << std::flush;
 
@@ -111,6 +115,25 @@ void main_menu(CoreApi& core)
             break;
         }
         case '2':
+        case 'l':
+        {
+            std::cout << "Save state file path: " << std::flush;
+            std::string path;
+            std::getline(std::cin, path);
+
+            std::cout << "Loading state..." << std::endl;
+            try
+            {
+                core.load_state(path);
+                std::cout << "Loaded state ok" << std::endl;
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cout << "Unable to load state: " << e.what() << std::endl;
+            }
+            break;
+        }
+        case '3':
         case 'd':
         {
             std::cout << "Dumping memory..." << std::endl;
@@ -118,12 +141,18 @@ void main_menu(CoreApi& core)
             std::cout << "Dumped memory ok" << std::endl;
             break;
         }
-        case '3':
+        case '4':
+        case 'p':
+        {
+            print_perf_stats(core.get_stats());
+            break;
+        }
+        case '5':
         case 'c':
         {
             goto exit_menu;
         }
-        case '4':
+        case '6':
         case 'q':
         {
             quit = true;
@@ -137,3 +166,35 @@ exit_menu:
     std::cout << std::endl;
     show_main_menu = false;
 }
+
+void print_perf_stats(const CoreStats& stats)
+{
+    std::cout << "\nProfiling counters (host time in runs: " << std::fixed << std::setprecision(3) << stats.host_time_us / 1e6 << " s)\n"
+              << std::left << std::setw(10) << "Controller"
+              << std::right << std::setw(12) << "Events"
+              << std::setw(12) << "Time (s)"
+              << std::setw(8) << "Time %"
+              << std::setw(14) << "Ticks"
+              << std::setw(8) << "Idle %"
+              << std::setw(14) << "DMA qwords";
+    for (auto region : PerfBusRegion::TYPE_STRINGS)
+        std::cout << std::setw(14) << region;
+    std::cout << "\n";
+
+    for (size_t i = 0; i < static_cast<size_t>(ControllerType::Type::COUNT); i++)
+    {
+        const auto& controller = stats.controllers[i];
+        std::cout << std::left << std::setw(10) << ControllerType::TYPE_STRINGS[i]
+                  << std::right << std::setw(12) << controller.events
+                  << std::setw(12) << std::setprecision(3) << controller.host_time_us / 1e6
+                  << std::setw(8) << std::setprecision(1) << ((stats.host_time_us > 0.0) ? (controller.host_time_us / stats.host_time_us * 100.0) : 0.0)
+                  << std::setw(14) << controller.ticks
+                  << std::setw(8) << std::setprecision(1) << (controller.ticks ? (100.0 * controller.idle_ticks / controller.ticks) : 0.0)
+                  << std::setw(14) << controller.dma_bytes / 16; // 16 bytes per qword.
+        for (auto accesses : controller.bus_accesses)
+            std::cout << std::setw(14) << accesses;
+        std::cout << "\n";
+    }
+
+    std::cout << std::defaultfloat << std::flush;
+}
@@ -0,0 +1,62 @@
+#include <cstring>
+#include <exception>
+#include <iostream>
+
+#include "Tests.hpp"
+
+/// A named test, returning the number of failures.
+struct Test
+{
+    const char* name;
+    size_t (*fn)();
+};
+
+constexpr Test TESTS[] = {
+    {"vector_float", test_vector_float},
+    {"vector_integer", test_vector_integer},
+};
+
+int main(int argc, char* argv[])
+{
+    if (argc > 2 || (argc == 2 && !std::strcmp(argv[1], "--help")))
+    {
+        std::cerr << "Usage: orbumtest [test]\n"
+                  << "Runs the named test, or all of them. Returns non-zero if any failed.\n"
+                  << "Tests:";
+        for (const auto& test : TESTS)
+            std::cerr << " " << test.name;
+        std::cerr << std::endl;
+        return 2;
+    }
+
+    bool found = false;
+    size_t failures = 0;
+    for (const auto& test : TESTS)
+    {
+        if (argc == 2 && std::strcmp(argv[1], test.name))
+            continue;
+        found = true;
+
+        size_t test_failures;
+        try
+        {
+            test_failures = test.fn();
+        }
+        catch (const std::exception& e)
+        {
+            std::cout << test.name << ": exception: " << e.what() << std::endl;
+            test_failures = 1;
+        }
+
+        std::cout << test.name << ": " << (test_failures ? "FAILED" : "passed") << std::endl;
+        failures += test_failures;
+    }
+
+    if (!found)
+    {
+        std::cerr << "Unknown test: " << argv[1] << std::endl;
+        return 2;
+    }
+
+    return failures ? 1 : 0;
+}
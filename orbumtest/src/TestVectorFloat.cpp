@@ -0,0 +1,237 @@
+#include <algorithm>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+#include "Common/Types/FpuFlags.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Resources/Ee/Vpu/Vu/VuUnitRegisters.hpp"
+#include "Resources/Ee/Vpu/Vu/VuVectorField.hpp"
+#include "Utilities/Utilities.hpp"
+#include "Utilities/VectorFloat.hpp"
+
+#include "Tests.hpp"
+
+/// Number of random operand sets run through each op.
+constexpr size_t VECTOR_FLOAT_ITERATIONS = 1 << 18;
+
+/// Number of mismatches printed before going quiet.
+constexpr size_t VECTOR_FLOAT_MAX_REPORTS = 16;
+
+/// Values which need the PS2 clamping or are on the edge of it: +/- 0, denormals, Inf, NaN's (quiet and signalling),
+/// +/- Fmax and large values (overflow when added or multiplied), the smallest normals (underflow when multiplied), +/- 1.
+constexpr uword VECTOR_FLOAT_SPECIALS[] = {
+    0x00000000, 0x80000000, 0x00000001, 0x807FFFFF, 0x7F800000, 0xFF800000, 0x7FC00000, 0xFFC00000,
+    0x7F800001, 0x7F7FFFFF, 0xFF7FFFFF, 0x7F000000, 0x00800000, 0x80800000, 0x3F800000, 0xBF800000};
+
+/// The VU MAC and status registers, linked as in a VU unit.
+struct VectorFloatFlagRegisters
+{
+    VectorFloatFlagRegisters(const uword mac_value, const uword status_value)
+    {
+        mac.status = &status;
+        mac.write_uword(mac_value);
+        status.write_uword(status_value);
+    }
+
+    VuUnitRegister_Status status;
+    VuUnitRegister_Mac mac;
+};
+
+/// The results of one path, compared between the paths.
+struct VectorFloatResult
+{
+    uqword value;
+    uword mac;
+    uword status;
+
+    bool operator==(const VectorFloatResult& other) const
+    {
+        return !std::memcmp(&value, &other.value, sizeof(value)) && mac == other.mac && status == other.status;
+    }
+};
+
+uqword make_vector_float_operand(TestRandom& random)
+{
+    constexpr size_t number_specials = sizeof(VECTOR_FLOAT_SPECIALS) / sizeof(VECTOR_FLOAT_SPECIALS[0]);
+
+    uqword operand;
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        operand.uw[i] = ((random.next() % 100) < 40) ? VECTOR_FLOAT_SPECIALS[random.next() % number_specials] : random.next();
+    return operand;
+}
+
+/// Runs the op as CVuInterpreter::execute_float_op() does, with either the vectorised or the scalar kernel.
+VectorFloatResult run_vector_float_op(const bool scalar, const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c, const ubyte dest,
+                                      const uqword& old_value, const uword mac_value, const uword status_value)
+{
+    VectorFloatFlagRegisters registers(mac_value, status_value);
+
+    FpuVectorFlags product_flags;
+    FpuVectorFlags flags;
+    const uqword value = scalar ? vector_float_op_scalar(op, a, b, c, dest, product_flags, flags)
+                                : vector_float_op(op, a, b, c, dest, product_flags, flags);
+
+    if (op == VectorFloatOp::MADD || op == VectorFloatOp::MSUB)
+        registers.mac.update_vector_fields(product_flags);
+    registers.mac.update_vector_fields(flags);
+
+    return {vector_float_merge(old_value, value, dest), registers.mac.read_uword(), registers.status.read_uword()};
+}
+
+/// Runs the op the way the VU interpreter did before the vectorised kernels: one field at a time
+/// (x, y, z then w) with to_ps2_float(), updating the MAC flags for each field (cleared if not in dest).
+VectorFloatResult run_per_field_float_op(const VectorFloatOp op, const uqword& a, const uqword& b, const uqword& c, const ubyte dest,
+                                         const uqword& old_value, const uword mac_value, const uword status_value)
+{
+    VectorFloatFlagRegisters registers(mac_value, status_value);
+
+    uqword value = old_value;
+    FpuFlags flags;
+    for (auto field : VuVectorField::VECTOR_FIELDS)
+    {
+        if (!(dest & (1 << (NUMBER_WORDS_IN_QWORD - 1 - field))))
+        {
+            registers.mac.clear_vector_field(field);
+            continue;
+        }
+
+        const f32 fa = word_to_float(a.uw[field]);
+        const f32 fb = word_to_float(b.uw[field]);
+        const f32 fc = word_to_float(c.uw[field]);
+
+        f32 result;
+        switch (op)
+        {
+        case VectorFloatOp::ADD:
+            result = to_ps2_float(fa + fb, flags);
+            break;
+        case VectorFloatOp::SUB:
+            result = to_ps2_float(fa - fb, flags);
+            break;
+        case VectorFloatOp::MUL:
+            result = to_ps2_float(fa * fb, flags);
+            break;
+        case VectorFloatOp::MADD:
+        case VectorFloatOp::MSUB:
+        {
+            const f32 multiplied = to_ps2_float(fa * fb, flags);
+            registers.mac.update_vector_field(field, flags);
+            result = to_ps2_float((op == VectorFloatOp::MADD) ? (fc + multiplied) : (fc - multiplied), flags);
+            break;
+        }
+        case VectorFloatOp::OPMSUB:
+            result = to_ps2_float(fc - fa * fb, flags);
+            break;
+        default:
+            throw std::runtime_error("Unknown vector float op - please debug!");
+        }
+
+        registers.mac.update_vector_field(field, flags);
+        value.uw[field] = float_to_word(result);
+    }
+
+    return {value, registers.mac.read_uword(), registers.status.read_uword()};
+}
+
+std::string format_vector_float(const uqword& value)
+{
+    std::ostringstream stream;
+    stream << std::hex << std::setfill('0');
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        stream << (i ? " " : "") << std::setw(8) << value.uw[i];
+    return stream.str();
+}
+
+void report_vector_float_mismatch(const char* test, const char* path, const uqword& a, const uqword& b, const uqword& c, const ubyte dest,
+                                  const VectorFloatResult& expected, const VectorFloatResult& actual)
+{
+    std::cout << test << " (" << path << ") mismatch, dest = " << static_cast<int>(dest) << ":\n"
+              << "  a        = " << format_vector_float(a) << "\n"
+              << "  b        = " << format_vector_float(b) << "\n"
+              << "  c        = " << format_vector_float(c) << "\n"
+              << std::hex << std::setfill('0')
+              << "  expected = " << format_vector_float(expected.value) << ", mac = " << std::setw(8) << expected.mac << ", status = " << std::setw(8) << expected.status << "\n"
+              << "  actual   = " << format_vector_float(actual.value) << ", mac = " << std::setw(8) << actual.mac << ", status = " << std::setw(8) << actual.status << "\n"
+              << std::dec << std::flush;
+}
+
+size_t test_vector_float()
+{
+    struct NamedOp
+    {
+        const char* name;
+        VectorFloatOp op;
+    };
+    const NamedOp ops[] = {
+        {"ADD", VectorFloatOp::ADD},
+        {"SUB", VectorFloatOp::SUB},
+        {"MUL", VectorFloatOp::MUL},
+        {"MADD", VectorFloatOp::MADD},
+        {"MSUB", VectorFloatOp::MSUB},
+        {"OPMSUB", VectorFloatOp::OPMSUB}};
+
+    TestRandom random;
+    size_t failures = 0;
+    auto check = [&](const char* test, const char* path, const uqword& a, const uqword& b, const uqword& c, const ubyte dest,
+                     const VectorFloatResult& expected, const VectorFloatResult& actual) {
+        if (expected == actual)
+            return;
+        if (failures < VECTOR_FLOAT_MAX_REPORTS)
+            report_vector_float_mismatch(test, path, a, b, c, dest, expected, actual);
+        failures++;
+    };
+
+    for (const auto& named_op : ops)
+    {
+        for (size_t i = 0; i < VECTOR_FLOAT_ITERATIONS; i++)
+        {
+            const uqword a = make_vector_float_operand(random);
+            const uqword b = (random.next() % 8) ? make_vector_float_operand(random) : a; // Exact zero results.
+            const uqword c = make_vector_float_operand(random);
+            const uqword old_value = make_vector_float_operand(random);
+            const uword mac_value = random.next();
+            const uword status_value = random.next() & 0xFFF;
+
+            // OPMSUB always writes x, y, z (the operands are already rotated by the instruction).
+            const ubyte dest = (named_op.op == VectorFloatOp::OPMSUB) ? 0xE : static_cast<ubyte>(random.next() & 0xF);
+
+            const VectorFloatResult vector = run_vector_float_op(false, named_op.op, a, b, c, dest, old_value, mac_value, status_value);
+            const VectorFloatResult scalar = run_vector_float_op(true, named_op.op, a, b, c, dest, old_value, mac_value, status_value);
+            const VectorFloatResult per_field = run_per_field_float_op(named_op.op, a, b, c, dest, old_value, mac_value, status_value);
+
+            check(named_op.name, "vector vs scalar", a, b, c, dest, scalar, vector);
+            check(named_op.name, "vector vs per-field", a, b, c, dest, per_field, vector);
+        }
+    }
+
+    // MAX and MINI, against std::max() and std::min() as used per field before.
+    for (size_t i = 0; i < VECTOR_FLOAT_ITERATIONS; i++)
+    {
+        const uqword a = make_vector_float_operand(random);
+        const uqword b = (random.next() % 8) ? make_vector_float_operand(random) : vector_float_abs(a);
+
+        VectorFloatResult max_per_field = {uqword(), 0, 0};
+        VectorFloatResult min_per_field = {uqword(), 0, 0};
+        for (int field = 0; field < NUMBER_WORDS_IN_QWORD; field++)
+        {
+            max_per_field.value.uw[field] = float_to_word(std::max(word_to_float(a.uw[field]), word_to_float(b.uw[field])));
+            min_per_field.value.uw[field] = float_to_word(std::min(word_to_float(a.uw[field]), word_to_float(b.uw[field])));
+        }
+
+        const VectorFloatResult max_vector = {vector_float_max(a, b), 0, 0};
+        const VectorFloatResult max_scalar = {vector_float_max_scalar(a, b), 0, 0};
+        const VectorFloatResult min_vector = {vector_float_min(a, b), 0, 0};
+        const VectorFloatResult min_scalar = {vector_float_min_scalar(a, b), 0, 0};
+
+        check("MAX", "vector vs scalar", a, b, uqword(), 0xF, max_scalar, max_vector);
+        check("MAX", "vector vs per-field", a, b, uqword(), 0xF, max_per_field, max_vector);
+        check("MINI", "vector vs scalar", a, b, uqword(), 0xF, min_scalar, min_vector);
+        check("MINI", "vector vs per-field", a, b, uqword(), 0xF, min_per_field, min_vector);
+    }
+
+    return failures;
+}
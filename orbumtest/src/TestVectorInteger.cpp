@@ -0,0 +1,449 @@
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "Common/Constants.hpp"
+#include "Common/Types/Primitive.hpp"
+#include "Controller/Ee/Core/Interpreter/CEeCoreInterpreter.hpp"
+#include "Core.hpp"
+#include "Resources/RResources.hpp"
+#include "Utilities/VectorInteger.hpp"
+
+#include "Tests.hpp"
+
+/// Number of random operand sets run through each kernel or instruction.
+constexpr size_t VECTOR_INTEGER_ITERATIONS = 1 << 16;
+
+/// Number of mismatches printed before going quiet.
+constexpr size_t VECTOR_INTEGER_MAX_REPORTS = 16;
+
+/// Registers used by the instructions run through the interpreter.
+constexpr int VECTOR_INTEGER_RS = 1;
+constexpr int VECTOR_INTEGER_RT = 2;
+constexpr int VECTOR_INTEGER_RD = 3;
+
+int vector_integer_field_bits(const VectorIntegerWidth width)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return 8;
+    case VectorIntegerWidth::HWORD:
+        return 16;
+    case VectorIntegerWidth::WORD:
+        return 32;
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+udword get_vector_integer_field(const uqword& value, const VectorIntegerWidth width, const int field)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        return value.ub[field];
+    case VectorIntegerWidth::HWORD:
+        return value.uh[field];
+    case VectorIntegerWidth::WORD:
+        return value.uw[field];
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+void set_vector_integer_field(uqword& value, const VectorIntegerWidth width, const int field, const udword field_value)
+{
+    switch (width)
+    {
+    case VectorIntegerWidth::BYTE:
+        value.ub[field] = static_cast<ubyte>(field_value);
+        break;
+    case VectorIntegerWidth::HWORD:
+        value.uh[field] = static_cast<uhword>(field_value);
+        break;
+    case VectorIntegerWidth::WORD:
+        value.uw[field] = static_cast<uword>(field_value);
+        break;
+    default:
+        throw std::runtime_error("Unknown vector integer width - please debug!");
+    }
+}
+
+/// Makes an operand where each field is random, or one of the values on the edge of the signed and
+/// unsigned ranges (0, 1, -1 / unsigned max, signed min and signed max), which the saturating,
+/// max/min and compare operations are sensitive to.
+uqword make_vector_integer_operand(TestRandom& random, const VectorIntegerWidth width)
+{
+    const int bits = vector_integer_field_bits(width);
+    const udword mask = (static_cast<udword>(1) << bits) - 1;
+    const udword sign_bit = static_cast<udword>(1) << (bits - 1);
+    const udword specials[] = {0, 1, mask, sign_bit, sign_bit - 1};
+
+    uqword operand;
+    for (int i = 0; i < NUMBER_BYTES_IN_QWORD * 8 / bits; i++)
+    {
+        const udword value = ((random.next() % 100) < 40) ? specials[random.next() % 5] : (random.next() & mask);
+        set_vector_integer_field(operand, width, i, value);
+    }
+    return operand;
+}
+
+uqword make_vector_integer_operand(TestRandom& random)
+{
+    const VectorIntegerWidth widths[] = {VectorIntegerWidth::BYTE, VectorIntegerWidth::HWORD, VectorIntegerWidth::WORD};
+    return make_vector_integer_operand(random, widths[random.next() % 3]);
+}
+
+/// Runs the op one field at a time, as described in the EE Core Instruction Manual (the max, min and
+/// greater than compares are signed).
+uqword run_per_field_integer_op(const VectorIntegerOp op, const VectorIntegerWidth width, const uqword& a, const uqword& b)
+{
+    const int bits = vector_integer_field_bits(width);
+    const udword mask = (static_cast<udword>(1) << bits) - 1;
+    const sdword signed_max = static_cast<sdword>(mask >> 1);
+    const sdword signed_min = -signed_max - 1;
+
+    uqword result;
+    for (int i = 0; i < NUMBER_BYTES_IN_QWORD * 8 / bits; i++)
+    {
+        const udword ua = get_vector_integer_field(a, width, i);
+        const udword ub = get_vector_integer_field(b, width, i);
+        const sdword sa = (ua > static_cast<udword>(signed_max)) ? static_cast<sdword>(ua) - static_cast<sdword>(mask) - 1 : static_cast<sdword>(ua);
+        const sdword sb = (ub > static_cast<udword>(signed_max)) ? static_cast<sdword>(ub) - static_cast<sdword>(mask) - 1 : static_cast<sdword>(ub);
+
+        udword value;
+        switch (op)
+        {
+        case VectorIntegerOp::ADD:
+            value = ua + ub;
+            break;
+        case VectorIntegerOp::ADDS:
+            value = static_cast<udword>(std::clamp(sa + sb, signed_min, signed_max));
+            break;
+        case VectorIntegerOp::ADDU:
+            value = std::min(ua + ub, mask);
+            break;
+        case VectorIntegerOp::SUB:
+            value = ua - ub;
+            break;
+        case VectorIntegerOp::SUBS:
+            value = static_cast<udword>(std::clamp(sa - sb, signed_min, signed_max));
+            break;
+        case VectorIntegerOp::SUBU:
+            value = (ua > ub) ? (ua - ub) : 0;
+            break;
+        case VectorIntegerOp::MAX:
+            value = (sa > sb) ? ua : ub;
+            break;
+        case VectorIntegerOp::MIN:
+            value = (sa < sb) ? ua : ub;
+            break;
+        case VectorIntegerOp::CEQ:
+            value = (ua == ub) ? mask : 0;
+            break;
+        case VectorIntegerOp::CGT:
+            value = (sa > sb) ? mask : 0;
+            break;
+        default:
+            throw std::runtime_error("Unknown vector integer op - please debug!");
+        }
+
+        set_vector_integer_field(result, width, i, value & mask);
+    }
+    return result;
+}
+
+/// The results of an MMI instruction, compared between the interpreter and the reference.
+struct VectorIntegerResult
+{
+    uqword rd;
+    uqword lo;
+    uqword hi;
+
+    bool operator==(const VectorIntegerResult& other) const
+    {
+        return !std::memcmp(&rd, &other.rd, sizeof(rd)) && !std::memcmp(&lo, &other.lo, sizeof(lo)) && !std::memcmp(&hi, &other.hi, sizeof(hi));
+    }
+};
+
+/// PMADDH/PMSUBH per the EE Core Instruction Manual: the products of hwords 0, 1, 4, 5 accumulate into LO words 0 -> 3,
+/// and 2, 3, 6, 7 into HI words 0 -> 3. Rd = (LO[31:0], HI[31:0], LO[95:64], HI[95:64]).
+VectorIntegerResult run_reference_pmaddh(const bool subtract, const uqword& rs, const uqword& rt, const uqword& lo, const uqword& hi)
+{
+    constexpr int lo_hwords[] = {0, 1, 4, 5};
+    constexpr int hi_hwords[] = {2, 3, 6, 7};
+
+    auto product = [&](const int i) {
+        return static_cast<uword>(static_cast<sword>(static_cast<shword>(rs.uh[i])) * static_cast<shword>(rt.uh[i]));
+    };
+
+    VectorIntegerResult result = {uqword(), lo, hi};
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+    {
+        result.lo.uw[i] = subtract ? (lo.uw[i] - product(lo_hwords[i])) : (lo.uw[i] + product(lo_hwords[i]));
+        result.hi.uw[i] = subtract ? (hi.uw[i] - product(hi_hwords[i])) : (hi.uw[i] + product(hi_hwords[i]));
+    }
+    result.rd = uqword(result.lo.uw[0], result.hi.uw[0], result.lo.uw[2], result.hi.uw[2]);
+    return result;
+}
+
+/// PMADDW/PMSUBW per the EE Core Instruction Manual: for dwords i = 0, 1, the accumulator is HI[i][31:0] || LO[i][31:0]
+/// (LO is not sign extended into it), and the sign extended halves of the result are written to LO and HI.
+VectorIntegerResult run_reference_pmaddw(const bool subtract, const uqword& rs, const uqword& rt, const uqword& lo, const uqword& hi)
+{
+    VectorIntegerResult result;
+    for (int i = 0; i < NUMBER_DWORDS_IN_QWORD; i++)
+    {
+        const udword accumulator = (static_cast<udword>(hi.uw[i * 2]) << 32) | lo.uw[i * 2];
+        const udword product = static_cast<udword>(static_cast<sdword>(static_cast<sword>(rs.uw[i * 2])) * static_cast<sword>(rt.uw[i * 2]));
+        const udword value = subtract ? (accumulator - product) : (accumulator + product);
+
+        result.rd.ud[i] = value;
+        result.lo.ud[i] = static_cast<udword>(static_cast<sdword>(static_cast<sword>(value)));
+        result.hi.ud[i] = static_cast<udword>(static_cast<sdword>(static_cast<sword>(value >> 32)));
+    }
+    return result;
+}
+
+/// A core to run instructions through the EE Core interpreter, using an empty boot ROM in a temporary directory.
+class VectorIntegerCore
+{
+public:
+    VectorIntegerCore() :
+        directory(boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("orbumtest-%%%%-%%%%"))
+    {
+        boost::filesystem::create_directories(directory);
+        const std::string directory_path = directory.string() + "/";
+
+        const std::vector<char> image(Constants::EE::ROM::SIZE_BOOT_ROM, 0);
+        std::ofstream file(directory_path + "boot_rom.bin", std::ios_base::binary);
+        file.write(image.data(), image.size());
+        if (!file)
+            throw std::runtime_error("Unable to write the boot ROM");
+        file.close();
+
+        CoreOptions options = CoreOptions::make_default();
+        options.logs_dir_path = directory_path.c_str();
+        options.roms_dir_path = directory_path.c_str();
+        options.boot_rom_file_name = "boot_rom.bin";
+        options.rom1_file_name = "";
+        options.rom2_file_name = "";
+        options.erom_file_name = "";
+
+        core = std::make_unique<Core>(options);
+        interpreter = std::make_unique<CEeCoreInterpreter>(core.get());
+    }
+
+    ~VectorIntegerCore()
+    {
+        interpreter.reset();
+        core.reset();
+        boost::system::error_code error;
+        boost::filesystem::remove_all(directory, error);
+    }
+
+    /// Runs the instruction with Rd = $3, Rs = $1 and Rt = $2.
+    VectorIntegerResult run(void (CEeCoreInterpreter::*instruction)(const EeCoreInstruction), const uqword& rs, const uqword& rt, const uqword& lo, const uqword& hi)
+    {
+        auto& r5900 = core->get_resources().ee.core.r5900;
+        r5900.gpr[VECTOR_INTEGER_RS].write_uqword(rs);
+        r5900.gpr[VECTOR_INTEGER_RT].write_uqword(rt);
+        r5900.gpr[VECTOR_INTEGER_RD].write_uqword(uqword());
+        r5900.lo.write_uqword(lo);
+        r5900.hi.write_uqword(hi);
+
+        // MMI opcode, the function is selected by the member called.
+        const uword value = (0x1C << 26) | (VECTOR_INTEGER_RS << 21) | (VECTOR_INTEGER_RT << 16) | (VECTOR_INTEGER_RD << 11);
+        ((*interpreter).*instruction)(EeCoreInstruction(value));
+
+        return {r5900.gpr[VECTOR_INTEGER_RD].read_uqword(), r5900.lo.read_uqword(), r5900.hi.read_uqword()};
+    }
+
+private:
+    boost::filesystem::path directory;
+    std::unique_ptr<Core> core;
+    std::unique_ptr<CEeCoreInterpreter> interpreter;
+};
+
+std::string format_vector_integer(const uqword& value)
+{
+    std::ostringstream stream;
+    stream << std::hex << std::setfill('0');
+    for (int i = 0; i < NUMBER_WORDS_IN_QWORD; i++)
+        stream << (i ? " " : "") << std::setw(8) << value.uw[i];
+    return stream.str();
+}
+
+void report_vector_integer_mismatch(const std::string& test, const char* path, const uqword& a, const uqword& b, const uqword& expected, const uqword& actual)
+{
+    std::cout << test << " (" << path << ") mismatch:\n"
+              << "  a        = " << format_vector_integer(a) << "\n"
+              << "  b        = " << format_vector_integer(b) << "\n"
+              << "  expected = " << format_vector_integer(expected) << "\n"
+              << "  actual   = " << format_vector_integer(actual) << "\n"
+              << std::flush;
+}
+
+size_t test_vector_integer()
+{
+    struct NamedOp
+    {
+        const char* name;
+        VectorIntegerOp op;
+    };
+    const NamedOp ops[] = {
+        {"ADD", VectorIntegerOp::ADD},
+        {"ADDS", VectorIntegerOp::ADDS},
+        {"ADDU", VectorIntegerOp::ADDU},
+        {"SUB", VectorIntegerOp::SUB},
+        {"SUBS", VectorIntegerOp::SUBS},
+        {"SUBU", VectorIntegerOp::SUBU},
+        {"MAX", VectorIntegerOp::MAX},
+        {"MIN", VectorIntegerOp::MIN},
+        {"CEQ", VectorIntegerOp::CEQ},
+        {"CGT", VectorIntegerOp::CGT}};
+
+    struct NamedWidth
+    {
+        const char* name;
+        VectorIntegerWidth width;
+    };
+    const NamedWidth widths[] = {
+        {"B", VectorIntegerWidth::BYTE},
+        {"H", VectorIntegerWidth::HWORD},
+        {"W", VectorIntegerWidth::WORD}};
+
+    TestRandom random;
+    size_t failures = 0;
+    auto check = [&](const std::string& test, const char* path, const uqword& a, const uqword& b, const uqword& expected, const uqword& actual) {
+        if (!std::memcmp(&expected, &actual, sizeof(expected)))
+            return;
+        if (failures < VECTOR_INTEGER_MAX_REPORTS)
+            report_vector_integer_mismatch(test, path, a, b, expected, actual);
+        failures++;
+    };
+
+    // Field operations, interleaves and packs, against the scalar kernels and the per-field references.
+    for (const auto& named_width : widths)
+    {
+        const int number_fields = NUMBER_BYTES_IN_QWORD * 8 / vector_integer_field_bits(named_width.width);
+
+        for (size_t i = 0; i < VECTOR_INTEGER_ITERATIONS; i++)
+        {
+            const uqword a = make_vector_integer_operand(random, named_width.width);
+            const uqword b = (random.next() % 8) ? make_vector_integer_operand(random, named_width.width) : a; // Equal fields.
+
+            for (const auto& named_op : ops)
+            {
+                const std::string name = std::string(named_op.name) + named_width.name;
+                const uqword vector = vector_integer_op(named_op.op, named_width.width, a, b);
+                check(name, "vector vs scalar", a, b, vector_integer_op_scalar(named_op.op, named_width.width, a, b), vector);
+                check(name, "vector vs per-field", a, b, run_per_field_integer_op(named_op.op, named_width.width, a, b), vector);
+            }
+
+            uqword lower_per_field;
+            uqword upper_per_field;
+            uqword pack_per_field;
+            for (int field = 0; field < number_fields / 2; field++)
+            {
+                set_vector_integer_field(lower_per_field, named_width.width, field * 2, get_vector_integer_field(a, named_width.width, field));
+                set_vector_integer_field(lower_per_field, named_width.width, field * 2 + 1, get_vector_integer_field(b, named_width.width, field));
+                set_vector_integer_field(upper_per_field, named_width.width, field * 2, get_vector_integer_field(a, named_width.width, number_fields / 2 + field));
+                set_vector_integer_field(upper_per_field, named_width.width, field * 2 + 1, get_vector_integer_field(b, named_width.width, number_fields / 2 + field));
+                set_vector_integer_field(pack_per_field, named_width.width, field, get_vector_integer_field(a, named_width.width, field * 2));
+                set_vector_integer_field(pack_per_field, named_width.width, number_fields / 2 + field, get_vector_integer_field(b, named_width.width, field * 2));
+            }
+
+            const uqword lower = vector_integer_interleave_lower(named_width.width, a, b);
+            const uqword upper = vector_integer_interleave_upper(named_width.width, a, b);
+            const uqword pack = vector_integer_pack(named_width.width, a, b);
+            check(std::string("INTERLEAVE_LOWER") + named_width.name, "vector vs scalar", a, b, vector_integer_interleave_lower_scalar(named_width.width, a, b), lower);
+            check(std::string("INTERLEAVE_LOWER") + named_width.name, "vector vs per-field", a, b, lower_per_field, lower);
+            check(std::string("INTERLEAVE_UPPER") + named_width.name, "vector vs scalar", a, b, vector_integer_interleave_upper_scalar(named_width.width, a, b), upper);
+            check(std::string("INTERLEAVE_UPPER") + named_width.name, "vector vs per-field", a, b, upper_per_field, upper);
+            check(std::string("PACK") + named_width.name, "vector vs scalar", a, b, vector_integer_pack_scalar(named_width.width, a, b), pack);
+            check(std::string("PACK") + named_width.name, "vector vs per-field", a, b, pack_per_field, pack);
+        }
+    }
+
+    // Hword multiplies.
+    for (size_t i = 0; i < VECTOR_INTEGER_ITERATIONS; i++)
+    {
+        const uqword a = make_vector_integer_operand(random, VectorIntegerWidth::HWORD);
+        const uqword b = make_vector_integer_operand(random, VectorIntegerWidth::HWORD);
+
+        uqword lower;
+        uqword upper;
+        uqword lower_scalar;
+        uqword upper_scalar;
+        vector_integer_multiply_hword(a, b, lower, upper);
+        vector_integer_multiply_hword_scalar(a, b, lower_scalar, upper_scalar);
+        check("MULTIPLY_HWORD (lower)", "vector vs scalar", a, b, lower_scalar, lower);
+        check("MULTIPLY_HWORD (upper)", "vector vs scalar", a, b, upper_scalar, upper);
+
+        for (const bool subtract : {false, true})
+            check(subtract ? "MULTIPLY_PAIRS_HWORD (subtract)" : "MULTIPLY_PAIRS_HWORD (add)", "vector vs scalar", a, b,
+                  vector_integer_multiply_pairs_hword_scalar(subtract, a, b), vector_integer_multiply_pairs_hword(subtract, a, b));
+    }
+
+    // The MMI instructions whose behaviour was corrected along with the kernels, through the interpreter.
+    struct NamedInstruction
+    {
+        const char* name;
+        void (CEeCoreInterpreter::*instruction)(const EeCoreInstruction);
+        std::function<VectorIntegerResult(const uqword&, const uqword&, const uqword&, const uqword&)> reference;
+    };
+    auto field_op = [&](const VectorIntegerOp op, const VectorIntegerWidth width) {
+        return [=](const uqword& rs, const uqword& rt, const uqword& lo, const uqword& hi) {
+            return VectorIntegerResult{run_per_field_integer_op(op, width, rs, rt), lo, hi};
+        };
+    };
+    auto madd_op = [&](auto reference, const bool subtract) {
+        return [=](const uqword& rs, const uqword& rt, const uqword& lo, const uqword& hi) {
+            return reference(subtract, rs, rt, lo, hi);
+        };
+    };
+    const NamedInstruction instructions[] = {
+        {"PMAXH", &CEeCoreInterpreter::PMAXH, field_op(VectorIntegerOp::MAX, VectorIntegerWidth::HWORD)},
+        {"PMAXW", &CEeCoreInterpreter::PMAXW, field_op(VectorIntegerOp::MAX, VectorIntegerWidth::WORD)},
+        {"PMINH", &CEeCoreInterpreter::PMINH, field_op(VectorIntegerOp::MIN, VectorIntegerWidth::HWORD)},
+        {"PMINW", &CEeCoreInterpreter::PMINW, field_op(VectorIntegerOp::MIN, VectorIntegerWidth::WORD)},
+        {"PCGTB", &CEeCoreInterpreter::PCGTB, field_op(VectorIntegerOp::CGT, VectorIntegerWidth::BYTE)},
+        {"PCGTH", &CEeCoreInterpreter::PCGTH, field_op(VectorIntegerOp::CGT, VectorIntegerWidth::HWORD)},
+        {"PCGTW", &CEeCoreInterpreter::PCGTW, field_op(VectorIntegerOp::CGT, VectorIntegerWidth::WORD)},
+        {"PMADDH", &CEeCoreInterpreter::PMADDH, madd_op(run_reference_pmaddh, false)},
+        {"PMSUBH", &CEeCoreInterpreter::PMSUBH, madd_op(run_reference_pmaddh, true)},
+        {"PMADDW", &CEeCoreInterpreter::PMADDW, madd_op(run_reference_pmaddw, false)},
+        {"PMSUBW", &CEeCoreInterpreter::PMSUBW, madd_op(run_reference_pmaddw, true)}};
+
+    VectorIntegerCore core;
+    for (const auto& named_instruction : instructions)
+    {
+        for (size_t i = 0; i < VECTOR_INTEGER_ITERATIONS; i++)
+        {
+            const uqword rs = make_vector_integer_operand(random);
+            const uqword rt = make_vector_integer_operand(random);
+            const uqword lo = make_vector_integer_operand(random);
+            const uqword hi = make_vector_integer_operand(random);
+
+            const VectorIntegerResult expected = named_instruction.reference(rs, rt, lo, hi);
+            const VectorIntegerResult actual = core.run(named_instruction.instruction, rs, rt, lo, hi);
+            check(named_instruction.name, "interpreter vs reference (Rd)", rs, rt, expected.rd, actual.rd);
+            check(named_instruction.name, "interpreter vs reference (LO)", rs, rt, expected.lo, actual.lo);
+            check(named_instruction.name, "interpreter vs reference (HI)", rs, rt, expected.hi, actual.hi);
+        }
+    }
+
+    return failures;
+}
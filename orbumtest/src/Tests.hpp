@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+/// Deterministic random numbers for the tests (xorshift32), so failures can be reproduced.
+class TestRandom
+{
+public:
+    TestRandom(const std::uint32_t seed = 0x9E3779B9) :
+        state(seed)
+    {
+    }
+
+    std::uint32_t next()
+    {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        return state;
+    }
+
+private:
+    std::uint32_t state;
+};
+
+/// Differential test of the vectorised float kernels (Utilities/VectorFloat.hpp) against the scalar
+/// references and the per-field VU path they replaced, including the MAC and status flags.
+/// Returns the number of mismatches.
+size_t test_vector_float();
+
+/// Differential test of the vectorised integer kernels (Utilities/VectorInteger.hpp) against the scalar
+/// references and per-field versions written from the EE Core Instruction Manual, and of the MMI
+/// instructions whose behaviour was corrected along with them (PMAX*, PMIN*, PCGT*, PMADD*, PMSUB*).
+/// Returns the number of mismatches.
+size_t test_vector_integer();
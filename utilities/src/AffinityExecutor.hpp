@@ -0,0 +1,151 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <boost/lockfree/spsc_queue.hpp>
+
+#include <Queues.hpp>
+#include <TaskExecutor.hpp>
+
+/// Thread pool where items are always handled by the same (dedicated) thread.
+/// Unlike the TaskExecutor, the caller chooses the thread for each item, which keeps the
+/// state touched by the handler in that thread's caches. Items are passed by value through
+/// a lock-free SPSC ring per thread, so enqueuing does not allocate.
+/// Items are enqueued from one thread only (the owner), and are handled as soon as they
+/// are enqueued, in order for each thread. Use wait_for_idle() to synchronise.
+/// Threads can optionally be pinned to a host CPU each (only supported on Linux).
+template <typename ItemTy, size_t capacity>
+class AffinityExecutor
+{
+public:
+    using HandlerFn = std::function<void(const ItemTy&)>;
+
+    AffinityExecutor(const size_t number_threads, const HandlerFn& handler_fn, const bool pin_threads) :
+        handler_fn(handler_fn),
+        remaining_items(0),
+        exit(false)
+    {
+        for (size_t i = 0; i < number_threads; i++)
+            threads.push_back(std::make_unique<Thread>());
+
+        for (size_t i = 0; i < number_threads; i++)
+        {
+            threads[i]->thread = std::thread(std::bind(&AffinityExecutor::main_thread_, this, i));
+            if (pin_threads)
+                pin_thread(*threads[i], i);
+        }
+    }
+
+    ~AffinityExecutor()
+    {
+        exit = true;
+        for (auto& thread : threads)
+        {
+            thread->event.notify_all();
+            thread->thread.join();
+        }
+    }
+
+    AffinityExecutor(const AffinityExecutor&) = delete;
+    AffinityExecutor& operator=(const AffinityExecutor&) = delete;
+
+    /// Sends the item to the thread given. Waits for space if the thread's ring is full.
+    void enqueue(const size_t thread_index, const ItemTy& item)
+    {
+        remaining_items.fetch_add(1, std::memory_order_relaxed);
+
+        auto& thread = *threads[thread_index];
+        spin_wait([&] { return thread.ring.push(item); });
+        thread.event.notify_all();
+    }
+
+    void wait_for_idle()
+    {
+        // Wait for all items to be handled.
+        idle_event.wait([this] { return is_idle(); });
+
+        // Check if any exceptions occured, rethrow them on the current thread.
+        if (!thread_error_queue.is_empty())
+        {
+            std::string error_str;
+            thread_error_queue.pop(error_str);
+            throw std::runtime_error(error_str);
+        }
+    }
+
+    /// Returns if all enqueued items have been handled.
+    bool is_idle() const
+    {
+        return remaining_items.load(std::memory_order_acquire) == 0;
+    }
+
+private:
+    /// Per-thread resources, cache line aligned to avoid false sharing.
+    struct alignas(64) Thread
+    {
+        boost::lockfree::spsc_queue<ItemTy, boost::lockfree::capacity<capacity>> ring;
+        WaitEvent event;
+        std::thread thread;
+    };
+
+    void main_thread_(const size_t index)
+    {
+        auto& ring = threads[index]->ring;
+        auto& event = threads[index]->event;
+        ItemTy item;
+        while (true)
+        {
+            event.wait([&] { return ring.pop(item) || exit; });
+            if (exit)
+                break;
+
+            try
+            {
+                handler_fn(item);
+            }
+            catch (const std::exception& error)
+            {
+                // Add exception to global queue for the owner to deal with.
+                std::string error_str(error.what());
+                thread_error_queue.push(error_str);
+            }
+
+            if (remaining_items.fetch_sub(1, std::memory_order_release) == 1)
+                idle_event.notify_all();
+        }
+    }
+
+    /// Pins the thread to a host CPU, wrapping around if there are more threads than CPUs.
+    /// Best effort only, the thread is left unpinned on failure.
+    static void pin_thread(Thread& thread, const size_t index)
+    {
+#if defined(__linux__)
+        const unsigned int number_cpus = std::max(std::thread::hardware_concurrency(), 1u);
+
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(index % number_cpus, &cpu_set);
+        pthread_setaffinity_np(thread.thread.native_handle(), sizeof(cpu_set_t), &cpu_set);
+#endif
+    }
+
+    HandlerFn handler_fn;
+    std::vector<std::unique_ptr<Thread>> threads;
+    alignas(64) std::atomic<size_t> remaining_items;
+    WaitEvent idle_event;
+    MpscQueue<std::string, 32> thread_error_queue;
+    std::atomic<bool> exit;
+};
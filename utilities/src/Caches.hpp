@@ -252,10 +252,10 @@ class ClockCache
 private:
     using CacheEntry = std::tuple<KeyTy, ValueTy, bool>;
     using CacheContainer = std::array<CacheEntry, Size>;
-    using CacheIterator = typename CacheContainer::iterator;
 
 public:
     ClockCache() :
+        hand(0),
         current_cache_size(0),
         cache{std::make_tuple(KeyTy(), ValueTy(), false)}
     {
@@ -267,12 +267,12 @@ public:
         if (!current_cache_size)
             return std::nullopt;
 
-        auto end = hand_iterator;
+        const size_t end = hand;
 
         // Search towards the end of the clock.
         while (true)
         {
-            auto& [entry_key, entry_value, entry_recently_used] = *hand_iterator;
+            auto& [entry_key, entry_value, entry_recently_used] = cache[hand];
 
             if (entry_key == key)
             {
@@ -282,7 +282,7 @@ public:
 
             next_hand();
 
-            if (hand_iterator == end)
+            if (hand == end)
                 return std::nullopt;
         }
     }
@@ -293,19 +293,19 @@ public:
         // Slot available.
         if (current_cache_size < Size)
         {
-            auto it = cache.begin() + current_cache_size;
-            *it = std::make_tuple(key, value, true);
+            cache[current_cache_size] = std::make_tuple(key, value, true);
+            current_cache_size++;
             return;
         }
 
         // Start searching for a slot to evict by looking at the recently used flag.
         while (true)
         {
-            auto& entry_recently_used = std::get<2>(*hand_iterator);
+            auto& entry_recently_used = std::get<2>(cache[hand]);
 
             if (!entry_recently_used)
             {
-                *hand_iterator = std::make_tuple(key, value, true);
+                cache[hand] = std::make_tuple(key, value, true);
                 return;
             }
 
@@ -315,17 +315,17 @@ public:
     }
 
 private:
-    /// Increments the hand iterator and wraps around to the start when required.
+    /// Increments the hand and wraps around to the start when required.
+    /// An index is used rather than an iterator so the cache can be copied.
     void next_hand()
     {
-        hand_iterator += 1;
+        hand += 1;
 
-        auto end_it = cache.begin() + current_cache_size;
-        if (hand_iterator == end_it)
-            hand_iterator = cache.begin();
+        if (hand == current_cache_size)
+            hand = 0;
     }
 
-    CacheIterator hand_iterator;
+    size_t hand;
     size_t current_cache_size;
     CacheContainer cache;
 };
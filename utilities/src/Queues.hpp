@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <mutex>
 #include <stdexcept>
@@ -188,3 +190,86 @@ using SpmcQueue = MpmcQueue<ItemTy, capacity>;
 /// No thread safety - only 1 producer and 1 consumer allowed.
 template <typename ItemTy, size_t capacity>
 using SpscQueue = MpmcQueue<ItemTy, capacity>;
+
+/// Lock-free work stealing deque (Chase-Lev), with a fixed capacity.
+/// Only the owner thread may push() and pop() (LIFO end), any thread may steal() (FIFO end).
+/// Items are copied in and out atomically, so they need to be trivially copyable (ie: pointers).
+/// Based on "Correct and Efficient Work-Stealing for Weak Memory Models" (Le et al, 2013).
+template <typename ItemTy, size_t capacity>
+class WorkStealingDeque
+{
+    static_assert((capacity & (capacity - 1)) == 0, "WorkStealingDeque capacity must be a power of 2.");
+
+public:
+    WorkStealingDeque() :
+        top(0),
+        bottom(0)
+    {
+    }
+
+    /// Owner only. Returns false if the deque is full.
+    bool push(const ItemTy item)
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed);
+        const std::int64_t t = top.load(std::memory_order_acquire);
+        if (b - t >= static_cast<std::int64_t>(capacity))
+            return false;
+
+        buffer[b & MASK].store(item, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom.store(b + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /// Owner only. Returns false if the deque is empty (or the last item was stolen).
+    bool pop(ItemTy& item)
+    {
+        const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+        bottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        item = buffer[b & MASK].load(std::memory_order_relaxed);
+        if (t == b)
+        {
+            // Last item, race against the stealers for it.
+            const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            bottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    /// Any thread. Returns false if the deque is empty or another thread took the item first.
+    bool steal(ItemTy& item)
+    {
+        std::int64_t t = top.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom.load(std::memory_order_acquire);
+        if (t >= b)
+            return false;
+
+        item = buffer[t & MASK].load(std::memory_order_relaxed);
+        return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    }
+
+    /// Any thread, only a snapshot.
+    bool is_empty() const
+    {
+        return top.load(std::memory_order_acquire) >= bottom.load(std::memory_order_acquire);
+    }
+
+private:
+    static constexpr std::int64_t MASK = static_cast<std::int64_t>(capacity) - 1;
+
+    std::atomic<std::int64_t> top;
+    std::atomic<std::int64_t> bottom;
+    std::atomic<ItemTy> buffer[capacity];
+};
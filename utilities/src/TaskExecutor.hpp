@@ -1,7 +1,8 @@
 #pragma once
 
 #include <atomic>
-#include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #include <exception>
 #include <functional>
 #include <memory>
@@ -9,77 +10,135 @@
 #include <stdexcept>
 #include <string>
 #include <thread>
+#include <vector>
 
 #include <Queues.hpp>
 
-#include <condition_variable>
-
-struct BusyCounter
+/// Spins on a condition, yielding the thread after a while.
+/// Used instead of mutex/cv pairs for waits that are always very short, see WaitEvent for the others.
+template <typename ConditionFn>
+void spin_wait(const ConditionFn& condition_fn)
 {
-    BusyCounter() :
-        busy_counter(0)
+    static constexpr int SPINS_BEFORE_YIELD = 1024;
+
+    int spins = 0;
+    while (!condition_fn())
     {
+        if (++spins >= SPINS_BEFORE_YIELD)
+        {
+            std::this_thread::yield();
+            spins = 0;
+        }
     }
+}
 
-    void operator++(int)
+/// Event that a thread waits on for a condition, spinning for a while before parking (blocking) the thread.
+/// The waits are usually very short (within a core run), but can be indefinitely long (ie: between runs,
+/// while the frontend is in a menu), where spinning would keep a host core busy for nothing.
+/// Whoever changes the condition has to call notify_all() after, which is a fence and a load unless a
+/// thread is parked.
+class WaitEvent
+{
+public:
+    /// Number of spins before parking, roughly 100us.
+    static constexpr int SPINS_BEFORE_PARK = 64 * 1024;
+
+    WaitEvent() :
+        parked(0)
     {
-        std::unique_lock<std::mutex> lock(busy_counter_mtx);
-        busy_counter++;
-        lock.unlock();
-        busy_counter_cv.notify_all();
     }
 
-    void operator--(int)
+    template <typename ConditionFn>
+    void wait(const ConditionFn& condition_fn)
     {
-        std::unique_lock<std::mutex> lock(busy_counter_mtx);
-        busy_counter--;
-        lock.unlock();
-        busy_counter_cv.notify_all();
+        static constexpr int SPINS_BEFORE_YIELD = 1024;
+
+        for (int spins = 1; spins <= SPINS_BEFORE_PARK; spins++)
+        {
+            if (condition_fn())
+                return;
+            if (!(spins % SPINS_BEFORE_YIELD))
+                std::this_thread::yield();
+        }
+
+        // Announce the thread is parking before checking the condition again, so either the
+        // notifier sees it parked, or this thread sees the condition change (see notify_all()).
+        std::unique_lock<std::mutex> lock(mutex);
+        parked.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        condition.wait(lock, condition_fn);
+        parked.fetch_sub(1, std::memory_order_relaxed);
     }
 
-    void wait_for_idle()
+    void notify_all()
     {
-        std::unique_lock<std::mutex> lock(busy_counter_mtx);
-        busy_counter_cv.wait(lock, [this] { return !busy_counter; });
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked.load(std::memory_order_relaxed))
+        {
+            // Taking the lock makes sure a parking thread is either waiting already or yet to check the condition.
+            std::lock_guard<std::mutex> lock(mutex);
+            condition.notify_all();
+        }
     }
 
 private:
-#if defined(BUILD_DEBUG)
-    friend class Core;
-#endif
-
-    int busy_counter;
-    std::mutex busy_counter_mtx;
-    std::condition_variable busy_counter_cv;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::atomic<int> parked;
 };
 
 /// Executor/Thread synchronisation resources.
-/// With ex_ptr, we don't care if two threads try to write to it at once -
+/// Tasks of a dispatch are shared out between the workers, which then steal from each
+/// other once their own deque is empty. The remaining task counter acts as the idle barrier.
+/// With thread_error_queue, we don't care if two threads try to write to it at once -
 /// we only care that at least one exception occured, doesn't matter which one.
 struct TaskSync
 {
-    TaskSync() :
+    using Task = std::function<void()>;
+    using TaskDeque = WorkStealingDeque<const Task*, 256>;
+
+    TaskSync(const size_t number_workers) :
+        deques(number_workers),
+        dispatch_state(0),
+        remaining_tasks(0),
         exit(false)
     {
     }
 
-    SpmcQueue<std::function<void()>, 128> running_task_queue;
-    MpscQueue<std::function<void()>, 128> pending_task_queue;
+    /// Per-worker deques, cache line aligned to avoid false sharing.
+    struct alignas(64) AlignedDeque
+    {
+        TaskDeque deque;
+    };
+    std::vector<AlignedDeque> deques;
+
+    /// Tasks of the current dispatch, stable until all are run.
+    std::vector<Task> running_tasks;
+
+    /// Dispatch epoch (upper 32 bits) and number of running tasks (lower 32 bits), published
+    /// together on every dispatch which wakes up the workers. A worker only touches
+    /// running_tasks if it has a share of them, as the dispatch can't finish without it.
+    alignas(64) std::atomic<std::uint64_t> dispatch_state;
+
+    /// Number of tasks of the current dispatch not yet finished.
+    alignas(64) std::atomic<size_t> remaining_tasks;
+
+    /// Events for the workers waiting on the next dispatch (or exit), and the owner waiting on the tasks.
+    WaitEvent dispatch_event;
+    WaitEvent idle_event;
 
-    BusyCounter thread_busy_counter;
     MpscQueue<std::string, 32> thread_error_queue;
 
-    bool exit;
+    std::atomic<bool> exit;
 };
 
-/// Threaded worker, runs functors from a given task queue.
+/// Threaded worker, runs functors from its own deque and steals from the other workers.
 class Worker
 {
 public:
-    static constexpr std::chrono::nanoseconds TIMEOUT = std::chrono::nanoseconds(500);
-
-    Worker(TaskSync& task_sync) :
+    Worker(TaskSync& task_sync, const size_t id) :
         local_exit(false),
+        id(id),
         task_sync(task_sync)
     {
         thread = std::thread(std::bind(&Worker::main_thread_, this));
@@ -88,76 +147,142 @@ public:
     ~Worker()
     {
         local_exit = true;
+        task_sync.dispatch_event.notify_all();
         thread.join();
     }
 
 private:
     void main_thread_()
     {
-        while (!task_sync.exit && !local_exit)
+        std::uint64_t state = 0;
+        while (true)
         {
-            std::function<void()> task_fn;
-            if (task_sync.running_task_queue.try_pop(task_fn, TIMEOUT, [this] { task_sync.thread_busy_counter++; }))
+            // Wait for the next dispatch.
+            task_sync.dispatch_event.wait([&] { return task_sync.dispatch_state.load(std::memory_order_acquire) != state || task_sync.exit || local_exit; });
+            if (task_sync.exit || local_exit)
+                break;
+            state = task_sync.dispatch_state.load(std::memory_order_acquire);
+
+            // Claim this worker's share of the tasks.
+            auto& own_deque = task_sync.deques[id].deque;
+            const size_t number_workers = task_sync.deques.size();
+            const size_t number_tasks = static_cast<size_t>(state & 0xFFFFFFFF);
+            for (size_t i = id; i < number_tasks; i += number_workers)
             {
-                try
-                {
-                    task_fn();
-                }
-                catch (const std::exception& error)
+                if (!own_deque.push(&task_sync.running_tasks[i]))
+                    run_task(task_sync.running_tasks[i]);
+            }
+
+            // Run own tasks, then steal until every deque looks empty.
+            const TaskSync::Task* task;
+            while (own_deque.pop(task))
+                run_task(*task);
+
+            bool found_work = true;
+            while (found_work)
+            {
+                found_work = false;
+                for (size_t offset = 1; offset < number_workers; offset++)
                 {
-                    // Add exception to global queue for the executor to deal with.
-                    std::string error_str(error.what());
-                    task_sync.thread_error_queue.push(error_str);
+                    auto& victim_deque = task_sync.deques[(id + offset) % number_workers].deque;
+                    while (!victim_deque.is_empty())
+                    {
+                        if (victim_deque.steal(task))
+                        {
+                            run_task(*task);
+                            found_work = true;
+                        }
+                    }
                 }
-                task_sync.thread_busy_counter--;
             }
         }
     }
 
-    bool local_exit; // Kinda not needed but makes the code a bit nicer by not
-                     // exposing join() publicly, instead guaranteeing the
-                     // thread will exit.
+    void run_task(const TaskSync::Task& task)
+    {
+        try
+        {
+            task();
+        }
+        catch (const std::exception& error)
+        {
+            // Add exception to global queue for the executor to deal with.
+            std::string error_str(error.what());
+            task_sync.thread_error_queue.push(error_str);
+        }
+
+        if (task_sync.remaining_tasks.fetch_sub(1, std::memory_order_release) == 1)
+            task_sync.idle_event.notify_all();
+    }
+
+    std::atomic<bool> local_exit; // Kinda not needed but makes the code a bit nicer by not
+                                  // exposing join() publicly, instead guaranteeing the
+                                  // thread will exit.
+    size_t id;
     TaskSync& task_sync;
     std::thread thread;
 };
 
 /// Thread pool task executor.
+/// Tasks are enqueued and dispatched from one thread only (the owner), and a dispatch
+/// needs to be waited on with wait_for_idle() before the next one.
+/// With no workers, tasks are run on the owner thread during dispatch().
 class TaskExecutor
 {
 public:
-    TaskExecutor(const size_t thread_pool_size)
+    TaskExecutor(const size_t thread_pool_size) :
+        task_sync(thread_pool_size)
     {
         for (size_t i = 0; i < thread_pool_size; i++)
-            workers.push_back(std::make_unique<Worker>(task_sync));
+            workers.push_back(std::make_unique<Worker>(task_sync, i));
     }
 
     ~TaskExecutor()
     {
         task_sync.exit = true;
+        task_sync.dispatch_event.notify_all();
     }
 
     void enqueue_task(const std::function<void()>& fn)
     {
-        task_sync.pending_task_queue.push(fn);
+        pending_tasks.push_back(fn);
     }
 
     void dispatch()
     {
-        while (!task_sync.pending_task_queue.is_empty())
+        task_sync.running_tasks.swap(pending_tasks);
+        pending_tasks.clear();
+
+        if (workers.empty())
         {
-            std::function<void()> fn;
-            task_sync.pending_task_queue.pop(fn);
-            task_sync.running_task_queue.push(fn);
+            for (const auto& task : task_sync.running_tasks)
+            {
+                try
+                {
+                    task();
+                }
+                catch (const std::exception& error)
+                {
+                    task_sync.thread_error_queue.push(std::string(error.what()));
+                }
+            }
+            return;
         }
+
+        if (task_sync.running_tasks.empty())
+            return;
+
+        const std::uint64_t number_tasks = task_sync.running_tasks.size();
+        const std::uint64_t epoch = (task_sync.dispatch_state.load(std::memory_order_relaxed) >> 32) + 1;
+        task_sync.remaining_tasks.store(number_tasks, std::memory_order_relaxed);
+        task_sync.dispatch_state.store((epoch << 32) | number_tasks, std::memory_order_release);
+        task_sync.dispatch_event.notify_all();
     }
 
     void wait_for_idle()
     {
-        // Wait for empty running task queue.
-        task_sync.running_task_queue.wait_for_empty();
-
-        // Wait for paused worker threads.
-        task_sync.thread_busy_counter.wait_for_idle();
+        // Wait for all tasks to be finished.
+        task_sync.idle_event.wait([this] { return is_idle(); });
 
         // Check if any exceptions occured, rethrow them on the current thread.
         // TODO: only the first error is thrown for now... Not sure we will
@@ -170,11 +295,14 @@ public:
         }
     }
 
-private:
-#if defined(BUILD_DEBUG)
-    friend class Core;
-#endif
+    /// Returns if all dispatched tasks have been run.
+    bool is_idle() const
+    {
+        return task_sync.remaining_tasks.load(std::memory_order_acquire) == 0;
+    }
 
+private:
     TaskSync task_sync;
+    std::vector<std::function<void()>> pending_tasks;
     std::vector<std::unique_ptr<Worker>> workers;
 };